@@ -29,9 +29,12 @@
 #include "hyperion/BuildInfo.h"
 
 #include <libhyperion/interface/Version.h>
+#include <libhyperion/ast/ASTBinaryFormat.h>
 #include <libhyperion/ast/ASTJsonExporter.h>
 #include <libhyperion/ast/ASTJsonImporter.h>
 #include <libhyperion/analysis/NameAndTypeResolver.h>
+#include <libhyperion/interface/CompilationCache.h>
+#include <libhyperion/interface/CompilationServer.h>
 #include <libhyperion/interface/CompilerStack.h>
 #include <libhyperion/interface/StandardCompiler.h>
 #include <libhyperion/interface/GasEstimator.h>
@@ -56,10 +59,12 @@
 #include <libhyputil/CommonData.h>
 #include <libhyputil/CommonIO.h>
 #include <libhyputil/JSON.h>
+#include <libhyputil/ThreadPool.h>
 
 #include <algorithm>
 #include <fstream>
 #include <memory>
+#include <sstream>
 
 #include <range/v3/view/map.hpp>
 
@@ -177,9 +182,24 @@ void CommandLineInterface::handleQRVMAssembly(std::string const& _contract)
 	if (!m_options.compiler.outputs.asm_ && !m_options.compiler.outputs.asmJson)
 		return;
 
+	// The JSON assembly is written item by item, without building the JSON document first.
+	if (m_options.compiler.outputs.asmJson && m_options.output.dir.empty())
+	{
+		sout() << "QRVM assembly:" << std::endl;
+		util::JsonWriter writer(sout(), m_options.formatting.json);
+		m_assemblyStack->assemblyJSON(_contract, writer);
+		sout() << std::endl;
+		return;
+	}
+
 	std::string assembly;
 	if (m_options.compiler.outputs.asmJson)
-		assembly = util::jsonPrint(removeNullMembers(m_assemblyStack->assemblyJSON(_contract)), m_options.formatting.json);
+	{
+		std::ostringstream json;
+		util::JsonWriter writer(json, m_options.formatting.json);
+		m_assemblyStack->assemblyJSON(_contract, writer);
+		assembly = json.str();
+	}
 	else
 		assembly = m_assemblyStack->assemblyString(_contract, m_fileReader.sourceUnits());
 
@@ -422,6 +442,41 @@ void CommandLineInterface::handleStorageLayout(std::string const& _contract)
 		sout() << "Contract Storage Layout:" << std::endl << data << std::endl;
 }
 
+void CommandLineInterface::handleTimeReport()
+{
+	hypAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.output.timeReport)
+		return;
+
+	std::string data = jsonPrint(m_compiler->timeReport(), m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+		createFile("time_report.json", data);
+	else
+		sout() << std::endl << "Time Report:" << std::endl << data << std::endl;
+}
+
+void CommandLineInterface::handleCacheStatistics()
+{
+	if (!m_options.output.cacheStatistics)
+		return;
+
+	if (!m_compilationCache)
+	{
+		serr() << "Compilation cache not used because assembly output or gas estimates were requested." << std::endl;
+		return;
+	}
+
+	CompilationCache::Statistics const& statistics = m_compilationCache->statistics();
+	serr() << fmt::format(
+		"Compilation cache: {} hits, {} misses, {} stores, {} evictions.",
+		statistics.hits,
+		statistics.misses,
+		statistics.stores,
+		statistics.evictions
+	) << std::endl;
+}
+
 void CommandLineInterface::handleNatspec(bool _natspecDev, std::string const& _contract)
 {
 	hypAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -609,6 +664,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -625,7 +681,10 @@ std::map<std::string, Json::Value> CommandLineInterface::parseAstFromInput()
 	for (SourceCode const& sourceCode: m_fileReader.sourceUnits() | ranges::views::values)
 	{
 		Json::Value ast;
-		astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+		if (ASTBinaryFormat::isEncoded(sourceCode))
+			ast = ASTBinaryFormat::decode(sourceCode);
+		else
+			astAssert(jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
@@ -645,7 +704,7 @@ std::map<std::string, Json::Value> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data)
+void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
@@ -660,7 +719,7 @@ void CommandLineInterface::createFile(std::string const& _fileName, std::string
 	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
 		hypThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
-	std::ofstream outFile(pathName);
+	std::ofstream outFile(pathName, _binary ? std::ios::out | std::ios::binary : std::ios::out);
 	outFile << _data;
 	if (!outFile)
 		hypThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
@@ -744,13 +803,25 @@ void CommandLineInterface::processInput()
 		hypAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
+		if (!m_options.output.cacheDir.empty())
+			compiler.setCompilationCache(openCompilationCache());
+		bool const outputComplete = compiler.compile(std::move(m_standardJsonInput.value()), sout());
+		sout() << std::endl;
 		m_standardJsonInput.reset();
+		handleCacheStatistics();
+		if (!outputComplete)
+			hypThrow(
+				CommandLineExecutionError,
+				"Some outputs could not be produced after the output was started and are null."
+			);
 		break;
 	}
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
+	case InputMode::Server:
+		serveCompilations();
+		break;
 	case InputMode::Assembler:
 		assembleYul(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
@@ -812,6 +883,27 @@ void CommandLineInterface::assembleFromQRVMAssemblyJSON()
 	m_assemblyStack = m_qrvmAssemblyStack.get();
 }
 
+std::shared_ptr<CompilationCache> CommandLineInterface::openCompilationCache()
+{
+	hypAssert(!m_options.output.cacheDir.empty());
+
+	try
+	{
+		m_compilationCache = std::make_shared<CompilationCache>(
+			m_options.output.cacheDir,
+			m_options.output.cacheSizeLimit.value_or(CompilationCache::DefaultSizeLimit)
+		);
+		return m_compilationCache;
+	}
+	catch (boost::filesystem::filesystem_error const& _error)
+	{
+		hypThrow(
+			CommandLineExecutionError,
+			"Could not create the compilation cache directory \"" + m_options.output.cacheDir.string() + "\": " + _error.what()
+		);
+	}
+}
+
 void CommandLineInterface::compile()
 {
 	hypAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -834,6 +926,8 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.jobs);
+		m_compiler->enableTimeReport(m_options.output.timeReport);
 		m_compiler->setQRVMVersion(m_options.output.qrvmVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
 		if (m_options.output.debugInfoSelection.has_value())
@@ -868,6 +962,16 @@ void CommandLineInterface::compile()
 
 		m_compiler->setOptimiserSettings(m_options.optimiserSettings());
 
+		// Contracts restored from the cache have no assembly.
+		if (
+			!m_options.output.cacheDir.empty() &&
+			!m_options.compiler.estimateGas &&
+			!m_options.compiler.outputs.asm_ &&
+			!m_options.compiler.outputs.asmJson &&
+			!(m_options.compiler.combinedJsonRequests && m_options.compiler.combinedJsonRequests->asm_)
+		)
+			m_compiler->setCompilationCache(openCompilationCache());
+
 		if (m_options.input.mode == InputMode::CompilerWithASTImport)
 		{
 			try
@@ -1070,6 +1174,44 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::handleBinaryAst()
+{
+	hypAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.outputs.astBinary)
+		return;
+
+	if (m_options.output.dir.empty())
+		sout() << "Binary AST (base64):" << std::endl << std::endl;
+	for (auto const& sourceCode: m_fileReader.sourceUnits())
+	{
+		// Encodes the same document as --combined-json ast, restricted to this source,
+		// so that the result can be passed to --import-ast.
+		ASTBinaryWriter writer;
+		writer.beginObject();
+		writer.key(g_strSources);
+		writer.beginObject();
+		writer.key(sourceCode.first);
+		writer.beginObject();
+		writer.key("AST");
+		ASTJsonExporter(m_compiler->state(), m_compiler->sourceIndices()).print(writer, m_compiler->ast(sourceCode.first));
+		writer.key("id");
+		writer.write(m_compiler->sourceIndices().at(sourceCode.first));
+		writer.endObject();
+		writer.endObject();
+		writer.endObject();
+		std::string data = writer.finish();
+
+		if (!m_options.output.dir.empty())
+			createFile(boost::filesystem::path(sourceCode.first).filename().string() + "_binary.ast", data, true);
+		else
+		{
+			sout() << std::endl << "======= " << sourceCode.first << " =======" << std::endl;
+			sout() << util::toBase64(data) << std::endl;
+		}
+	}
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::StdioTransport transport;
@@ -1077,6 +1219,25 @@ void CommandLineInterface::serveLSP()
 		hypThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveCompilations()
+{
+	hypAssert(m_options.input.mode == InputMode::Server);
+
+	std::shared_ptr<CompilationCache> cache;
+	if (!m_options.output.cacheDir.empty())
+		cache = openCompilationCache();
+
+	CompilationServer server(m_universalCallback.callback(), std::move(cache));
+	try
+	{
+		server.listen(m_options.input.serverSocket);
+	}
+	catch (CompilationServerError const& _error)
+	{
+		hypThrow(CommandLineExecutionError, *_error.comment());
+	}
+}
+
 void CommandLineInterface::link()
 {
 	hypAssert(m_options.input.mode == InputMode::Linker);
@@ -1182,6 +1343,9 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 	hypAssert(m_options.input.mode == InputMode::Assembler);
 
 	bool successful = true;
+	std::unique_ptr<util::ThreadPool> threadPool;
+	if (m_options.output.jobs > 1)
+		threadPool = std::make_unique<util::ThreadPool>(m_options.output.jobs - 1);
 	std::map<std::string, yul::YulStack> yulStacks;
 	for (auto const& src: m_fileReader.sourceUnits())
 	{
@@ -1197,7 +1361,7 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 		if (!stack.parseAndAnalyze(src.first, src.second))
 			successful = false;
 		else
-			stack.optimize();
+			stack.optimize({}, threadPool.get());
 	}
 
 	for (auto const& sourceAndStack: yulStacks)
@@ -1273,9 +1437,11 @@ void CommandLineInterface::outputCompilationResults()
 
 	// do we need AST output?
 	handleAst();
+	handleBinaryAst();
 
 	CompilerOutputs astOutputSelection;
-	astOutputSelection.astCompactJson = true;
+	astOutputSelection.astCompactJson = m_options.compiler.outputs.astCompactJson;
+	astOutputSelection.astBinary = m_options.compiler.outputs.astBinary;
 	if (m_options.compiler.outputs != CompilerOutputs() && m_options.compiler.outputs != astOutputSelection)
 	{
 		// Currently AST is the only output allowed with --stop-after parsing. For all of the others
@@ -1306,6 +1472,9 @@ void CommandLineInterface::outputCompilationResults()
 		} // end of contracts iteration
 	}
 
+	handleTimeReport();
+	handleCacheStatistics();
+
 	if (!m_hasOutput)
 	{
 		if (!m_options.output.dir.empty())
@@ -85,9 +85,12 @@ public:
 private:
 	void printVersion();
 	void printLicense();
+	/// @returns the cache in the directory given by --cache-dir, creating the directory if needed.
+	std::shared_ptr<CompilationCache> openCompilationCache();
 	void compile();
 	void assembleFromQRVMAssemblyJSON();
 	void serveLSP();
+	void serveCompilations();
 	void link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -101,6 +104,7 @@ private:
 
 	void handleCombinedJSON();
 	void handleAst();
+	void handleBinaryAst();
 	void handleQRVMAssembly(std::string const& _contract);
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
@@ -115,6 +119,8 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	void handleTimeReport();
+	void handleCacheStatistics();
 
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
@@ -125,7 +131,8 @@ private:
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary whether to write @a _data without newline translation
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -153,6 +160,7 @@ private:
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
 	std::unique_ptr<qrvmasm::QRVMAssemblyStack> m_qrvmAssemblyStack;
 	qrvmasm::AbstractAssemblyStack* m_assemblyStack = nullptr;
+	std::shared_ptr<CompilationCache> m_compilationCache;
 	CommandLineOptions m_options;
 };
 
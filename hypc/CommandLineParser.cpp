@@ -32,6 +32,8 @@
 
 #include <fmt/format.h>
 
+#include <limits>
+
 using namespace hyperion::langutil;
 using namespace hyperion::yul;
 
@@ -42,6 +44,9 @@ namespace hyperion::frontend
 
 static std::string const g_strAllowPaths = "allow-paths";
 static std::string const g_strBasePath = "base-path";
+static std::string const g_strCacheDir = "cache-dir";
+static std::string const g_strCacheSizeLimit = "cache-size-limit";
+static std::string const g_strCacheStatistics = "cache-statistics";
 static std::string const g_strIncludePath = "include-path";
 static std::string const g_strAssemble = "assemble";
 static std::string const g_strCombinedJson = "combined-json";
@@ -54,6 +59,7 @@ static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportQrvmAssemblerJson = "import-asm-json";
 static std::string const g_strInputFile = "input-file";
+static std::string const g_strJobs = "jobs";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
 static std::string const g_strDebugInfo = "debug-info";
@@ -89,6 +95,7 @@ static std::string const g_strYulOptimizations = "yul-optimizations";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
 static std::string const g_strRevertStrings = "revert-strings";
+static std::string const g_strServer = "server";
 static std::string const g_strStopAfter = "stop-after";
 static std::string const g_strParsing = "parsing";
 
@@ -106,6 +113,7 @@ static std::string const g_strSourceList = "sourceList";
 static std::string const g_strStandardJSON = "standard-json";
 static std::string const g_strStrictAssembly = "strict-assembly";
 static std::string const g_strSwarm = "swarm";
+static std::string const g_strTimeReport = "time-report";
 static std::string const g_strPrettyJson = "pretty-json";
 static std::string const g_strJsonIndent = "json-indent";
 static std::string const g_strVersion = "version";
@@ -144,6 +152,7 @@ static std::map<InputMode, std::string> const g_inputModeName = {
 	{InputMode::StandardJson, "standard JSON"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
+	{InputMode::Server, "compiler server"},
 	{InputMode::QRVMAssemblerJSON, "QRVM assembler (JSON format)"},
 };
 
@@ -230,10 +239,16 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
 		input.noImportCallback == _other.input.noImportCallback &&
+		input.serverSocket == _other.input.serverSocket &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.qrvmVersion == _other.output.qrvmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.jobs == _other.output.jobs &&
+		output.cacheDir == _other.output.cacheDir &&
+		output.cacheSizeLimit == _other.output.cacheSizeLimit &&
+		output.cacheStatistics == _other.output.cacheStatistics &&
+		output.timeReport == _other.output.timeReport &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -482,6 +497,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::License:
 		case InputMode::Version:
 		case InputMode::LanguageServer:
+		case InputMode::Server:
 			hypAssert(false);
 		case InputMode::Compiler:
 		case InputMode::CompilerWithASTImport:
@@ -612,6 +628,36 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			(g_strJobs + ",j").c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Use up to n threads to generate and optimize the IR and bytecode of the contracts. "
+			"Only affects compilation via the IR and the optimization of Yul objects in assembly mode. "
+			"The output does not depend on this setting."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Reuse the bytecode and IR of contracts compiled earlier with identical sources and settings "
+			"from the given directory and store newly compiled ones there. "
+			"Not used when assembly output or gas estimates are requested."
+		)
+		(
+			g_strCacheSizeLimit.c_str(),
+			po::value<size_t>()->value_name("MiB"),
+			"Remove the least recently used entries of the compilation cache once its total size exceeds "
+			"the given number of mebibytes. Defaults to 1024."
+		)
+		(
+			g_strCacheStatistics.c_str(),
+			"Print how many contracts could be restored from the compilation cache and how many had to be "
+			"compiled and stored to stderr."
+		)
+		(
+			g_strTimeReport.c_str(),
+			"Report the wall time and the growth of the peak memory usage of each compilation phase, "
+			"both for the whole compilation and per contract, in JSON format."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -660,7 +706,8 @@ General Information)").c_str(),
 			g_strImportAst.c_str(),
 			("Import ASTs to be compiled, assumes input holds the AST in compact JSON format. "
 			"Supported Inputs is the output of the --" + g_strStandardJSON + " or the one produced by "
-			"--" + g_strCombinedJson + " " + CombinedJsonRequests::componentName(&CombinedJsonRequests::ast)).c_str()
+			"--" + g_strCombinedJson + " " + CombinedJsonRequests::componentName(&CombinedJsonRequests::ast) + ". "
+			"Files written by --" + CompilerOutputs::componentName(&CompilerOutputs::astBinary) + " are accepted as well.").c_str()
 		)
 		(
 			g_strImportQrvmAssemblerJson.c_str(),
@@ -671,6 +718,13 @@ General Information)").c_str(),
 			"Switch to language server mode (\"LSP\"). Allows the compiler to be used as an analysis backend "
 			"for your favourite IDE."
 		)
+		(
+			g_strServer.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Switch to compiler server mode. Listens on the given Unix domain socket for Standard JSON "
+			"compilation requests sent as JSON-RPC messages and keeps serving them until a client requests "
+			"the shutdown."
+		)
 	;
 	desc.add(alternativeInputModes);
 
@@ -730,6 +784,7 @@ General Information)").c_str(),
 	po::options_description outputComponents("Output Components");
 	outputComponents.add_options()
 		(CompilerOutputs::componentName(&CompilerOutputs::astCompactJson).c_str(), "AST of all source files in a compact JSON format.")
+		(CompilerOutputs::componentName(&CompilerOutputs::astBinary).c_str(), "AST of all source files in a compact binary format that --import-ast accepts. Printed in base64 unless written to files.")
 		(CompilerOutputs::componentName(&CompilerOutputs::asm_).c_str(), "QRVM assembly of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::asmJson).c_str(), "QRVM assembly of the contracts in JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::opcodes).c_str(), "Opcodes of the contracts.")
@@ -942,6 +997,7 @@ void CommandLineParser::processArgs()
 		g_strYul,
 		g_strImportAst,
 		g_strLSP,
+		g_strServer,
 		g_strImportQrvmAssemblerJson,
 	});
 
@@ -955,6 +1011,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::StandardJson;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -977,6 +1035,11 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}},
+		{g_strTimeReport, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson, InputMode::Server}},
+		{g_strCacheSizeLimit, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson, InputMode::Server}},
+		{g_strCacheStatistics, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1012,6 +1075,34 @@ void CommandLineParser::processArgs()
 			joinOptionNames(invalidOptionsForCurrentInputMode)
 		);
 
+	if (m_args.count(g_strCacheDir))
+	{
+		m_options.output.cacheDir = m_args.at(g_strCacheDir).as<std::string>();
+		if (m_options.output.cacheDir.empty())
+			hypThrow(CommandLineValidationError, "--" + g_strCacheDir + " must not be empty.");
+	}
+	for (std::string const& option: {g_strCacheSizeLimit, g_strCacheStatistics})
+		if (m_args.count(option) && m_options.output.cacheDir.empty())
+			hypThrow(CommandLineValidationError, "--" + option + " requires --" + g_strCacheDir + ".");
+	if (m_args.count(g_strCacheSizeLimit))
+	{
+		size_t sizeLimit = m_args.at(g_strCacheSizeLimit).as<size_t>();
+		if (sizeLimit == 0)
+			hypThrow(CommandLineValidationError, "--" + g_strCacheSizeLimit + " must be at least 1.");
+		if (sizeLimit > std::numeric_limits<size_t>::max() / (1024 * 1024))
+			hypThrow(CommandLineValidationError, "--" + g_strCacheSizeLimit + " is too large.");
+		m_options.output.cacheSizeLimit = sizeLimit * 1024 * 1024;
+	}
+	m_options.output.cacheStatistics = (m_args.count(g_strCacheStatistics) > 0);
+
+	if (m_options.input.mode == InputMode::Server)
+	{
+		m_options.input.serverSocket = m_args.at(g_strServer).as<std::string>();
+		if (m_options.input.serverSocket.empty())
+			hypThrow(CommandLineValidationError, "--" + g_strServer + " must not be empty.");
+		return;
+	}
+
 	if (m_options.input.mode == InputMode::LanguageServer)
 		return;
 
@@ -1019,7 +1110,10 @@ void CommandLineParser::processArgs()
 	checkMutuallyExclusive({g_strStopAfter, g_strGas});
 
 	for (std::string const& option: CompilerOutputs::componentMap() | ranges::views::keys)
-		if (option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson))
+		if (
+			option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson) &&
+			option != CompilerOutputs::componentName(&CompilerOutputs::astBinary)
+		)
 			checkMutuallyExclusive({g_strStopAfter, option});
 
 	if (m_options.input.mode == InputMode::QRVMAssemblerJSON)
@@ -1223,6 +1317,13 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<std::string>();
 	}
 
+	if (m_args.count(g_strJobs))
+	{
+		m_options.output.jobs = m_args[g_strJobs].as<unsigned>();
+		if (m_options.output.jobs == 0)
+			hypThrow(CommandLineValidationError, "--" + g_strJobs + " must be at least 1.");
+	}
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		std::vector<std::string> const nonAssemblyModeOptions = {
@@ -1403,6 +1504,8 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
+	m_options.output.timeReport = (m_args.count(g_strTimeReport) > 0);
+
 	hypAssert(
 		m_options.input.mode == InputMode::Compiler ||
 		m_options.input.mode == InputMode::CompilerWithASTImport ||
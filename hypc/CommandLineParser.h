@@ -57,6 +57,7 @@ enum class InputMode
 	Linker,
 	Assembler,
 	LanguageServer,
+	Server,
 	QRVMAssemblerJSON
 };
 
@@ -71,6 +72,7 @@ struct CompilerOutputs
 	{
 		static std::map<std::string, bool CompilerOutputs::*> const components = {
 			{"ast-compact-json", &CompilerOutputs::astCompactJson},
+			{"ast-binary", &CompilerOutputs::astBinary},
 			{"asm", &CompilerOutputs::asm_},
 			{"asm-json", &CompilerOutputs::asmJson},
 			{"opcodes", &CompilerOutputs::opcodes},
@@ -91,6 +93,7 @@ struct CompilerOutputs
 	}
 
 	bool astCompactJson = false;
+	bool astBinary = false;
 	bool asm_ = false;
 	bool asmJson = false;
 	bool opcodes = false;
@@ -176,6 +179,7 @@ struct CommandLineOptions
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
 		bool noImportCallback = false;
+		boost::filesystem::path serverSocket;
 	} input;
 
 	struct
@@ -184,6 +188,12 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::QRVMVersion qrvmVersion;
 		bool viaIR = false;
+		unsigned jobs = 1;
+		boost::filesystem::path cacheDir;
+		/// Size limit of the compilation cache in bytes, if not the default.
+		std::optional<size_t> cacheSizeLimit;
+		bool cacheStatistics = false;
+		bool timeReport = false;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -107,6 +107,8 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 
 std::string compile(std::string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
+	// The library runs one compilation at a time, so no YulString survives the previous one.
+	yul::YulStringRepository::reset();
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
 	return compiler.compile(std::move(_input));
 }
@@ -261,14 +261,14 @@ void ReferencesResolver::operator()(yul::Identifier const& _identifier)
 	// Could also use `pathFromCurrentScope`, split by '.'.
 	// If we do that, suffix should only be set for when it has a special
 	// meaning, not for normal identifierPaths.
-	auto declarations = m_resolver.nameFromCurrentScope(_identifier.name.str());
+	auto declarations = m_resolver.nameFromCurrentScope(std::string(_identifier.name.str()));
 	if (!suffix.empty())
 	{
 		// special mode to access storage variables
 		if (!declarations.empty())
 			// the special identifier exists itself, we should not allow that.
 			return;
-		std::string realName = _identifier.name.str().substr(0, _identifier.name.str().size() - suffix.size() - 1);
+		std::string realName(_identifier.name.str().substr(0, _identifier.name.str().size() - suffix.size() - 1));
 		hypAssert(!realName.empty(), "Empty name.");
 		declarations = m_resolver.nameFromCurrentScope(realName);
 		if (!declarations.empty())
@@ -320,7 +320,7 @@ void ReferencesResolver::operator()(yul::VariableDeclaration const& _varDecl)
 		validateYulIdentifierName(identifier.name, nativeLocationOf(identifier));
 
 		if (
-			auto declarations = m_resolver.nameFromCurrentScope(identifier.name.str());
+			auto declarations = m_resolver.nameFromCurrentScope(std::string(identifier.name.str()));
 			!declarations.empty()
 		)
 		{
@@ -420,10 +420,10 @@ void ReferencesResolver::validateYulIdentifierName(yul::YulString _name, SourceL
 			"User-defined identifiers in inline assembly cannot contain '.'."
 		);
 
-	if (std::set<std::string>{"this", "super", "_"}.count(_name.str()))
+	if (std::set<std::string>{"this", "super", "_"}.count(std::string(_name.str())))
 		m_errorReporter.declarationError(
 			4113_error,
 			_location,
-			"The identifier name \"" + _name.str() + "\" is reserved."
+			"The identifier name \"" + std::string(_name.str()) + "\" is reserved."
 		);
 }
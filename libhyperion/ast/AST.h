@@ -118,6 +118,9 @@ public:
 	///@todo make this const-safe by providing a different way to access the annotation
 	virtual ASTAnnotation& annotation() const;
 
+	/// Removes the results of a previous analysis from this node, so that it can be analysed again.
+	virtual void clearAnalysis() { m_annotation.reset(); }
+
 	///@{
 	///@name equality operators
 	/// Equality relies on the fact that nodes cannot be copied.
@@ -125,9 +128,17 @@ public:
 	bool operator!=(ASTNode const& _other) const { return !operator==(_other); }
 	///@}
 
-protected:
-	size_t const m_id = 0;
+	/// Key that only the parser can create, so that only it can call shiftID.
+	class IDShiftKey
+	{
+		friend class Parser;
+		IDShiftKey() = default;
+	};
+	/// Moves the ID by @a _offset. Used by the parser to renumber the nodes of sources parsed
+	/// independently of each other, see Parser::shiftNodeIDs.
+	void shiftID(int64_t _offset, IDShiftKey) { m_id = static_cast<size_t>(id() + _offset); }
 
+protected:
 	template <class T>
 	T& initAnnotation() const
 	{
@@ -137,6 +148,8 @@ protected:
 	}
 
 private:
+	/// Fixed after parsing, only changed through shiftID.
+	size_t m_id = 0;
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
 	SourceLocation m_location;
@@ -403,6 +416,7 @@ public:
 	virtual ~VariableScope() = default;
 	void addLocalVariable(VariableDeclaration const& _localVariable) { m_localVariables.push_back(&_localVariable); }
 	std::vector<VariableDeclaration const*> const& localVariables() const { return m_localVariables; }
+	void clearLocalVariables() { m_localVariables.clear(); }
 
 private:
 	std::vector<VariableDeclaration const*> m_localVariables;
@@ -574,6 +588,7 @@ public:
 	Type const* type() const override;
 
 	ContractDefinitionAnnotation& annotation() const override;
+	void clearAnalysis() override;
 
 	ContractKind contractKind() const { return m_contractKind; }
 
@@ -895,6 +910,11 @@ public:
 	virtual bool virtualSemantics() const { return markedVirtual(); }
 
 	CallableDeclarationAnnotation& annotation() const override = 0;
+	void clearAnalysis() override
+	{
+		Declaration::clearAnalysis();
+		clearLocalVariables();
+	}
 
 	/// Performs virtual or super function/modifier lookup:
 	/// If @a _searchStart is nullptr, performs virtual function lookup, i.e.
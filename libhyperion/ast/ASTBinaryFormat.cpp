@@ -0,0 +1,401 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyperion/ast/ASTBinaryFormat.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+using namespace hyperion;
+using namespace hyperion::frontend;
+
+namespace
+{
+
+std::string_view constexpr magic{"\xA5HYPAST", 7};
+uint8_t constexpr version = 2;
+/// Maximum nesting depth of arrays and objects, the same as that of the strict JSON reader,
+/// so that both formats accept the same documents and decoding cannot exhaust the stack.
+size_t constexpr maxDepth = 1000;
+
+enum class Tag: uint8_t
+{
+	Null,
+	False,
+	True,
+	Int,
+	UInt,
+	Real,
+	String,
+	Array,
+	Object,
+	SourceLocation,
+	/// Ends an array.
+	End
+};
+
+uint64_t zigzag(int64_t _value)
+{
+	return (static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63);
+}
+
+int64_t unzigzag(uint64_t _value)
+{
+	return static_cast<int64_t>(_value >> 1) ^ -static_cast<int64_t>(_value & 1);
+}
+
+void appendVarint(std::string& _output, uint64_t _value)
+{
+	for (; _value >= 0x80; _value >>= 7)
+		_output.push_back(static_cast<char>((_value & 0x7f) | 0x80));
+	_output.push_back(static_cast<char>(_value));
+}
+
+/// @returns the components of a source location of the form "start:length:sourceIndex" if
+/// formatting them again yields exactly @a _text.
+std::optional<std::array<int64_t, 3>> parseSourceLocation(std::string_view _text)
+{
+	std::array<int64_t, 3> components{};
+	char const* position = _text.data();
+	char const* end = _text.data() + _text.size();
+	for (size_t i = 0; i < components.size(); ++i)
+	{
+		if (i > 0)
+		{
+			if (position == end || *position != ':')
+				return std::nullopt;
+			++position;
+		}
+		// Rules out leading zeros and "-0", which would not be reproduced.
+		if (
+			position == end ||
+			(*position == '0' && position + 1 != end && position[1] != ':') ||
+			(*position == '-' && (position + 1 == end || position[1] == '0'))
+		)
+			return std::nullopt;
+		auto [next, error] = std::from_chars(position, end, components[i]);
+		if (error != std::errc{})
+			return std::nullopt;
+		position = next;
+	}
+	if (position != end)
+		return std::nullopt;
+	return components;
+}
+
+class Decoder
+{
+public:
+	explicit Decoder(std::string_view _data): m_data(_data) {}
+
+	Json::Value run()
+	{
+		astAssert(ASTBinaryFormat::isEncoded(m_data), "Not a binary AST.");
+		m_position = magic.size();
+		astAssert(readByte() == version, "Unsupported binary AST version.");
+
+		uint64_t const stringCount = readVarint();
+		// Every string takes at least one byte, which bounds the reservation.
+		astAssert(stringCount <= m_data.size(), "Invalid binary AST.");
+		m_strings.reserve(stringCount);
+		for (uint64_t i = 0; i < stringCount; ++i)
+		{
+			uint64_t const length = readVarint();
+			astAssert(length <= m_data.size() - m_position, "Invalid binary AST.");
+			m_strings.emplace_back(m_data.substr(m_position, length));
+			m_position += length;
+		}
+
+		Json::Value document = decode();
+		astAssert(m_position == m_data.size(), "Invalid binary AST.");
+		return document;
+	}
+
+private:
+	/// Tracks the nesting depth of the array or object being decoded.
+	struct DepthGuard
+	{
+		explicit DepthGuard(size_t& _depth): m_depth(_depth)
+		{
+			astAssert(++m_depth <= maxDepth, "Binary AST is nested too deeply.");
+		}
+		~DepthGuard() { --m_depth; }
+		size_t& m_depth;
+	};
+
+	Json::Value decode() { return decode(static_cast<Tag>(readByte())); }
+
+	Json::Value decode(Tag _tag)
+	{
+		switch (_tag)
+		{
+		case Tag::Null:
+			return Json::nullValue;
+		case Tag::False:
+			return false;
+		case Tag::True:
+			return true;
+		case Tag::Int:
+			return Json::Value(static_cast<Json::Int64>(unzigzag(readVarint())));
+		case Tag::UInt:
+			return Json::Value(static_cast<Json::UInt64>(readVarint()));
+		case Tag::Real:
+		{
+			uint64_t bits = 0;
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				bits |= uint64_t(readByte()) << (8 * i);
+			double real = 0;
+			std::memcpy(&real, &bits, sizeof(real));
+			return real;
+		}
+		case Tag::String:
+			return Json::Value(readString(readVarint()));
+		case Tag::SourceLocation:
+		{
+			std::string location = std::to_string(unzigzag(readVarint()));
+			location += ":" + std::to_string(unzigzag(readVarint()));
+			location += ":" + std::to_string(unzigzag(readVarint()));
+			return location;
+		}
+		case Tag::Array:
+		{
+			DepthGuard guard{m_depth};
+			Json::Value array(Json::arrayValue);
+			for (Tag tag = static_cast<Tag>(readByte()); tag != Tag::End; tag = static_cast<Tag>(readByte()))
+				array.append(decode(tag));
+			return array;
+		}
+		case Tag::Object:
+		{
+			DepthGuard guard{m_depth};
+			Json::Value object(Json::objectValue);
+			// Key indices are offset by one, zero ends the object.
+			for (uint64_t keyIndex = readVarint(); keyIndex != 0; keyIndex = readVarint())
+			{
+				std::string const& key = readString(keyIndex - 1);
+				object[key] = decode();
+			}
+			return object;
+		}
+		case Tag::End:
+			break;
+		}
+		astAssert(false, "Invalid binary AST.");
+		return {};
+	}
+
+	std::string const& readString(uint64_t _index)
+	{
+		astAssert(_index < m_strings.size(), "Invalid binary AST.");
+		return m_strings[_index];
+	}
+
+	uint8_t readByte()
+	{
+		astAssert(m_position < m_data.size(), "Unexpected end of binary AST.");
+		return static_cast<uint8_t>(m_data[m_position++]);
+	}
+
+	uint64_t readVarint()
+	{
+		uint64_t value = 0;
+		for (unsigned shift = 0; ; shift += 7)
+		{
+			astAssert(shift < 64, "Invalid binary AST.");
+			uint8_t const byte = readByte();
+			value |= uint64_t(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+	}
+
+	std::string_view m_data;
+	size_t m_position = 0;
+	size_t m_depth = 0;
+	std::vector<std::string> m_strings;
+};
+
+}
+
+std::string ASTBinaryFormat::encode(Json::Value const& _document)
+{
+	ASTBinaryWriter writer;
+	writer.write(_document);
+	return writer.finish();
+}
+
+Json::Value ASTBinaryFormat::decode(std::string_view _data)
+{
+	return Decoder{_data}.run();
+}
+
+bool ASTBinaryFormat::isEncoded(std::string_view _data)
+{
+	return _data.substr(0, magic.size()) == magic;
+}
+
+void ASTBinaryWriter::write(Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		beginValue();
+		writeTag(uint8_t(Tag::Null));
+		break;
+	case Json::booleanValue:
+		beginValue();
+		writeTag(uint8_t(_value.asBool() ? Tag::True : Tag::False));
+		break;
+	case Json::intValue:
+		beginValue();
+		writeTag(uint8_t(Tag::Int));
+		appendVarint(m_output, zigzag(_value.asInt64()));
+		break;
+	case Json::uintValue:
+		beginValue();
+		writeTag(uint8_t(Tag::UInt));
+		appendVarint(m_output, _value.asUInt64());
+		break;
+	case Json::realValue:
+	{
+		beginValue();
+		writeTag(uint8_t(Tag::Real));
+		double const real = _value.asDouble();
+		uint64_t bits = 0;
+		std::memcpy(&bits, &real, sizeof(bits));
+		for (size_t i = 0; i < sizeof(bits); ++i)
+			m_output.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+		break;
+	}
+	case Json::stringValue:
+	{
+		beginValue();
+		char const* begin = nullptr;
+		char const* end = nullptr;
+		_value.getString(&begin, &end);
+		std::string_view const string(begin, static_cast<size_t>(end - begin));
+		if (auto const location = parseSourceLocation(string))
+		{
+			writeTag(uint8_t(Tag::SourceLocation));
+			for (int64_t component: *location)
+				appendVarint(m_output, zigzag(component));
+		}
+		else
+		{
+			writeTag(uint8_t(Tag::String));
+			appendVarint(m_output, stringIndex(string));
+		}
+		break;
+	}
+	case Json::arrayValue:
+		beginArray();
+		for (Json::Value const& element: _value)
+			write(element);
+		endArray();
+		break;
+	case Json::objectValue:
+		beginObject();
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			key(it.name());
+			write(*it);
+		}
+		endObject();
+		break;
+	}
+}
+
+void ASTBinaryWriter::beginObject()
+{
+	beginValue();
+	writeTag(uint8_t(Tag::Object));
+	m_containers.push_back(true);
+}
+
+void ASTBinaryWriter::key(std::string const& _name)
+{
+	astAssert(!m_containers.empty() && m_containers.back() && !m_keyWritten, "Key outside of an object.");
+	appendVarint(m_output, stringIndex(_name) + 1);
+	m_keyWritten = true;
+}
+
+void ASTBinaryWriter::endObject()
+{
+	astAssert(!m_containers.empty() && m_containers.back() && !m_keyWritten, "Unexpected end of object.");
+	m_containers.pop_back();
+	appendVarint(m_output, 0);
+}
+
+void ASTBinaryWriter::beginArray()
+{
+	beginValue();
+	writeTag(uint8_t(Tag::Array));
+	m_containers.push_back(false);
+}
+
+void ASTBinaryWriter::endArray()
+{
+	astAssert(!m_containers.empty() && !m_containers.back(), "Unexpected end of array.");
+	m_containers.pop_back();
+	writeTag(uint8_t(Tag::End));
+}
+
+std::string ASTBinaryWriter::finish() const
+{
+	astAssert(m_started && m_containers.empty(), "Incomplete document.");
+
+	// The string table is only complete after encoding the document, but precedes it.
+	std::string result{magic};
+	result.push_back(static_cast<char>(version));
+	appendVarint(result, m_stringTable.size());
+	for (std::string const* string: m_stringTable)
+	{
+		appendVarint(result, string->size());
+		result += *string;
+	}
+	result += m_output;
+	return result;
+}
+
+void ASTBinaryWriter::beginValue()
+{
+	if (m_containers.empty())
+	{
+		astAssert(!m_started, "Document already complete.");
+		m_started = true;
+	}
+	else if (m_containers.back())
+	{
+		astAssert(m_keyWritten, "Object member without key.");
+		m_keyWritten = false;
+	}
+}
+
+size_t ASTBinaryWriter::stringIndex(std::string_view _string)
+{
+	auto [it, inserted] = m_strings.try_emplace(std::string(_string), m_strings.size());
+	if (inserted)
+		m_stringTable.push_back(&it->first);
+	return it->second;
+}
@@ -0,0 +1,102 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of JSON ASTs.
+ */
+
+#pragma once
+
+#include <libhyputil/JSON.h>
+
+#include <json/json.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace hyperion::frontend
+{
+
+/**
+ * Binary encoding of the JSON documents that contain ASTs as produced by the ASTJsonExporter.
+ * Decoding yields a document that is equal to the encoded one, so it can be handed to the
+ * ASTJsonImporter in place of the parsed JSON, while being considerably smaller and faster
+ * to read and write than JSON text.
+ *
+ * Layout, where all integers are unsigned LEB128 varints and signed ones are zigzag-encoded:
+ *  - the magic bytes and a version byte,
+ *  - the string table: the number of strings followed by each string's length and bytes,
+ *  - the root value. Each value starts with a tag byte. Object keys and strings are
+ *    indices into the string table, integers (such as node IDs) are varints and source
+ *    locations of the form "start:length:sourceIndex" are stored as three varints.
+ *    Arrays end with an end tag and objects with the key index zero, the indices of keys
+ *    being offset by one, so that documents can be encoded while they are produced.
+ */
+class ASTBinaryFormat
+{
+public:
+	/// @returns the binary encoding of @a _document.
+	static std::string encode(Json::Value const& _document);
+
+	/// @returns the document encoded in @a _data.
+	/// Throws InvalidAstError if @a _data is not a valid encoding.
+	static Json::Value decode(std::string_view _data);
+
+	/// @returns true if @a _data starts with the magic bytes of the format.
+	static bool isEncoded(std::string_view _data);
+};
+
+/**
+ * Encodes a document in the binary AST format while it is being produced, e.g. by
+ * ASTJsonExporter::print(), without building it as a Json::Value first.
+ */
+class ASTBinaryWriter: public util::JsonOutput
+{
+public:
+	void write(Json::Value const& _value) override;
+
+	void beginObject() override;
+	void key(std::string const& _name) override;
+	void endObject() override;
+
+	void beginArray() override;
+	void endArray() override;
+
+	/// @returns the encoding of the document written so far, which has to be complete.
+	std::string finish() const;
+
+private:
+	/// Marks the start of the next value.
+	void beginValue();
+	size_t stringIndex(std::string_view _string);
+	void writeTag(uint8_t _tag) { m_output.push_back(static_cast<char>(_tag)); }
+
+	std::string m_output;
+	std::unordered_map<std::string, size_t> m_strings;
+	/// Strings in the order of their indices, pointing into m_strings.
+	std::vector<std::string const*> m_stringTable;
+	/// Whether each of the arrays and objects being written is an object.
+	std::vector<bool> m_containers;
+	/// Whether the key of the next member of the innermost object was written.
+	bool m_keyWritten = false;
+	/// Whether the root value was started.
+	bool m_started = false;
+};
+
+}
@@ -29,6 +29,7 @@
 #include <libyul/AST.h>
 #include <libyul/backends/qrvm/QRVMDialect.h>
 
+#include <libhyputil/Common.h>
 #include <libhyputil/JSON.h>
 #include <libhyputil/UTF8.h>
 #include <libhyputil/CommonData.h>
@@ -37,7 +38,9 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <map>
 #include <utility>
+#include <variant>
 #include <vector>
 #include <algorithm>
 #include <limits>
@@ -50,8 +53,8 @@ using namespace hyperion::langutil;
 namespace
 {
 
-template<typename V, template<typename> typename C>
-void addIfSet(std::vector<std::pair<std::string, Json::Value>>& _attributes, std::string const& _name, C<V> const& _value)
+template<typename Attributes, typename V, template<typename> typename C>
+void addIfSet(Attributes& _attributes, std::string const& _name, C<V> const& _value)
 {
 	if constexpr (std::is_same_v<C<V>, hyperion::util::SetOnce<V>>)
 	{
@@ -82,31 +85,93 @@ ASTJsonExporter::ASTJsonExporter(CompilerStack::State _stackState, std::map<std:
 void ASTJsonExporter::setJsonNode(
 	ASTNode const& _node,
 	std::string const& _nodeName,
-	std::initializer_list<std::pair<std::string, Json::Value>>&& _attributes
+	std::initializer_list<std::pair<std::string, AttributeValue>>&& _attributes
 )
 {
 	ASTJsonExporter::setJsonNode(
 		_node,
 		_nodeName,
-		std::vector<std::pair<std::string, Json::Value>>(std::move(_attributes))
+		Attributes(std::move(_attributes))
 	);
 }
 
 void ASTJsonExporter::setJsonNode(
 	ASTNode const& _node,
 	std::string const& _nodeType,
-	std::vector<std::pair<std::string, Json::Value>>&& _attributes
+	Attributes&& _attributes
 )
 {
-	m_currentValue = Json::objectValue;
-	m_currentValue["id"] = nodeId(_node);
-	m_currentValue["src"] = sourceLocationToString(_node.location());
+	std::map<std::string, AttributeValue> members;
+	members["id"] = Json::Value(nodeId(_node));
+	members["src"] = Json::Value(sourceLocationToString(_node.location()));
 	if (auto const* documented = dynamic_cast<Documented const*>(&_node))
 		if (documented->documentation())
-			m_currentValue["documentation"] = *documented->documentation();
-	m_currentValue["nodeType"] = _nodeType;
-	for (auto& e: _attributes)
-		m_currentValue[e.first] = std::move(e.second);
+			members["documentation"] = Json::Value(*documented->documentation());
+	members["nodeType"] = Json::Value(_nodeType);
+	for (auto& [name, value]: _attributes)
+		members.insert_or_assign(std::move(name), std::move(value));
+
+	if (m_writer)
+	{
+		writeJsonNode(std::move(members));
+		return;
+	}
+
+	Json::Value node(Json::objectValue);
+	for (auto& [name, value]: members)
+		if (auto* children = std::get_if<ChildNodes>(&value))
+			node[name] = toJson(*children);
+		else
+			node[name] = std::move(std::get<Json::Value>(value));
+	m_currentValue = std::move(node);
+}
+
+void ASTJsonExporter::writeJsonNode(std::map<std::string, AttributeValue>&& _members)
+{
+	// Null members are omitted, as removeNullMembers() does for the result of toJson().
+	m_writer->beginObject();
+	for (auto& [name, value]: _members)
+		if (auto* children = std::get_if<ChildNodes>(&value))
+		{
+			if (!children->isArray)
+			{
+				if (!children->nodes.front())
+					continue;
+				m_writer->key(name);
+				children->nodes.front()->accept(*this);
+				continue;
+			}
+			m_writer->key(name);
+			m_writer->beginArray();
+			for (ASTNode const* node: children->nodes)
+				if (node)
+					node->accept(*this);
+				else
+					m_writer->write(Json::nullValue);
+			m_writer->endArray();
+		}
+		else
+		{
+			Json::Value& json = std::get<Json::Value>(value);
+			if (json.isNull())
+				continue;
+			m_writer->key(name);
+			m_writer->write(util::removeNullMembers(std::move(json)));
+		}
+	m_writer->endObject();
+}
+
+Json::Value ASTJsonExporter::toJson(ChildNodes const& _children)
+{
+	if (!_children.isArray)
+		return _children.nodes.front() ? toJson(*_children.nodes.front()) : Json::nullValue;
+	Json::Value result(Json::arrayValue);
+	for (ASTNode const* node: _children.nodes)
+		if (node)
+			appendMove(result, toJson(*node));
+		else
+			result.append(Json::nullValue);
+	return result;
 }
 
 std::optional<size_t> ASTJsonExporter::sourceIndexFromLocation(SourceLocation const& _location) const
@@ -163,11 +228,11 @@ Json::Value ASTJsonExporter::typePointerToJson(std::optional<FuncCallArguments>
 }
 
 void ASTJsonExporter::appendExpressionAttributes(
-	std::vector<std::pair<std::string, Json::Value>>& _attributes,
+	Attributes& _attributes,
 	ExpressionAnnotation const& _annotation
 )
 {
-	std::vector<std::pair<std::string, Json::Value>> exprAttributes = {
+	Attributes exprAttributes = {
 		std::make_pair("typeDescriptions", typePointerToJson(_annotation.type)),
 		std::make_pair("argumentTypes", typePointerToJson(_annotation.arguments))
 	};
@@ -200,20 +265,30 @@ Json::Value ASTJsonExporter::inlineAssemblyIdentifierToJson(std::pair<yul::Ident
 
 void ASTJsonExporter::print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	util::JsonWriter writer(_stream, _format);
+	print(writer, _node);
+}
+
+void ASTJsonExporter::print(util::JsonOutput& _writer, ASTNode const& _node)
+{
+	util::JsonOutput* outerWriter = std::exchange(m_writer, &_writer);
+	ScopeGuard restoreWriter([&]() { m_writer = outerWriter; });
+	_node.accept(*this);
 }
 
 Json::Value ASTJsonExporter::toJson(ASTNode const& _node)
 {
+	util::JsonOutput* outerWriter = std::exchange(m_writer, nullptr);
+	ScopeGuard restoreWriter([&]() { m_writer = outerWriter; });
 	_node.accept(*this);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
 bool ASTJsonExporter::visit(SourceUnit const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
-		std::make_pair("nodes", toJson(_node.nodes())),
+		std::make_pair("nodes", children(_node.nodes())),
 	};
 
 	if (_node.experimentalHyperion())
@@ -252,7 +327,7 @@ bool ASTJsonExporter::visit(PragmaDirective const& _node)
 
 bool ASTJsonExporter::visit(ImportDirective const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("file", _node.path()),
 		std::make_pair("sourceUnit", idOrNull(_node.annotation().sourceUnit)),
 		std::make_pair("scope", idOrNull(_node.scope()))
@@ -280,18 +355,18 @@ bool ASTJsonExporter::visit(ImportDirective const& _node)
 
 bool ASTJsonExporter::visit(ContractDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("contractKind", contractKind(_node.contractKind())),
 		std::make_pair("abstract", _node.abstract()),
-		std::make_pair("baseContracts", toJson(_node.baseContracts())),
+		std::make_pair("baseContracts", children(_node.baseContracts())),
 		std::make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies | ranges::views::keys)),
 		// Do not require call graph because the AST is also created for incorrect sources.
 		std::make_pair("usedEvents", getContainerIds(_node.interfaceEvents(false))),
 		std::make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
-		std::make_pair("nodes", toJson(_node.subNodes())),
+		std::make_pair("nodes", children(_node.subNodes())),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
@@ -331,16 +406,16 @@ bool ASTJsonExporter::visit(IdentifierPath const& _node)
 bool ASTJsonExporter::visit(InheritanceSpecifier const& _node)
 {
 	setJsonNode(_node, "InheritanceSpecifier", {
-		std::make_pair("baseName", toJson(_node.name())),
-		std::make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
+		std::make_pair("baseName", child(_node.name())),
+		std::make_pair("arguments", children(_node.arguments()))
 	});
 	return false;
 }
 
 bool ASTJsonExporter::visit(UsingForDirective const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("typeName", _node.typeName() ? toJson(*_node.typeName()) : Json::nullValue)
+	Attributes attributes = {
+		std::make_pair("typeName", child(_node.typeName()))
 	};
 
 	if (_node.usesBraces())
@@ -365,7 +440,7 @@ bool ASTJsonExporter::visit(UsingForDirective const& _node)
 		auto const& functionAndOperators = _node.functionsAndOperators();
 		hypAssert(_node.functionsAndOperators().size() == 1);
 		hypAssert(!functionAndOperators.front().second.has_value());
-		attributes.emplace_back("libraryName", toJson(*(functionAndOperators.front().first)));
+		attributes.emplace_back("libraryName", child(*(functionAndOperators.front().first)));
 	}
 	attributes.emplace_back("global", _node.global());
 
@@ -376,12 +451,12 @@ bool ASTJsonExporter::visit(UsingForDirective const& _node)
 
 bool ASTJsonExporter::visit(StructDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		std::make_pair("members", toJson(_node.members())),
+		std::make_pair("members", children(_node.members())),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
 
@@ -394,11 +469,11 @@ bool ASTJsonExporter::visit(StructDefinition const& _node)
 
 bool ASTJsonExporter::visit(EnumDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
-		std::make_pair("members", toJson(_node.members()))
+		std::make_pair("documentation", child(_node.documentation())),
+		std::make_pair("members", children(_node.members()))
 	};
 
 	addIfSet(attributes,"canonicalName", _node.annotation().canonicalName);
@@ -420,10 +495,10 @@ bool ASTJsonExporter::visit(EnumValue const& _node)
 bool ASTJsonExporter::visit(UserDefinedValueTypeDefinition const& _node)
 {
 	hypAssert(_node.underlyingType(), "");
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("underlyingType", toJson(*_node.underlyingType()))
+		std::make_pair("underlyingType", child(*_node.underlyingType()))
 	};
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
 
@@ -435,7 +510,7 @@ bool ASTJsonExporter::visit(UserDefinedValueTypeDefinition const& _node)
 bool ASTJsonExporter::visit(ParameterList const& _node)
 {
 	setJsonNode(_node, "ParameterList", {
-		std::make_pair("parameters", toJson(_node.parameters()))
+		std::make_pair("parameters", children(_node.parameters()))
 	});
 	return false;
 }
@@ -443,25 +518,25 @@ bool ASTJsonExporter::visit(ParameterList const& _node)
 bool ASTJsonExporter::visit(OverrideSpecifier const& _node)
 {
 	setJsonNode(_node, "OverrideSpecifier", {
-		std::make_pair("overrides", toJson(_node.overrides()))
+		std::make_pair("overrides", children(_node.overrides()))
 	});
 	return false;
 }
 
 bool ASTJsonExporter::visit(FunctionDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("kind", _node.isFree() ? "freeFunction" : TokenTraits::toString(_node.kind())),
 		std::make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
 		std::make_pair("virtual", _node.markedVirtual()),
-		std::make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json::nullValue),
-		std::make_pair("parameters", toJson(_node.parameterList())),
-		std::make_pair("returnParameters", toJson(*_node.returnParameterList())),
-		std::make_pair("modifiers", toJson(_node.modifiers())),
-		std::make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue),
+		std::make_pair("overrides", child(_node.overrides())),
+		std::make_pair("parameters", child(_node.parameterList())),
+		std::make_pair("returnParameters", child(*_node.returnParameterList())),
+		std::make_pair("modifiers", children(_node.modifiers())),
+		std::make_pair("body", child(_node.isImplemented() ? &_node.body() : nullptr)),
 		std::make_pair("implemented", _node.isImplemented()),
 		std::make_pair("scope", idOrNull(_node.scope()))
 	};
@@ -489,24 +564,24 @@ bool ASTJsonExporter::visit(FunctionDefinition const& _node)
 
 bool ASTJsonExporter::visit(VariableDeclaration const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("typeName", toJson(_node.typeName())),
+		std::make_pair("typeName", child(_node.typeName())),
 		std::make_pair("constant", _node.isConstant()),
 		std::make_pair("mutability", VariableDeclaration::mutabilityToString(_node.mutability())),
 		std::make_pair("stateVariable", _node.isStateVariable()),
 		std::make_pair("storageLocation", location(_node.referenceLocation())),
-		std::make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json::nullValue),
+		std::make_pair("overrides", child(_node.overrides())),
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		std::make_pair("value", _node.value() ? toJson(*_node.value()) : Json::nullValue),
+		std::make_pair("value", child(_node.value())),
 		std::make_pair("scope", idOrNull(_node.scope())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
 	if (_node.isStateVariable() && _node.isPublic())
 		attributes.emplace_back("functionSelector", _node.externalIdentifierHex());
 	if (_node.isStateVariable() && _node.documentation())
-		attributes.emplace_back("documentation", toJson(*_node.documentation()));
+		attributes.emplace_back("documentation", child(*_node.documentation()));
 	if (m_inEvent)
 		attributes.emplace_back("indexed", _node.isIndexed());
 	if (!_node.annotation().baseFunctions.empty())
@@ -517,15 +592,15 @@ bool ASTJsonExporter::visit(VariableDeclaration const& _node)
 
 bool ASTJsonExporter::visit(ModifierDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
+		std::make_pair("documentation", child(_node.documentation())),
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
-		std::make_pair("parameters", toJson(_node.parameterList())),
+		std::make_pair("parameters", child(_node.parameterList())),
 		std::make_pair("virtual", _node.markedVirtual()),
-		std::make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json::nullValue),
-		std::make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue)
+		std::make_pair("overrides", child(_node.overrides())),
+		std::make_pair("body", child(_node.isImplemented() ? &_node.body() : nullptr))
 	};
 	if (!_node.annotation().baseFunctions.empty())
 		attributes.emplace_back(std::make_pair("baseModifiers", getContainerIds(_node.annotation().baseFunctions, true)));
@@ -535,9 +610,9 @@ bool ASTJsonExporter::visit(ModifierDefinition const& _node)
 
 bool ASTJsonExporter::visit(ModifierInvocation const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes{
-		std::make_pair("modifierName", toJson(_node.name())),
-		std::make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
+	Attributes attributes{
+		std::make_pair("modifierName", child(_node.name())),
+		std::make_pair("arguments", children(_node.arguments()))
 	};
 	if (Declaration const* declaration = _node.name().annotation().referencedDeclaration)
 	{
@@ -553,11 +628,11 @@ bool ASTJsonExporter::visit(ModifierInvocation const& _node)
 bool ASTJsonExporter::visit(EventDefinition const& _node)
 {
 	m_inEvent = true;
-	std::vector<std::pair<std::string, Json::Value>> _attributes = {
+	Attributes _attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
-		std::make_pair("parameters", toJson(_node.parameterList())),
+		std::make_pair("documentation", child(_node.documentation())),
+		std::make_pair("parameters", child(_node.parameterList())),
 		std::make_pair("anonymous", _node.isAnonymous())
 	};
 	if (m_stackState >= CompilerStack::State::AnalysisSuccessful)
@@ -573,11 +648,11 @@ bool ASTJsonExporter::visit(EventDefinition const& _node)
 
 bool ASTJsonExporter::visit(ErrorDefinition const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> _attributes = {
+	Attributes _attributes = {
 		std::make_pair("name", _node.name()),
 		std::make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
-		std::make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
-		std::make_pair("parameters", toJson(_node.parameterList()))
+		std::make_pair("documentation", child(_node.documentation())),
+		std::make_pair("parameters", child(_node.parameterList()))
 	};
 	if (m_stackState >= CompilerStack::State::AnalysisSuccessful)
 		_attributes.emplace_back(std::make_pair("errorSelector", _node.functionType(true)->externalIdentifierHex()));
@@ -588,7 +663,7 @@ bool ASTJsonExporter::visit(ErrorDefinition const& _node)
 
 bool ASTJsonExporter::visit(ElementaryTypeName const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("name", _node.typeName().toString()),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	};
@@ -603,7 +678,7 @@ bool ASTJsonExporter::visit(ElementaryTypeName const& _node)
 bool ASTJsonExporter::visit(UserDefinedTypeName const& _node)
 {
 	setJsonNode(_node, "UserDefinedTypeName", {
-		std::make_pair("pathNode", toJson(_node.pathNode())),
+		std::make_pair("pathNode", child(_node.pathNode())),
 		std::make_pair("referencedDeclaration", idOrNull(_node.pathNode().annotation().referencedDeclaration)),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
@@ -615,8 +690,8 @@ bool ASTJsonExporter::visit(FunctionTypeName const& _node)
 	setJsonNode(_node, "FunctionTypeName", {
 		std::make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		std::make_pair("stateMutability", stateMutabilityToString(_node.stateMutability())),
-		std::make_pair("parameterTypes", toJson(*_node.parameterTypeList())),
-		std::make_pair("returnParameterTypes", toJson(*_node.returnParameterTypeList())),
+		std::make_pair("parameterTypes", child(*_node.parameterTypeList())),
+		std::make_pair("returnParameterTypes", child(*_node.returnParameterTypeList())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -625,10 +700,10 @@ bool ASTJsonExporter::visit(FunctionTypeName const& _node)
 bool ASTJsonExporter::visit(Mapping const& _node)
 {
 	setJsonNode(_node, "Mapping", {
-		std::make_pair("keyType", toJson(_node.keyType())),
+		std::make_pair("keyType", child(_node.keyType())),
 		std::make_pair("keyName", _node.keyName()),
 		std::make_pair("keyNameLocation", sourceLocationToString(_node.keyNameLocation())),
-		std::make_pair("valueType", toJson(_node.valueType())),
+		std::make_pair("valueType", child(_node.valueType())),
 		std::make_pair("valueName", _node.valueName()),
 		std::make_pair("valueNameLocation", sourceLocationToString(_node.valueNameLocation())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
@@ -639,8 +714,8 @@ bool ASTJsonExporter::visit(Mapping const& _node)
 bool ASTJsonExporter::visit(ArrayTypeName const& _node)
 {
 	setJsonNode(_node, "ArrayTypeName", {
-		std::make_pair("baseType", toJson(_node.baseType())),
-		std::make_pair("length", toJsonOrNull(_node.length())),
+		std::make_pair("baseType", child(_node.baseType())),
+		std::make_pair("length", child(_node.length())),
 		std::make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
 	});
 	return false;
@@ -663,7 +738,7 @@ bool ASTJsonExporter::visit(InlineAssembly const& _node)
 	for (Json::Value& it: externalReferences | ranges::views::values)
 		externalReferencesJson.append(std::move(it));
 
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("AST", Json::Value(yul::AsmJsonConverter(sourceIndexFromLocation(_node.location()))(_node.operations()))),
 		std::make_pair("externalReferences", std::move(externalReferencesJson)),
 		std::make_pair("qrvmVersion", dynamic_cast<hyperion::yul::QRVMDialect const&>(_node.dialect()).qrvmVersion().name())
@@ -687,7 +762,7 @@ bool ASTJsonExporter::visit(InlineAssembly const& _node)
 bool ASTJsonExporter::visit(Block const& _node)
 {
 	setJsonNode(_node, _node.unchecked() ? "UncheckedBlock" : "Block", {
-		std::make_pair("statements", toJson(_node.statements()))
+		std::make_pair("statements", children(_node.statements()))
 	});
 	return false;
 }
@@ -701,9 +776,9 @@ bool ASTJsonExporter::visit(PlaceholderStatement const& _node)
 bool ASTJsonExporter::visit(IfStatement const& _node)
 {
 	setJsonNode(_node, "IfStatement", {
-		std::make_pair("condition", toJson(_node.condition())),
-		std::make_pair("trueBody", toJson(_node.trueStatement())),
-		std::make_pair("falseBody", toJsonOrNull(_node.falseStatement()))
+		std::make_pair("condition", child(_node.condition())),
+		std::make_pair("trueBody", child(_node.trueStatement())),
+		std::make_pair("falseBody", child(_node.falseStatement()))
 	});
 	return false;
 }
@@ -712,8 +787,8 @@ bool ASTJsonExporter::visit(TryCatchClause const& _node)
 {
 	setJsonNode(_node, "TryCatchClause", {
 		std::make_pair("errorName", _node.errorName()),
-		std::make_pair("parameters", toJsonOrNull(_node.parameters())),
-		std::make_pair("block", toJson(_node.block()))
+		std::make_pair("parameters", child(_node.parameters())),
+		std::make_pair("block", child(_node.block()))
 	});
 	return false;
 }
@@ -721,8 +796,8 @@ bool ASTJsonExporter::visit(TryCatchClause const& _node)
 bool ASTJsonExporter::visit(TryStatement const& _node)
 {
 	setJsonNode(_node, "TryStatement", {
-		std::make_pair("externalCall", toJson(_node.externalCall())),
-		std::make_pair("clauses", toJson(_node.clauses()))
+		std::make_pair("externalCall", child(_node.externalCall())),
+		std::make_pair("clauses", children(_node.clauses()))
 	});
 	return false;
 }
@@ -733,8 +808,8 @@ bool ASTJsonExporter::visit(WhileStatement const& _node)
 		_node,
 		_node.isDoWhile() ? "DoWhileStatement" : "WhileStatement",
 		{
-			std::make_pair("condition", toJson(_node.condition())),
-			std::make_pair("body", toJson(_node.body()))
+			std::make_pair("condition", child(_node.condition())),
+			std::make_pair("body", child(_node.body()))
 		}
 	);
 	return false;
@@ -743,11 +818,11 @@ bool ASTJsonExporter::visit(WhileStatement const& _node)
 bool ASTJsonExporter::visit(ForStatement const& _node)
 {
 
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("initializationExpression", toJsonOrNull(_node.initializationExpression())),
-		std::make_pair("condition", toJsonOrNull(_node.condition())),
-		std::make_pair("loopExpression", toJsonOrNull(_node.loopExpression())),
-		std::make_pair("body", toJson(_node.body()))
+	Attributes attributes = {
+		std::make_pair("initializationExpression", child(_node.initializationExpression())),
+		std::make_pair("condition", child(_node.condition())),
+		std::make_pair("loopExpression", child(_node.loopExpression())),
+		std::make_pair("body", child(_node.body()))
 	};
 
 	if (_node.annotation().isSimpleCounterLoop.set())
@@ -772,7 +847,7 @@ bool ASTJsonExporter::visit(Break const& _node)
 bool ASTJsonExporter::visit(Return const& _node)
 {
 	setJsonNode(_node, "Return", {
-		std::make_pair("expression", toJsonOrNull(_node.expression())),
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("functionReturnParameters", idOrNull(_node.annotation().functionReturnParameters))
 	});
 	return false;
@@ -781,7 +856,7 @@ bool ASTJsonExporter::visit(Return const& _node)
 bool ASTJsonExporter::visit(EmitStatement const& _node)
 {
 	setJsonNode(_node, "EmitStatement", {
-		std::make_pair("eventCall", toJson(_node.eventCall()))
+		std::make_pair("eventCall", child(_node.eventCall()))
 	});
 	return false;
 }
@@ -789,7 +864,7 @@ bool ASTJsonExporter::visit(EmitStatement const& _node)
 bool ASTJsonExporter::visit(RevertStatement const& _node)
 {
 	setJsonNode(_node, "RevertStatement", {
-		std::make_pair("errorCall", toJson(_node.errorCall()))
+		std::make_pair("errorCall", child(_node.errorCall()))
 	});
 	return false;
 }
@@ -801,8 +876,8 @@ bool ASTJsonExporter::visit(VariableDeclarationStatement const& _node)
 		appendMove(varDecs, idOrNull(v.get()));
 	setJsonNode(_node, "VariableDeclarationStatement", {
 		std::make_pair("assignments", std::move(varDecs)),
-		std::make_pair("declarations", toJson(_node.declarations())),
-		std::make_pair("initialValue", toJsonOrNull(_node.initialValue()))
+		std::make_pair("declarations", children(_node.declarations())),
+		std::make_pair("initialValue", child(_node.initialValue()))
 	});
 	return false;
 }
@@ -810,17 +885,17 @@ bool ASTJsonExporter::visit(VariableDeclarationStatement const& _node)
 bool ASTJsonExporter::visit(ExpressionStatement const& _node)
 {
 	setJsonNode(_node, "ExpressionStatement", {
-		std::make_pair("expression", toJson(_node.expression()))
+		std::make_pair("expression", child(_node.expression()))
 	});
 	return false;
 }
 
 bool ASTJsonExporter::visit(Conditional const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("condition", toJson(_node.condition())),
-		std::make_pair("trueExpression", toJson(_node.trueExpression())),
-		std::make_pair("falseExpression", toJson(_node.falseExpression()))
+	Attributes attributes = {
+		std::make_pair("condition", child(_node.condition())),
+		std::make_pair("trueExpression", child(_node.trueExpression())),
+		std::make_pair("falseExpression", child(_node.falseExpression()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Conditional", std::move(attributes));
@@ -829,10 +904,10 @@ bool ASTJsonExporter::visit(Conditional const& _node)
 
 bool ASTJsonExporter::visit(Assignment const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("operator", TokenTraits::toString(_node.assignmentOperator())),
-		std::make_pair("leftHandSide", toJson(_node.leftHandSide())),
-		std::make_pair("rightHandSide", toJson(_node.rightHandSide()))
+		std::make_pair("leftHandSide", child(_node.leftHandSide())),
+		std::make_pair("rightHandSide", child(_node.rightHandSide()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Assignment", std::move(attributes));
@@ -841,9 +916,9 @@ bool ASTJsonExporter::visit(Assignment const& _node)
 
 bool ASTJsonExporter::visit(TupleExpression const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("isInlineArray", Json::Value(_node.isInlineArray())),
-		std::make_pair("components", toJson(_node.components())),
+		std::make_pair("components", children(_node.components())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "TupleExpression", std::move(attributes));
@@ -852,10 +927,10 @@ bool ASTJsonExporter::visit(TupleExpression const& _node)
 
 bool ASTJsonExporter::visit(UnaryOperation const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("prefix", _node.isPrefixOperation()),
 		std::make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		std::make_pair("subExpression", toJson(_node.subExpression()))
+		std::make_pair("subExpression", child(_node.subExpression()))
 	};
 	// NOTE: This annotation is guaranteed to be set but only if we didn't stop at the parsing stage.
 	if (_node.annotation().userDefinedFunction.set() && *_node.annotation().userDefinedFunction != nullptr)
@@ -867,10 +942,10 @@ bool ASTJsonExporter::visit(UnaryOperation const& _node)
 
 bool ASTJsonExporter::visit(BinaryOperation const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("operator", TokenTraits::toString(_node.getOperator())),
-		std::make_pair("leftExpression", toJson(_node.leftExpression())),
-		std::make_pair("rightExpression", toJson(_node.rightExpression())),
+		std::make_pair("leftExpression", child(_node.leftExpression())),
+		std::make_pair("rightExpression", child(_node.rightExpression())),
 		std::make_pair("commonType", typePointerToJson(_node.annotation().commonType)),
 	};
 	// NOTE: This annotation is guaranteed to be set but only if we didn't stop at the parsing stage.
@@ -886,11 +961,11 @@ bool ASTJsonExporter::visit(FunctionCall const& _node)
 	Json::Value names(Json::arrayValue);
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("expression", toJson(_node.expression())),
+	Attributes attributes = {
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("names", std::move(names)),
 		std::make_pair("nameLocations", sourceLocationsToJson(_node.nameLocations())),
-		std::make_pair("arguments", toJson(_node.arguments())),
+		std::make_pair("arguments", children(_node.arguments())),
 		std::make_pair("tryCall", _node.annotation().tryCall)
 	};
 
@@ -911,10 +986,10 @@ bool ASTJsonExporter::visit(FunctionCallOptions const& _node)
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
 
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("expression", toJson(_node.expression())),
+	Attributes attributes = {
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("names", std::move(names)),
-		std::make_pair("options", toJson(_node.options())),
+		std::make_pair("options", children(_node.options())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 
@@ -924,8 +999,8 @@ bool ASTJsonExporter::visit(FunctionCallOptions const& _node)
 
 bool ASTJsonExporter::visit(NewExpression const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("typeName", toJson(_node.typeName()))
+	Attributes attributes = {
+		std::make_pair("typeName", child(_node.typeName()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "NewExpression", std::move(attributes));
@@ -934,10 +1009,10 @@ bool ASTJsonExporter::visit(NewExpression const& _node)
 
 bool ASTJsonExporter::visit(MemberAccess const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("memberName", _node.memberName()),
 		std::make_pair("memberLocation", Json::Value(sourceLocationToString(_node.memberLocation()))),
-		std::make_pair("expression", toJson(_node.expression())),
+		std::make_pair("expression", child(_node.expression())),
 		std::make_pair("referencedDeclaration", idOrNull(_node.annotation().referencedDeclaration)),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
@@ -947,9 +1022,9 @@ bool ASTJsonExporter::visit(MemberAccess const& _node)
 
 bool ASTJsonExporter::visit(IndexAccess const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("baseExpression", toJson(_node.baseExpression())),
-		std::make_pair("indexExpression", toJsonOrNull(_node.indexExpression())),
+	Attributes attributes = {
+		std::make_pair("baseExpression", child(_node.baseExpression())),
+		std::make_pair("indexExpression", child(_node.indexExpression())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexAccess", std::move(attributes));
@@ -958,10 +1033,10 @@ bool ASTJsonExporter::visit(IndexAccess const& _node)
 
 bool ASTJsonExporter::visit(IndexRangeAccess const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("baseExpression", toJson(_node.baseExpression())),
-		std::make_pair("startExpression", toJsonOrNull(_node.startExpression())),
-		std::make_pair("endExpression", toJsonOrNull(_node.endExpression())),
+	Attributes attributes = {
+		std::make_pair("baseExpression", child(_node.baseExpression())),
+		std::make_pair("startExpression", child(_node.startExpression())),
+		std::make_pair("endExpression", child(_node.endExpression())),
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexRangeAccess", std::move(attributes));
@@ -985,8 +1060,8 @@ bool ASTJsonExporter::visit(Identifier const& _node)
 
 bool ASTJsonExporter::visit(ElementaryTypeNameExpression const& _node)
 {
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
-		std::make_pair("typeName", toJson(_node.type()))
+	Attributes attributes = {
+		std::make_pair("typeName", child(_node.type()))
 	};
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "ElementaryTypeNameExpression", std::move(attributes));
@@ -999,7 +1074,7 @@ bool ASTJsonExporter::visit(Literal const& _node)
 	if (!util::validateUTF8(_node.value()))
 		value = Json::nullValue;
 	Token subdenomination = Token(_node.subDenomination());
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("kind", literalTokenKind(_node.token())),
 		std::make_pair("value", value),
 		std::make_pair("hexValue", util::toHex(util::asBytes(_node.value()))),
@@ -1018,7 +1093,7 @@ bool ASTJsonExporter::visit(Literal const& _node)
 bool ASTJsonExporter::visit(StructuredDocumentation const& _node)
 {
 	Json::Value text{*_node.text()};
-	std::vector<std::pair<std::string, Json::Value>> attributes = {
+	Attributes attributes = {
 		std::make_pair("text", text)
 	};
 	setJsonNode(_node, "StructuredDocumentation", std::move(attributes));
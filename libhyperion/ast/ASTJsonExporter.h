@@ -32,9 +32,11 @@
 #include <libhyputil/JSON.h>
 
 #include <algorithm>
+#include <map>
 #include <optional>
 #include <ostream>
 #include <stack>
+#include <variant>
 #include <vector>
 
 namespace hyperion::langutil
@@ -60,6 +62,9 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format);
+	/// Writes the json representation of the AST to @a _writer while traversing it, without
+	/// building the representation of the whole tree in memory.
+	void print(util::JsonOutput& _writer, ASTNode const& _node);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -130,16 +135,49 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Child nodes in the value of an attribute: a single node, which may be null, or an array of nodes.
+	/// They are converted only when the attribute is output, so that print() can write them directly.
+	struct ChildNodes
+	{
+		std::vector<ASTNode const*> nodes;
+		bool isArray = false;
+	};
+	using AttributeValue = std::variant<Json::Value, ChildNodes>;
+	using Attributes = std::vector<std::pair<std::string, AttributeValue>>;
+
+	static ChildNodes child(ASTNode const* _node) { return {{_node}, false}; }
+	static ChildNodes child(ASTNode const& _node) { return child(&_node); }
+	template <class T>
+	static ChildNodes child(ASTPointer<T> const& _node) { return child(_node.get()); }
+	template <class T>
+	static ChildNodes children(std::vector<ASTPointer<T>> const& _nodes)
+	{
+		ChildNodes result{{}, true};
+		for (auto const& node: _nodes)
+			result.nodes.push_back(node.get());
+		return result;
+	}
+	template <class T>
+	static AttributeValue children(std::vector<ASTPointer<T>> const* _nodes)
+	{
+		if (_nodes)
+			return children(*_nodes);
+		return Json::nullValue;
+	}
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::initializer_list<std::pair<std::string, Json::Value>>&& _attributes
+		std::initializer_list<std::pair<std::string, AttributeValue>>&& _attributes
 	);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::vector<std::pair<std::string, Json::Value>>&& _attributes
+		Attributes&& _attributes
 	);
+	/// Writes the members of a node to m_writer, in the order of their names.
+	void writeJsonNode(std::map<std::string, AttributeValue>&& _members);
+	Json::Value toJson(ChildNodes const& _children);
 	/// Maps source location to an index, if source is valid and a mapping does exist, otherwise returns std::nullopt.
 	std::optional<size_t> sourceIndexFromLocation(langutil::SourceLocation const& _location) const;
 	std::string sourceLocationToString(langutil::SourceLocation const& _location) const;
@@ -149,10 +187,6 @@ private:
 	{
 		return _pt ? Json::Value(nodeId(*_pt)) : Json::nullValue;
 	}
-	Json::Value toJsonOrNull(ASTNode const* _node)
-	{
-		return _node ? toJson(*_node) : Json::nullValue;
-	}
 	Json::Value inlineAssemblyIdentifierToJson(std::pair<yul::Identifier const* , InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const;
 	static std::string location(VariableDeclaration::Location _location);
 	static std::string contractKind(ContractKind _kind);
@@ -186,7 +220,7 @@ private:
 	static Json::Value typePointerToJson(Type const* _tp, bool _withoutDataLocation = false);
 	static Json::Value typePointerToJson(std::optional<FuncCallArguments> const& _tps);
 	void appendExpressionAttributes(
-		std::vector<std::pair<std::string, Json::Value>> &_attributes,
+		Attributes& _attributes,
 		ExpressionAnnotation const& _annotation
 	);
 	static void appendMove(Json::Value& _array, Json::Value&& _value)
@@ -198,6 +232,8 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// Target of print(), nodes are converted to m_currentValue instead if not set.
+	util::JsonOutput* m_writer = nullptr;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
@@ -25,22 +25,22 @@ using namespace hyperion;
 using namespace hyperion::frontend;
 using namespace hyperion::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
+thread_local BoolType const TypeProvider::m_boolean{};
+thread_local InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
 
 /// The string and bytes unique_ptrs are initialized when they are first used because
 /// they rely on `byte` being available which we cannot guarantee in the static init context.
-std::unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-std::unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-std::unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-std::unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-std::unique_ptr<ArrayType> TypeProvider::m_stringMemory;
+thread_local std::unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
+thread_local std::unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
+thread_local std::unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
+thread_local std::unique_ptr<ArrayType> TypeProvider::m_stringStorage;
+thread_local std::unique_ptr<ArrayType> TypeProvider::m_stringMemory;
 
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
+thread_local TupleType const TypeProvider::m_emptyTuple{};
+thread_local AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
+thread_local AddressType const TypeProvider::m_address{StateMutability::NonPayable};
 
-std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
+thread_local std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
 	{std::make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
 	{std::make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
 	{std::make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
@@ -75,7 +75,7 @@ std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
 	{std::make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
 }};
 
-std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
+thread_local std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
 	{std::make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
 	{std::make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
 	{std::make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
@@ -110,7 +110,7 @@ std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
 	{std::make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
 }};
 
-std::array<std::unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
+thread_local std::array<std::unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
 	{std::make_unique<FixedBytesType>(1)},
 	{std::make_unique<FixedBytesType>(2)},
 	{std::make_unique<FixedBytesType>(3)},
@@ -145,7 +145,7 @@ std::array<std::unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
 	{std::make_unique<FixedBytesType>(32)}
 }};
 
-std::array<std::unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
+thread_local std::array<std::unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
 	{std::make_unique<MagicType>(MagicType::Kind::Block)},
 	{std::make_unique<MagicType>(MagicType::Kind::Message)},
 	{std::make_unique<MagicType>(MagicType::Kind::Transaction)},
@@ -85,7 +85,7 @@ struct CopyTranslate: public yul::ASTCopier
 		if (m_dialect.builtin(_name))
 			return _name;
 		else
-			return yul::YulString{"usr$" + _name.str()};
+			return yul::YulString{"usr$" + std::string(_name.str())};
 	}
 
 	yul::Identifier translate(yul::Identifier const& _identifier) override
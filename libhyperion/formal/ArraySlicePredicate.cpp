@@ -25,7 +25,7 @@ using namespace hyperion::smtutil;
 using namespace hyperion::frontend;
 using namespace hyperion::frontend::smt;
 
-std::map<std::string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
+thread_local std::map<std::string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
 
 std::pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(SortPointer _sort, EncodingContext& _context)
 {
@@ -55,8 +55,8 @@ struct ArraySlicePredicate
 	static void reset() { m_slicePredicates.clear(); }
 
 private:
-	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// Maps a unique sort name to its slice data, per thread.
+	static thread_local std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
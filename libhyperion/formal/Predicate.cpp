@@ -37,7 +37,7 @@ using namespace hyperion::smtutil;
 using namespace hyperion::frontend;
 using namespace hyperion::frontend::smt;
 
-std::map<std::string, Predicate> Predicate::m_predicates;
+thread_local std::map<std::string, Predicate> Predicate::m_predicates;
 
 Predicate const* Predicate::create(
 	SortPointer _sort,
@@ -213,8 +213,8 @@ private:
 	ContractDefinition const* m_contractContext = nullptr;
 
 	/// Maps the name of the predicate to the actual Predicate.
-	/// Used in counterexample generation.
-	static std::map<std::string, Predicate> m_predicates;
+	/// Used in counterexample generation. Kept per thread like the types of the TypeProvider.
+	static thread_local std::map<std::string, Predicate> m_predicates;
 
 	/// The scope stack when the predicate was created.
 	/// Used to identify the subset of variables in scope.
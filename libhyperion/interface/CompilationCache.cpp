@@ -0,0 +1,180 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyperion/interface/CompilationCache.h>
+
+#include <libhyputil/CommonIO.h>
+#include <libhyputil/Exceptions.h>
+#include <libhyputil/JSON.h>
+
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+using namespace hyperion;
+using namespace hyperion::frontend;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+std::string const c_entryExtension = ".json";
+}
+
+CompilationCache::CompilationCache(fs::path _directory, size_t _sizeLimit):
+	m_directory(std::move(_directory)),
+	m_sizeLimit(_sizeLimit)
+{
+	// NOTE: create_directories() raises an exception for paths like '.', so use an absolute path.
+	m_directory = fs::absolute(m_directory);
+	fs::create_directories(m_directory);
+}
+
+std::optional<Json::Value> CompilationCache::load(util::h256 const& _key)
+{
+	fs::path path = entryPath(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+	{
+		count(&Statistics::misses);
+		return std::nullopt;
+	}
+
+	Json::Value entry;
+	std::string contents;
+	try
+	{
+		contents = util::readFileAsString(path);
+	}
+	catch (util::FileNotFound const&)
+	{
+		// Concurrently evicted by another process.
+	}
+	if (contents.empty() || !util::jsonParseStrict(contents, entry) || !entry.isObject())
+	{
+		count(&Statistics::misses);
+		return std::nullopt;
+	}
+
+	// Mark the entry as recently used. Eviction is based on the modification time.
+	fs::last_write_time(path, std::time(nullptr), error);
+	count(&Statistics::hits);
+	return entry;
+}
+
+void CompilationCache::store(util::h256 const& _key, Json::Value const& _entry)
+{
+	fs::path path = entryPath(_key);
+	fs::path temporaryPath = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	std::string const contents = util::jsonCompactPrint(_entry);
+	{
+		std::ofstream file(temporaryPath.string(), std::ios::binary);
+		file << contents;
+		// Closing flushes the stream, so that a short write is detected as well.
+		file.close();
+		if (!file)
+		{
+			boost::system::error_code error;
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+
+	boost::system::error_code error;
+	fs::rename(temporaryPath, path, error);
+	if (error)
+	{
+		fs::remove(temporaryPath, error);
+		return;
+	}
+	count(&Statistics::stores);
+	if (grow(contents.size()))
+		evict(path);
+}
+
+void CompilationCache::count(size_t Statistics::* _counter)
+{
+	std::lock_guard<std::mutex> lock(m_statisticsMutex);
+	++(m_statistics.*_counter);
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + c_entryExtension);
+}
+
+bool CompilationCache::grow(uintmax_t _size)
+{
+	std::lock_guard<std::mutex> lock(m_sizeMutex);
+	if (!m_estimatedSize || ++m_storesSinceScan >= RescanInterval)
+		return true;
+	*m_estimatedSize += _size;
+	return *m_estimatedSize > m_sizeLimit;
+}
+
+void CompilationCache::evict(fs::path const& _keep)
+{
+	count(&Statistics::scans);
+	struct Entry
+	{
+		fs::path path;
+		std::time_t lastUsed;
+		uintmax_t size;
+	};
+	std::vector<Entry> entries;
+	uintmax_t totalSize = 0;
+
+	boost::system::error_code error;
+	for (fs::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error))
+	{
+		fs::path const& path = it->path();
+		if (path.extension() != c_entryExtension)
+			continue;
+		boost::system::error_code entryError;
+		uintmax_t size = fs::file_size(path, entryError);
+		std::time_t lastUsed = fs::last_write_time(path, entryError);
+		if (entryError)
+			continue;
+		totalSize += size;
+		if (path != _keep)
+			entries.push_back({path, lastUsed, size});
+	}
+
+	if (totalSize > m_sizeLimit)
+	{
+		std::sort(entries.begin(), entries.end(), [](Entry const& _a, Entry const& _b) {
+			return std::tie(_a.lastUsed, _a.path) < std::tie(_b.lastUsed, _b.path);
+		});
+		for (Entry const& entry: entries)
+		{
+			if (totalSize <= m_sizeLimit)
+				break;
+			if (fs::remove(entry.path, error))
+				count(&Statistics::evictions);
+			totalSize -= entry.size;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_sizeMutex);
+	m_estimatedSize = totalSize;
+	m_storesSinceScan = 0;
+}
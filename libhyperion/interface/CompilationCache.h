@@ -0,0 +1,105 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent, content-addressed store for compilation artifacts.
+ */
+
+#pragma once
+
+#include <libhyputil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <mutex>
+#include <optional>
+
+namespace hyperion::frontend
+{
+
+/**
+ * Directory of cache entries, each of which is a JSON file named after the hash of everything
+ * that determines its contents. Entries can therefore never become stale, only unused.
+ *
+ * Entries are written to a temporary file and renamed into place, so that processes sharing
+ * the directory never observe partially written entries. Once the total size exceeds the limit,
+ * the least recently used entries are removed. Failing to read or write an entry is treated
+ * like a cache miss and never fails the compilation.
+ *
+ * A single instance can be shared by concurrent compilations.
+ */
+class CompilationCache
+{
+public:
+	struct Statistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t stores = 0;
+		size_t evictions = 0;
+		/// Number of times the size of the whole directory was determined.
+		size_t scans = 0;
+	};
+
+	/// Default limit for the total size of all entries in bytes.
+	static size_t constexpr DefaultSizeLimit = 1024 * 1024 * 1024;
+	/// Number of stores after which the size of the directory is determined again, to account
+	/// for entries written or removed by other processes.
+	static size_t constexpr RescanInterval = 256;
+
+	/// Creates the cache directory if it does not exist yet.
+	/// @throws boost::filesystem::filesystem_error if the directory cannot be created.
+	explicit CompilationCache(boost::filesystem::path _directory, size_t _sizeLimit = DefaultSizeLimit);
+
+	/// @returns the entry stored under @a _key or nullopt if there is no readable entry.
+	std::optional<Json::Value> load(util::h256 const& _key);
+
+	/// Stores @a _entry under @a _key, replacing any previous entry, and evicts entries
+	/// if the cache grew too large. The directory is only scanned if the estimated size
+	/// exceeds the limit or after RescanInterval stores.
+	void store(util::h256 const& _key, Json::Value const& _entry);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+	Statistics statistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsMutex);
+		return m_statistics;
+	}
+
+private:
+	void count(size_t Statistics::* _counter);
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Adds @a _size to the estimated size of all entries.
+	/// @returns true if the directory should be scanned for entries to evict.
+	bool grow(uintmax_t _size);
+	/// Removes the least recently used entries apart from @a _keep until the size limit is met.
+	void evict(boost::filesystem::path const& _keep);
+
+	boost::filesystem::path m_directory;
+	size_t m_sizeLimit;
+	mutable std::mutex m_statisticsMutex;
+	Statistics m_statistics;
+	std::mutex m_sizeMutex;
+	/// Size of all entries as of the last scan plus the sizes written since then.
+	/// Not set before the first scan.
+	std::optional<uintmax_t> m_estimatedSize;
+	size_t m_storesSinceScan = 0;
+};
+
+}
@@ -0,0 +1,330 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyperion/interface/CompilationServer.h>
+
+#include <libhyperion/interface/StandardCompiler.h>
+#include <libhyperion/lsp/Transport.h>
+
+#include <libyul/YulString.h>
+
+#include <libhyputil/JSON.h>
+
+#include <boost/system/error_code.hpp>
+
+#include <cstring>
+#include <future>
+#include <list>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace hyperion;
+using namespace hyperion::frontend;
+using namespace hyperion::lsp;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+double milliseconds(std::chrono::steady_clock::duration _duration)
+{
+	return std::chrono::duration<double, std::milli>(_duration).count();
+}
+
+/// Outputs containing a time report describe one particular compilation and are never retained.
+bool requestsTimeReport(Json::Value const& _input)
+{
+	return
+		_input.isObject() &&
+		_input.isMember("settings") &&
+		_input["settings"].isObject() &&
+		_input["settings"].get("timeReport", false) == true;
+}
+
+#if !defined(_WIN32)
+std::string lastSystemError()
+{
+	return std::strerror(errno);
+}
+#endif
+
+}
+
+CompilationServer::CompilationServer(
+	ReadCallback::Callback _readFile,
+	std::shared_ptr<CompilationCache> _cache,
+	size_t _yulStringLimit
+):
+	m_readFile(std::move(_readFile)),
+	m_cache(std::move(_cache)),
+	m_yulStringLimit(_yulStringLimit)
+{
+}
+
+void CompilationServer::listen(fs::path const& _socketPath)
+{
+#if defined(_WIN32)
+	(void)_socketPath;
+	hypThrow(CompilationServerError, "The compiler server is not supported on this platform.");
+#else
+	std::string const path = _socketPath.string();
+	sockaddr_un address{};
+	if (path.empty() || path.size() >= sizeof(address.sun_path))
+		hypThrow(CompilationServerError, "Invalid socket path \"" + path + "\".");
+	address.sun_family = AF_UNIX;
+	std::copy(path.begin(), path.end(), address.sun_path);
+
+	// Only remove sockets left behind by a previous server, never other files.
+	boost::system::error_code error;
+	if (fs::status(_socketPath, error).type() == fs::socket_file)
+		fs::remove(_socketPath, error);
+
+	int const listeningSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listeningSocket < 0)
+		hypThrow(CompilationServerError, "Could not create socket: " + lastSystemError());
+	if (
+		::bind(listeningSocket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 ||
+		::listen(listeningSocket, SOMAXCONN) != 0
+	)
+	{
+		std::string const message = "Could not listen on \"" + path + "\": " + lastSystemError();
+		::close(listeningSocket);
+		hypThrow(CompilationServerError, message);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_socketMutex);
+		m_listeningSocket = listeningSocket;
+	}
+
+	std::list<std::future<void>> connections;
+	std::string acceptError;
+	while (!m_shutdownRequested)
+	{
+		int const connection = ::accept(listeningSocket, nullptr, nullptr);
+		if (connection < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			// Requesting the shutdown closes the listening socket for reading, which makes accept fail.
+			if (!m_shutdownRequested)
+				acceptError = lastSystemError();
+			break;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_socketMutex);
+			if (m_shutdownRequested)
+				::shutdown(connection, SHUT_RD);
+			m_connections.insert(connection);
+		}
+		connections.remove_if([](std::future<void> const& _connection) {
+			return _connection.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		});
+		connections.emplace_back(std::async(std::launch::async, [this, connection]() {
+			try
+			{
+				SocketTransport transport(connection);
+				serve(transport);
+			}
+			catch (...)
+			{
+				// A failing connection must not take down the others.
+			}
+			std::lock_guard<std::mutex> lock(m_socketMutex);
+			m_connections.erase(connection);
+			::close(connection);
+		}));
+	}
+
+	for (std::future<void>& connection: connections)
+		connection.wait();
+
+	{
+		std::lock_guard<std::mutex> lock(m_socketMutex);
+		m_listeningSocket = -1;
+	}
+	::close(listeningSocket);
+	fs::remove(_socketPath, error);
+
+	if (!acceptError.empty())
+		hypThrow(CompilationServerError, "Could not accept connections: " + acceptError);
+#endif
+}
+
+void CompilationServer::serve(Transport& _transport)
+{
+	while (!_transport.closed())
+	{
+		std::optional<Json::Value> const message = _transport.receive();
+		if (!message)
+			// The transport already reported the error to the client.
+			continue;
+
+		Json::Value const id = (*message)["id"];
+		Json::Value const& method = (*message)["method"];
+		try
+		{
+			lspRequire(method.isString(), ErrorCode::InvalidParams, "Expected the method name as a string.");
+			if (method.asString() == "compile")
+			{
+				Json::Value const& params = (*message)["params"];
+				lspRequire(params.isObject(), ErrorCode::InvalidParams, "Expected a standard JSON input as parameters.");
+				_transport.reply(id, compile(params));
+			}
+			else if (method.asString() == "statistics")
+				_transport.reply(id, statistics());
+			else if (method.asString() == "shutdown")
+			{
+				requestShutdown();
+				_transport.reply(id, Json::nullValue);
+			}
+			else
+				lspRequire(false, ErrorCode::MethodNotFound, "Unknown method " + method.asString());
+		}
+		catch (RequestError const& _error)
+		{
+			std::string const* comment = _error.comment();
+			_transport.error(id, _error.code(), comment ? *comment : "");
+		}
+	}
+}
+
+Json::Value CompilationServer::compile(Json::Value const& _input)
+{
+	Clock::time_point const start = Clock::now();
+	std::string const key = util::jsonCompactPrint(_input);
+
+	{
+		std::lock_guard<std::mutex> lock(m_retainedOutputsMutex);
+		if (auto retained = m_retainedOutputIndex.find(key); retained != m_retainedOutputIndex.end())
+		{
+			m_retainedOutputs.splice(m_retainedOutputs.begin(), m_retainedOutputs, retained->second);
+			Json::Value output = retained->second->second;
+			recordRequest(Clock::now() - start, true, m_retainedOutputs.size());
+			return output;
+		}
+	}
+
+	// The output of requests that read files depends on more than the input and cannot be retained.
+	bool readCallbackUsed = false;
+	ReadCallback::Callback readFile;
+	if (m_readFile)
+		readFile = [&](std::string const& _kind, std::string const& _data) {
+			readCallbackUsed = true;
+			std::lock_guard<std::mutex> lock(m_readFileMutex);
+			return m_readFile(_kind, _data);
+		};
+
+	// Only holding the compilation mutex shared, so that requests of other connections are
+	// compiled concurrently.
+	Json::Value output;
+	{
+		std::shared_lock<std::shared_mutex> compilationLock(m_compilationMutex);
+		StandardCompiler compiler(std::move(readFile));
+		compiler.setCompilationCache(m_cache);
+		output = compiler.compile(_input);
+	}
+	releaseYulStrings();
+
+	std::lock_guard<std::mutex> lock(m_retainedOutputsMutex);
+	if (!readCallbackUsed && !requestsTimeReport(_input) && !m_retainedOutputIndex.count(key))
+	{
+		m_retainedOutputs.emplace_front(key, output);
+		m_retainedOutputIndex[key] = m_retainedOutputs.begin();
+		if (m_retainedOutputs.size() > MaxRetainedOutputs)
+		{
+			m_retainedOutputIndex.erase(m_retainedOutputs.back().first);
+			m_retainedOutputs.pop_back();
+		}
+	}
+
+	recordRequest(Clock::now() - start, false, m_retainedOutputs.size());
+	return output;
+}
+
+Json::Value CompilationServer::statistics() const
+{
+	std::lock_guard<std::mutex> lock(m_statisticsMutex);
+
+	Json::Value result{Json::objectValue};
+	result["compileRequests"] = Json::UInt64(m_compileRequests);
+	result["retainedOutputs"]["count"] = Json::UInt64(m_retainedOutputCount);
+	result["retainedOutputs"]["hits"] = Json::UInt64(m_retainedOutputHits);
+	result["latency"]["totalMilliseconds"] = milliseconds(m_totalLatency);
+	result["latency"]["maxMilliseconds"] = milliseconds(m_maxLatency);
+	result["latency"]["meanMilliseconds"] =
+		m_compileRequests > 0 ? milliseconds(m_totalLatency) / static_cast<double>(m_compileRequests) : 0.0;
+	result["yulStrings"]["arenaBytes"] = Json::UInt64(yul::YulStringRepository::instance().arenaCapacity());
+	result["yulStrings"]["resets"] = Json::UInt64(m_yulStringResets);
+	if (m_cache)
+	{
+		CompilationCache::Statistics const cacheStatistics = m_cache->statistics();
+		result["compilationCache"]["hits"] = Json::UInt64(cacheStatistics.hits);
+		result["compilationCache"]["misses"] = Json::UInt64(cacheStatistics.misses);
+		result["compilationCache"]["stores"] = Json::UInt64(cacheStatistics.stores);
+		result["compilationCache"]["evictions"] = Json::UInt64(cacheStatistics.evictions);
+	}
+	return result;
+}
+
+void CompilationServer::releaseYulStrings()
+{
+	if (yul::YulStringRepository::instance().arenaCapacity() <= m_yulStringLimit)
+		return;
+	// Compilations that are in progress still use the strings. The next request that finishes
+	// while no other one is in progress resets the repository instead.
+	std::unique_lock<std::shared_mutex> compilationLock(m_compilationMutex, std::try_to_lock);
+	if (!compilationLock.owns_lock() || yul::YulStringRepository::instance().arenaCapacity() <= m_yulStringLimit)
+		return;
+	yul::YulStringRepository::reset();
+
+	std::lock_guard<std::mutex> lock(m_statisticsMutex);
+	++m_yulStringResets;
+}
+
+void CompilationServer::recordRequest(Clock::duration _latency, bool _retained, size_t _retainedOutputCount)
+{
+	std::lock_guard<std::mutex> lock(m_statisticsMutex);
+	++m_compileRequests;
+	if (_retained)
+		++m_retainedOutputHits;
+	m_retainedOutputCount = _retainedOutputCount;
+	m_totalLatency += _latency;
+	m_maxLatency = std::max(m_maxLatency, _latency);
+}
+
+void CompilationServer::requestShutdown()
+{
+	m_shutdownRequested = true;
+
+#if !defined(_WIN32)
+	// Wakes up the accept loop and ends the connections once their pending requests are answered.
+	std::lock_guard<std::mutex> lock(m_socketMutex);
+	if (m_listeningSocket >= 0)
+		::shutdown(m_listeningSocket, SHUT_RDWR);
+	for (int connection: m_connections)
+		::shutdown(connection, SHUT_RD);
+#endif
+}
@@ -0,0 +1,147 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Long-running compiler process answering standard JSON requests over a socket.
+ */
+
+#pragma once
+
+#include <libhyperion/interface/CompilationCache.h>
+#include <libhyperion/interface/ReadFile.h>
+
+#include <libhyputil/Exceptions.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+
+namespace hyperion::lsp
+{
+class Transport;
+}
+
+namespace hyperion::frontend
+{
+
+struct CompilationServerError: virtual util::Exception {};
+
+/**
+ * Compiler server that receives JSON-RPC messages (using the framing of the language server)
+ * and supports the methods
+ *  - "compile": params are a standard JSON input, the result is the standard JSON output,
+ *  - "statistics": the result contains request counts, latencies and cache statistics,
+ *  - "shutdown": stops accepting new connections.
+ *
+ * Every connection is served by its own thread and requests of different connections are
+ * compiled concurrently. The state the compiler keeps outside of its instances is either
+ * thread-local (e.g. the TypeProvider) or synchronised (e.g. the YulString repository).
+ * Requests of a single connection are answered one after another, and a compilation can
+ * use several threads via the "parallelism" setting.
+ *
+ * The server stays warm between requests: outputs of self-contained requests, i.e. requests
+ * that did not need the read callback, are retained in memory and returned directly when the
+ * same input is sent again. Contracts of other requests can be served by the optional
+ * compilation cache. Parsed ASTs are not kept, because their node IDs would depend on the
+ * requests compiled before and change the output.
+ *
+ * The YulString repository is shared by all compilations and only grows. Once it exceeds a
+ * limit, it is reset after a request at a moment no other compilation is in progress.
+ */
+class CompilationServer
+{
+public:
+	/// Maximum number of retained outputs of self-contained requests.
+	static size_t constexpr MaxRetainedOutputs = 64;
+	/// Default size of the arenas of the YulString repository in bytes above which it is reset.
+	static size_t constexpr DefaultYulStringLimit = 256 * 1024 * 1024;
+
+	explicit CompilationServer(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<CompilationCache> _cache = {},
+		size_t _yulStringLimit = DefaultYulStringLimit
+	);
+
+	/// Listens on the Unix domain socket at @a _socketPath and serves every incoming connection
+	/// until a client requests the shutdown. Replaces a stale socket file at that path.
+	/// @throws CompilationServerError if the socket cannot be set up.
+	void listen(boost::filesystem::path const& _socketPath);
+
+	/// Answers the requests received via @a _transport until the transport is closed.
+	void serve(lsp::Transport& _transport);
+
+	/// Compiles the standard JSON input @a _input, or looks up the retained output for it.
+	Json::Value compile(Json::Value const& _input);
+
+	/// @returns request counts, latencies and cache statistics of the server.
+	Json::Value statistics() const;
+
+	bool shutdownRequested() const noexcept { return m_shutdownRequested; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/// Resets the YulString repository if it exceeds the limit and no compilation is in progress.
+	void releaseYulStrings();
+	/// Updates the statistics after a compile request.
+	void recordRequest(Clock::duration _latency, bool _retained, size_t _retainedOutputCount);
+	void requestShutdown();
+
+	ReadCallback::Callback m_readFile;
+	/// Guards the read callback, which is shared by all compilations and need not be thread-safe.
+	std::mutex m_readFileMutex;
+	std::shared_ptr<CompilationCache> m_cache;
+	size_t m_yulStringLimit;
+
+	/// Held shared by every compilation and exclusively while resetting the YulString repository.
+	std::shared_mutex m_compilationMutex;
+
+	/// Guards the retained outputs.
+	std::mutex m_retainedOutputsMutex;
+	/// Outputs of self-contained requests, keyed by the compact JSON form of their input,
+	/// ordered from the most to the least recently used.
+	std::list<std::pair<std::string, Json::Value>> m_retainedOutputs;
+	std::map<std::string, decltype(m_retainedOutputs)::iterator> m_retainedOutputIndex;
+
+	/// Guards the statistics, which are updated after each request.
+	mutable std::mutex m_statisticsMutex;
+	size_t m_compileRequests = 0;
+	size_t m_retainedOutputHits = 0;
+	size_t m_retainedOutputCount = 0;
+	size_t m_yulStringResets = 0;
+	Clock::duration m_totalLatency{};
+	Clock::duration m_maxLatency{};
+
+	std::atomic<bool> m_shutdownRequested = false;
+	/// Guards the socket file descriptors below, which are shut down when the shutdown is requested.
+	std::mutex m_socketMutex;
+	/// Listening socket, -1 if the server is not listening.
+	int m_listeningSocket = -1;
+	std::set<int> m_connections;
+};
+
+}
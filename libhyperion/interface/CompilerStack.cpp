@@ -45,11 +45,13 @@
 #include <libhyperion/analysis/ImmutableValidator.h>
 
 #include <libhyperion/ast/AST.h>
+#include <libhyperion/ast/ASTVisitor.h>
 #include <libhyperion/ast/TypeProvider.h>
 #include <libhyperion/ast/ASTJsonImporter.h>
 #include <libhyperion/codegen/Compiler.h>
 #include <libhyperion/formal/ModelChecker.h>
 #include <libhyperion/interface/ABI.h>
+#include <libhyperion/interface/CompilationCache.h>
 #include <libhyperion/interface/Natspec.h>
 #include <libhyperion/interface/GasEstimator.h>
 #include <libhyperion/interface/StorageLayout.h>
@@ -81,6 +83,9 @@
 #include <libhyputil/JSON.h>
 #include <libhyputil/Algorithms.h>
 #include <libhyputil/FunctionSelector.h>
+#include <libhyputil/Keccak256.h>
+#include <libhyputil/Numeric.h>
+#include <libhyputil/ThreadPool.h>
 
 #include <json/json.h>
 
@@ -105,14 +110,36 @@ using namespace std::string_literals;
 
 using hyperion::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
+static thread_local int g_compilerStackCounts = 0;
+
+namespace
+{
+
+/// Removes the results of a previous analysis from all nodes and determines the largest node ID.
+class AnalysisRemover: public ASTVisitor
+{
+public:
+	int64_t lastNodeID() const { return m_lastNodeID; }
+
+private:
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.clearAnalysis();
+		m_lastNodeID = std::max(m_lastNodeID, _node.id());
+		return true;
+	}
+
+	int64_t m_lastNodeID = 0;
+};
+
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
+	// Because TypeProvider is currently a per-thread singleton API, we must ensure that
+	// no more than one entity per thread is actually using it at a time.
 	hypAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
 }
@@ -227,6 +254,21 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	if (_parallelism == 0)
+		hypThrow(CompilerError, "Parallelism must be at least one.");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::enableTimeReport(bool _enable)
+{
+	if (!_enable)
+		m_timeReport.reset();
+	else if (!m_timeReport)
+		m_timeReport = std::make_unique<util::TimeReport>();
+}
+
 void CompilerStack::setQRVMVersion(langutil::QRVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -302,6 +344,7 @@ void CompilerStack::reset(bool _keepSettings)
 {
 	m_stackState = Empty;
 	m_sources.clear();
+	m_parsedSources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -312,6 +355,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_qrvmVersion = langutil::QRVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_parallelism = 1;
+		m_compilationCache.reset();
+		m_timeReport.reset();
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -324,9 +370,23 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	if (m_timeReport)
+		m_timeReport->clear();
 	TypeProvider::reset();
 }
 
+void CompilerStack::resetKeepingParsedSources(bool _keepSettings)
+{
+	std::map<std::string, Source> parsedSources;
+	for (auto& [path, source]: m_sources)
+		if (source.ast && source.parsedCleanly)
+			parsedSources.emplace(path, std::move(source));
+	QRVMVersion const qrvmVersion = m_qrvmVersion;
+	reset(_keepSettings);
+	m_parsedSources = std::move(parsedSources);
+	m_parsedSourcesQRVMVersion = qrvmVersion;
+}
+
 void CompilerStack::setSources(StringMap _sources)
 {
 	if (m_stackState == SourcesSet)
@@ -343,59 +403,48 @@ bool CompilerStack::parse()
 	if (m_stackState != SourcesSet)
 		hypThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), "");
+	util::TimeReport::ScopedPhase phase("parsing");
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_qrvmVersion};
-
 	std::vector<std::string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// The kept ASTs are analysed from scratch and the nodes of the sources parsed now get IDs
+	// after the ones of the kept ASTs.
+	if (m_qrvmVersion != m_parsedSourcesQRVMVersion)
+		m_parsedSources.clear();
+	AnalysisRemover analysisRemover;
+	for (auto const& source: m_parsedSources | ranges::views::values)
+		source.ast->accept(analysisRemover);
+	int64_t const reusedNodeIDs = analysisRemover.lastNodeID();
+
+	if (m_parallelism > 1)
+		parseInParallel(sourcesToParse, reusedNodeIDs);
+	else
 	{
-		std::string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
-		if (!source.ast)
-			hypAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		Parser parser{m_errorReporter, m_qrvmVersion, reusedNodeIDs > 0};
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+			Source& source = m_sources[sourcesToParse[i]];
+			ASTPointer<SourceUnit> ast = takeParsedSource(sourcesToParse[i]);
+			if (ast)
+				source.parsedCleanly = true;
+			else
 			{
-				hypAssert(!import->path().empty(), "Import path cannot be empty.");
-				// Check whether the import directive is for the standard library,
-				// and if yes, add specified file to source units to be parsed.
-				auto it = stdlib::sources.find(import->path());
-				if (it != stdlib::sources.end())
-				{
-					auto [name, content] = *it;
-					m_sources[name].charStream = std::make_unique<CharStream>(content, name);
-					sourcesToParse.push_back(name);
-				}
-
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				import->annotation().absolutePath = applyRemapping(util::absolutePath(
-					import->path(),
-					path
-				), path);
+				size_t const errorCount = m_errorReporter.errors().size();
+				ast = parser.parse(*source.charStream);
+				source.parsedCleanly = m_errorReporter.errors().size() == errorCount;
+				if (reusedNodeIDs > 0)
+					parser.shiftNodeIDs(reusedNodeIDs);
 			}
-
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
-				{
-					std::string const& newPath = newSource.first;
-					std::string const& newContents = newSource.second;
-					m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
-					sourcesToParse.push_back(newPath);
-				}
+			storeParsedSource(sourcesToParse, i, std::move(ast));
 		}
 	}
+	m_parsedSources.clear();
 
 	if (Error::containsErrors(m_errorReporter.errors()))
 		return false;
@@ -405,10 +454,159 @@ bool CompilerStack::parse()
 	return true;
 }
 
+void CompilerStack::parseInParallel(std::vector<std::string>& _sourcesToParse, int64_t _reusedNodeIDs)
+{
+	struct ParseJob
+	{
+		ParseJob(QRVMVersion _qrvmVersion, std::shared_ptr<CharStream> _charStream):
+			charStream(std::move(_charStream)),
+			parser(errorReporter, _qrvmVersion, true)
+		{}
+
+		std::shared_ptr<CharStream> charStream;
+		ErrorList errors;
+		ErrorReporter errorReporter{errors};
+		Parser parser;
+		ASTPointer<SourceUnit> ast;
+	};
+
+	util::ThreadPool pool(m_parallelism - 1);
+	int64_t lastNodeID = _reusedNodeIDs;
+	// The effect of the limits on the number of errors depends on the order in which the errors
+	// are reported. Once a limit could be reached, the remaining sources are parsed one by one.
+	bool parseSerially = false;
+	for (size_t begin = 0; begin < _sourcesToParse.size();)
+	{
+		// All sources that are known at this point are parsed at the same time, except that
+		// a source that is imported repeatedly (which is only possible for the standard library)
+		// has to wait for the next round.
+		std::set<std::string> paths;
+		size_t end = begin;
+		while (end < _sourcesToParse.size() && paths.insert(_sourcesToParse[end]).second)
+			++end;
+
+		std::vector<ASTPointer<SourceUnit>> reusedASTs;
+		for (size_t i = begin; i < end; ++i)
+			reusedASTs.emplace_back(takeParsedSource(_sourcesToParse[i]));
+
+		std::vector<std::unique_ptr<ParseJob>> jobs;
+		std::vector<std::exception_ptr> failures;
+		if (!parseSerially)
+		{
+			for (size_t i = begin; i < end; ++i)
+				jobs.emplace_back(std::make_unique<ParseJob>(m_qrvmVersion, m_sources.at(_sourcesToParse[i]).charStream));
+			failures = pool.parallelFor(jobs.size(), [&](size_t _index) {
+				if (!reusedASTs[_index])
+					jobs[_index]->ast = jobs[_index]->parser.parse(*jobs[_index]->charStream);
+			});
+		}
+
+		// The results are processed in the same order as in serial parsing, which also determines
+		// the sources to parse in the next round.
+		for (size_t i = begin; i < end; ++i)
+		{
+			Source& source = m_sources.at(_sourcesToParse[i]);
+			if (reusedASTs[i - begin])
+			{
+				source.parsedCleanly = true;
+				storeParsedSource(_sourcesToParse, i, std::move(reusedASTs[i - begin]));
+				continue;
+			}
+
+			if (!parseSerially)
+			{
+				if (failures[i - begin])
+					std::rethrow_exception(failures[i - begin]);
+				parseSerially = !m_errorReporter.appendWithinLimits(jobs[i - begin]->errors);
+			}
+
+			std::unique_ptr<Parser> serialParser;
+			if (parseSerially)
+				serialParser = std::make_unique<Parser>(m_errorReporter, m_qrvmVersion, true);
+			Parser& parser = serialParser ? *serialParser : jobs[i - begin]->parser;
+			size_t const errorCount = m_errorReporter.errors().size();
+			ASTPointer<SourceUnit> ast =
+				serialParser ?
+				serialParser->parse(*source.charStream) :
+				std::move(jobs[i - begin]->ast);
+			source.parsedCleanly =
+				serialParser ?
+				m_errorReporter.errors().size() == errorCount :
+				jobs[i - begin]->errors.empty();
+
+			// Renumber the nodes as if all sources had been parsed by a single parser.
+			parser.shiftNodeIDs(lastNodeID);
+			lastNodeID += parser.lastNodeID();
+			storeParsedSource(_sourcesToParse, i, std::move(ast));
+		}
+		begin = end;
+	}
+}
+
+void CompilerStack::storeParsedSource(std::vector<std::string>& _sourcesToParse, size_t _index, ASTPointer<SourceUnit> _ast)
+{
+	// Copied because _sourcesToParse grows below.
+	std::string const path = _sourcesToParse[_index];
+	Source& source = m_sources[path];
+	source.ast = std::move(_ast);
+	if (!source.ast)
+	{
+		hypAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
+		return;
+	}
+
+	source.ast->annotation().path = path;
+
+	for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+	{
+		hypAssert(!import->path().empty(), "Import path cannot be empty.");
+		// Check whether the import directive is for the standard library,
+		// and if yes, add specified file to source units to be parsed.
+		auto it = stdlib::sources.find(import->path());
+		if (it != stdlib::sources.end())
+		{
+			auto [name, content] = *it;
+			m_sources[name].charStream = std::make_unique<CharStream>(content, name);
+			_sourcesToParse.push_back(name);
+		}
+
+		// The current value of `path` is the absolute path as seen from this source file.
+		// We first have to apply remappings before we can store the actual absolute path
+		// as seen globally.
+		import->annotation().absolutePath = applyRemapping(util::absolutePath(
+			import->path(),
+			path
+		), path);
+	}
+
+	if (m_stopAfter >= ParsedAndImported)
+		for (auto const& newSource: loadMissingSources(*source.ast))
+		{
+			std::string const& newPath = newSource.first;
+			std::string const& newContents = newSource.second;
+			m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
+			_sourcesToParse.push_back(newPath);
+		}
+}
+
+ASTPointer<SourceUnit> CompilerStack::takeParsedSource(std::string const& _path)
+{
+	auto it = m_parsedSources.find(_path);
+	if (it == m_parsedSources.end())
+		return nullptr;
+	ASTPointer<SourceUnit> ast;
+	if (it->second.charStream->source() == m_sources.at(_path).charStream->source())
+		ast = std::move(it->second.ast);
+	m_parsedSources.erase(it);
+	return ast;
+}
+
 void CompilerStack::importASTs(std::map<std::string, Json::Value> const& _sources)
 {
 	if (m_stackState != Empty)
 		hypThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), "");
+	util::TimeReport::ScopedPhase phase("astImport");
 	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_qrvmVersion).jsonToSourceUnit(_sources);
 	for (auto& src: reconstructedSources)
 	{
@@ -433,9 +631,13 @@ bool CompilerStack::analyze()
 	if (m_stackState != ParsedAndImported)
 		hypThrow(CompilerError, "Must call analyze only after parsing was successful.");
 
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), "");
+	util::TimeReport::PhaseSequence phases;
+	phases.next("importResolution");
 	if (!resolveImports())
 		return false;
 
+	phases.next("analysis/Scoper");
 	for (Source const* source: m_sourceOrder)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
@@ -446,11 +648,13 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalHyperion = !m_sourceOrder.empty() && m_sourceOrder.front()->ast->experimentalHyperion();
 
+		phases.next("analysis/SyntaxChecker");
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
+		phases.next("analysis/NameAndTypeResolver");
 		m_globalContext = std::make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_qrvmVersion, m_errorReporter);
@@ -467,16 +671,21 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
+		phases.next("analysis/DocStringTagParser");
 		DocStringTagParser docStringTagParser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 				noErrors = false;
 
 		// Requires DocStringTagParser
+		phases.next("analysis/NameAndTypeResolver");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		// The remaining passes are measured individually.
+		phases.end();
+
 		if (experimentalHyperion)
 		{
 			if (!analyzeExperimental())
@@ -504,12 +713,15 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
+	util::TimeReport::PhaseSequence phases;
+	phases.next("analysis/DeclarationTypeChecker");
 	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_qrvmVersion);
 	for (Source const* source: m_sourceOrder)
 		if (source->ast && !declarationTypeChecker.check(*source->ast))
 			return false;
 
 	// Requires DeclarationTypeChecker to have run
+	phases.next("analysis/DocStringTagParser");
 	DocStringTagParser docStringTagParser(m_errorReporter);
 	for (Source const* source: m_sourceOrder)
 		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
@@ -519,6 +731,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// contract or function level.
 	// This also calculates whether a contract is abstract, which is needed by the
 	// type checker.
+	phases.next("analysis/ContractLevelChecker");
 	ContractLevelChecker contractLevelChecker(m_errorReporter);
 
 	for (Source const* source: m_sourceOrder)
@@ -532,6 +745,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	//
 	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 	// which is only done one step later.
+	phases.next("analysis/TypeChecker");
 	TypeChecker typeChecker(m_qrvmVersion, m_errorReporter);
 	for (Source const* source: m_sourceOrder)
 		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
@@ -540,6 +754,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Requires ContractLevelChecker and TypeChecker
+		phases.next("analysis/DocStringAnalyser");
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
@@ -549,6 +764,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks that can only be done when all types of all AST nodes are known.
+		phases.next("analysis/PostTypeChecker");
 		PostTypeChecker postTypeChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !postTypeChecker.check(*source->ast))
@@ -560,29 +776,37 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		phases.next("analysis/FunctionCallGraph");
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
+	{
+		phases.next("analysis/PostTypeContractLevelChecker");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
+	{
+		phases.next("analysis/ImmutableValidator");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
+		phases.next("analysis/ControlFlowAnalyzer");
 		CFG cfg(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !cfg.constructFlow(*source->ast))
@@ -602,6 +826,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks for common mistakes. Only generates warnings.
+		phases.next("analysis/StaticAnalyzer");
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !staticAnalyzer.analyze(*source->ast))
@@ -611,6 +836,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Check for state mutability in every function.
+		phases.next("analysis/ViewPureChecker");
 		std::vector<ASTPointer<ASTNode>> ast;
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
@@ -623,6 +849,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Run SMTChecker
+		phases.next("analysis/ModelChecker");
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 		if (ModelChecker::isPragmaPresent(allSources))
@@ -695,6 +922,7 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 bool CompilerStack::compile(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), "");
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze(_stopAfter))
 			return false;
@@ -703,65 +931,378 @@ bool CompilerStack::compile(State _stopAfter)
 		return true;
 
 	// Only compile contracts individually which have been requested.
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
-
+	std::vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	// Contracts restored from the cache are not compiled again.
+	std::map<ContractDefinition const*, util::h256> cacheKeys;
+	if (m_compilationCache)
+	{
+		util::TimeReport::ScopedPhase phase("compilationCacheLookup");
+		std::vector<ContractDefinition const*> uncachedContracts;
+		for (ContractDefinition const* contract: requestedContracts)
+		{
+			Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+			util::h256 key = compilationCacheKey(compiledContract);
+			if (!loadFromCompilationCache(compiledContract, key))
+			{
+				uncachedContracts.push_back(contract);
+				cacheKeys[contract] = key;
+			}
+		}
+		requestedContracts = std::move(uncachedContracts);
+	}
+	size_t const errorCountBeforeCodegen = m_errorReporter.errors().size();
+
+	if (m_parallelism > 1 && (m_viaIR || m_generateIR))
+	{
+		if (!compileInParallel(requestedContracts))
+			return false;
+	}
+	else
+	{
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: requestedContracts)
+			try
+			{
+				if (m_viaIR || m_generateIR)
+					generateIR(*contract);
+				if (m_generateQrvmBytecode)
 				{
-					try
-					{
-						if (m_viaIR || m_generateIR)
-							generateIR(*contract);
-						if (m_generateQrvmBytecode)
-						{
-							if (m_viaIR)
-								generateQRVMFromIR(*contract);
-							else
-							{
-								if (m_experimentalAnalysis)
-									hypThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
-							}
-						}
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
+					if (m_viaIR)
+						generateQRVMFromIR(*contract, m_errorReporter);
+					else
 					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							std::string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								fmt::format(
-									"Unimplemented feature error {} in {}",
-									(comment && !comment->empty()) ? ": " + *comment : "",
-									_unimplementedError.lineInfo()
-								)
-							);
-							return false;
-						}
-						else
-							throw;
+						if (m_experimentalAnalysis)
+							hypThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+						compileContract(*contract, otherCompilers);
 					}
 				}
+			}
+			catch (...)
+			{
+				reportCodeGenerationFailure(std::current_exception());
+				return false;
+			}
+	}
 	m_stackState = CompilationSuccessful;
+
+	// Entries do not contain diagnostics, so only code generated without any is cached.
+	if (m_errorReporter.errors().size() == errorCountBeforeCodegen)
+		for (auto const& [contract, key]: cacheKeys)
+			storeInCompilationCache(m_contracts.at(contract->fullyQualifiedName()), key);
+
 	this->link();
 	return true;
 }
 
+bool CompilerStack::compileInParallel(std::vector<ContractDefinition const*> const& _contracts)
+{
+	hypAssert(m_viaIR || m_generateIR);
+
+	// Contracts are processed in three phases. The first one generates the unoptimized IR on this
+	// thread, because code generation from the Hyperion AST is not thread-safe. The second one
+	// optimises the IR of all contracts concurrently and the third one assembles the contracts
+	// concurrently. Any diagnostics are collected per contract and reported at the end,
+	// stopping at the first failure just like the serial loop.
+	struct Compilation
+	{
+		langutil::ErrorList generationErrors;
+		std::exception_ptr generationFailure;
+		/// Contracts whose IR was generated for this contract, including dependencies.
+		std::vector<ContractDefinition const*> generatedContracts;
+		std::vector<std::exception_ptr> optimizationFailures;
+		langutil::ErrorList assemblyErrors;
+	};
+	std::vector<Compilation> compilations(_contracts.size());
+
+	std::vector<ContractDefinition const*> optimizationJobs;
+	size_t generatedCount = 0;
+	for (; generatedCount < _contracts.size(); ++generatedCount)
+	{
+		Compilation& compilation = compilations[generatedCount];
+		langutil::ErrorReporter errorReporter(compilation.generationErrors);
+		try
+		{
+			compilation.generatedContracts = generateUnoptimizedIR(*_contracts[generatedCount], errorReporter);
+		}
+		catch (...)
+		{
+			compilation.generationFailure = std::current_exception();
+			++generatedCount;
+			break;
+		}
+		optimizationJobs += compilation.generatedContracts;
+	}
+
+	// A contract is optimised in a later wave than the contracts it creates, so that it can
+	// reuse their optimised objects (see optimizeIR).
+	std::map<ContractDefinition const*, size_t> optimizationWaveOf;
+	std::vector<std::vector<size_t>> optimizationWaves;
+	for (size_t index = 0; index < optimizationJobs.size(); ++index)
+	{
+		size_t wave = 0;
+		for (auto const& [dependency, referencee]: optimizationJobs[index]->annotation().contractDependencies)
+			if (auto it = optimizationWaveOf.find(dependency); it != optimizationWaveOf.end())
+				wave = std::max(wave, it->second + 1);
+		optimizationWaveOf[optimizationJobs[index]] = wave;
+		if (optimizationWaves.size() <= wave)
+			optimizationWaves.resize(wave + 1);
+		optimizationWaves[wave].push_back(index);
+	}
+
+	util::ThreadPool pool(m_parallelism - 1);
+	std::vector<std::exception_ptr> optimizationFailures(optimizationJobs.size());
+	for (std::vector<size_t> const& wave: optimizationWaves)
+	{
+		std::vector<std::exception_ptr> waveFailures = pool.parallelFor(
+			wave.size(),
+			[&](size_t _index) { optimizeIR(*optimizationJobs[wave[_index]], &pool); }
+		);
+		for (size_t index = 0; index < wave.size(); ++index)
+			optimizationFailures[wave[index]] = waveFailures[index];
+	}
+
+	// Only contracts up to the first failure are assembled.
+	size_t optimizedCount = 0;
+	for (auto failure = optimizationFailures.begin(); optimizedCount < generatedCount; ++optimizedCount)
+	{
+		Compilation& compilation = compilations[optimizedCount];
+		auto end = failure + static_cast<std::ptrdiff_t>(compilation.generatedContracts.size());
+		compilation.optimizationFailures.assign(failure, end);
+		failure = end;
+		if (compilation.generationFailure || util::contains_if(
+			compilation.optimizationFailures,
+			[](std::exception_ptr const& _failure) { return !!_failure; }
+		))
+			break;
+	}
+
+	std::vector<std::exception_ptr> assemblyFailures;
+	if (m_generateQrvmBytecode && m_viaIR)
+		assemblyFailures = pool.parallelFor(optimizedCount, [&](size_t _index) {
+			langutil::ErrorReporter errorReporter(compilations[_index].assemblyErrors);
+			generateQRVMFromIR(*_contracts[_index], errorReporter, &pool);
+		});
+
+	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+	for (size_t index = 0; index < generatedCount; ++index)
+	{
+		Compilation const& compilation = compilations[index];
+		m_errorReporter.append(compilation.generationErrors);
+		std::vector<std::exception_ptr> failures{compilation.generationFailure};
+		failures += compilation.optimizationFailures;
+		for (std::exception_ptr const& failure: failures)
+			if (failure)
+			{
+				reportCodeGenerationFailure(failure);
+				return false;
+			}
+
+		if (!m_generateQrvmBytecode)
+			continue;
+		if (m_viaIR)
+		{
+			m_errorReporter.append(compilation.assemblyErrors);
+			if (assemblyFailures[index])
+			{
+				reportCodeGenerationFailure(assemblyFailures[index]);
+				return false;
+			}
+		}
+		else
+			try
+			{
+				// Legacy code generation is not thread-safe and runs here.
+				if (m_experimentalAnalysis)
+					hypThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+				compileContract(*_contracts[index], otherCompilers);
+			}
+			catch (...)
+			{
+				reportCodeGenerationFailure(std::current_exception());
+				return false;
+			}
+	}
+	return true;
+}
+
+void CompilerStack::reportCodeGenerationFailure(std::exception_ptr const& _failure)
+{
+	hypAssert(_failure);
+	try
+	{
+		std::rethrow_exception(_failure);
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			std::string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				fmt::format(
+					"Unimplemented feature error {} in {}",
+					(comment && !comment->empty()) ? ": " + *comment : "",
+					_unimplementedError.lineInfo()
+				)
+			);
+		}
+		else
+			throw;
+	}
+}
+
+namespace
+{
+
+Json::Value linkerObjectToJson(qrvmasm::LinkerObject const& _object)
+{
+	Json::Value json{Json::objectValue};
+	json["bytecode"] = util::toHex(_object.bytecode);
+	json["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		json["linkReferences"][std::to_string(offset)] = library;
+	json["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value& jsonReference = json["immutableReferences"][toCompactHexWithPrefix(hash)];
+		jsonReference["name"] = reference.first;
+		jsonReference["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			jsonReference["offsets"].append(Json::UInt64(offset));
+	}
+	json["functionDebugData"] = Json::objectValue;
+	for (auto const& [name, data]: _object.functionDebugData)
+	{
+		Json::Value& jsonData = json["functionDebugData"][name];
+		if (data.bytecodeOffset)
+			jsonData["bytecodeOffset"] = Json::UInt64(*data.bytecodeOffset);
+		if (data.instructionIndex)
+			jsonData["instructionIndex"] = Json::UInt64(*data.instructionIndex);
+		if (data.sourceID)
+			jsonData["sourceID"] = Json::UInt64(*data.sourceID);
+		jsonData["params"] = Json::UInt64(data.params);
+		jsonData["returns"] = Json::UInt64(data.returns);
+	}
+	return json;
+}
+
+qrvmasm::LinkerObject linkerObjectFromJson(Json::Value const& _json)
+{
+	auto optionalSize = [](Json::Value const& _value) -> std::optional<size_t> {
+		if (_value.isNull())
+			return std::nullopt;
+		return static_cast<size_t>(_value.asUInt64());
+	};
+
+	qrvmasm::LinkerObject object;
+	object.bytecode = util::fromHex(_json["bytecode"].asString());
+	for (std::string const& offset: _json["linkReferences"].getMemberNames())
+		object.linkReferences[std::stoul(offset)] = _json["linkReferences"][offset].asString();
+	for (std::string const& hash: _json["immutableReferences"].getMemberNames())
+	{
+		Json::Value const& jsonReference = _json["immutableReferences"][hash];
+		auto& reference = object.immutableReferences[u256(hash)];
+		reference.first = jsonReference["name"].asString();
+		for (Json::Value const& offset: jsonReference["offsets"])
+			reference.second.push_back(static_cast<size_t>(offset.asUInt64()));
+	}
+	for (std::string const& name: _json["functionDebugData"].getMemberNames())
+	{
+		Json::Value const& jsonData = _json["functionDebugData"][name];
+		qrvmasm::LinkerObject::FunctionDebugData& data = object.functionDebugData[name];
+		data.bytecodeOffset = optionalSize(jsonData["bytecodeOffset"]);
+		data.instructionIndex = optionalSize(jsonData["instructionIndex"]);
+		data.sourceID = optionalSize(jsonData["sourceID"]);
+		data.params = static_cast<size_t>(jsonData["params"].asUInt64());
+		data.returns = static_cast<size_t>(jsonData["returns"].asUInt64());
+	}
+	return object;
+}
+
+}
+
+util::h256 CompilerStack::compilationCacheKey(Contract const& _contract) const
+{
+	Json::Value key{Json::objectValue};
+	key["compiler"] = VersionString;
+	key["metadata"] = metadata(_contract);
+	// Source indices end up in source mappings and in the IR.
+	key["sourceList"] = Json::arrayValue;
+	for (std::string const& sourceName: sourceNames())
+		key["sourceList"].append(sourceName);
+	key["debugInfo"] = util::toString(m_debugInfoSelection);
+	key["metadataFormat"] = static_cast<int>(m_metadataFormat);
+	key["generateIR"] = m_generateIR;
+	key["generateBytecode"] = m_generateQrvmBytecode;
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
+bool CompilerStack::loadFromCompilationCache(Contract& _contract, util::h256 const& _key)
+{
+	hypAssert(m_compilationCache);
+
+	std::optional<Json::Value> entry = m_compilationCache->load(_key);
+	if (!entry)
+		return false;
+
+	_contract.yulIR = (*entry)["ir"].asString();
+	if ((*entry)["irOptimized"].isString())
+		_contract.yulIROptimized.init([&]{ return (*entry)["irOptimized"].asString(); });
+	if (!(*entry)["object"].isNull())
+	{
+		_contract.object = linkerObjectFromJson((*entry)["object"]);
+		_contract.runtimeObject = linkerObjectFromJson((*entry)["runtimeObject"]);
+	}
+	if ((*entry)["sourceMap"].isString())
+		_contract.sourceMapping.emplace((*entry)["sourceMap"].asString());
+	if ((*entry)["runtimeSourceMap"].isString())
+		_contract.runtimeSourceMapping.emplace((*entry)["runtimeSourceMap"].asString());
+	_contract.generatedSources.init([&]{ return (*entry)["generatedSources"]; });
+	_contract.runtimeGeneratedSources.init([&]{ return (*entry)["runtimeGeneratedSources"]; });
+	return true;
+}
+
+void CompilerStack::storeInCompilationCache(Contract const& _contract, util::h256 const& _key) const
+{
+	hypAssert(m_compilationCache);
+	hypAssert(m_stackState == CompilationSuccessful);
+
+	std::string const& contractName = _contract.contract->fullyQualifiedName();
+	Json::Value entry{Json::objectValue};
+	entry["ir"] = _contract.yulIR;
+	if (_contract.yulIROptimizedStack)
+		entry["irOptimized"] = yulIROptimized(contractName);
+	if (_contract.qrvmAssembly)
+	{
+		entry["object"] = linkerObjectToJson(_contract.object);
+		entry["runtimeObject"] = linkerObjectToJson(_contract.runtimeObject);
+		if (std::string const* mapping = sourceMapping(contractName))
+			entry["sourceMap"] = *mapping;
+		if (std::string const* mapping = runtimeSourceMapping(contractName))
+			entry["runtimeSourceMap"] = *mapping;
+	}
+	entry["generatedSources"] = generatedSources(contractName, false);
+	entry["runtimeGeneratedSources"] = generatedSources(contractName, true);
+	m_compilationCache->store(_key, entry);
+}
+
 void CompilerStack::link()
 {
 	hypAssert(m_stackState >= CompilationSuccessful, "");
@@ -922,7 +1463,22 @@ Json::Value const& CompilerStack::yulIRAst(std::string const& _contractName) con
 	if (m_stackState != CompilationSuccessful)
 		hypThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIRAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIRAst.init([&]{
+		if (compiledContract.yulIR.empty())
+			return Json::Value{};
+
+		// The unoptimized AST is not kept in memory, so it is re-parsed on request.
+		yul::YulStack stack(
+			m_qrvmVersion,
+			yul::YulStack::Language::StrictAssembly,
+			m_optimiserSettings,
+			m_debugInfoSelection
+		);
+		bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
+		hypAssert(yulAnalysisSuccessful);
+		return stack.astJson();
+	});
 }
 
 std::string const& CompilerStack::yulIROptimized(std::string const& _contractName) const
@@ -930,7 +1486,12 @@ std::string const& CompilerStack::yulIROptimized(std::string const& _contractNam
 	if (m_stackState != CompilationSuccessful)
 		hypThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIROptimized;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimized.init([&]{
+		if (!compiledContract.yulIROptimizedStack)
+			return std::string{};
+		return compiledContract.yulIROptimizedStack->print(this);
+	});
 }
 
 Json::Value const& CompilerStack::yulIROptimizedAst(std::string const& _contractName) const
@@ -938,7 +1499,25 @@ Json::Value const& CompilerStack::yulIROptimizedAst(std::string const& _contract
 	if (m_stackState != CompilationSuccessful)
 		hypThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIROptimizedAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimizedAst.init([&]{
+		if (compiledContract.yulIROptimizedStack)
+			return compiledContract.yulIROptimizedStack->astJson();
+
+		// Contracts restored from the compilation cache only carry the optimized IR as text.
+		std::string const& optimizedIR = yulIROptimized(_contractName);
+		if (optimizedIR.empty())
+			return Json::Value{};
+		yul::YulStack stack(
+			m_qrvmVersion,
+			yul::YulStack::Language::StrictAssembly,
+			m_optimiserSettings,
+			m_debugInfoSelection
+		);
+		bool yulAnalysisSuccessful = stack.parseAndAnalyze("", optimizedIR);
+		hypAssert(yulAnalysisSuccessful);
+		return stack.astJson();
+	});
 }
 
 qrvmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -983,6 +1562,18 @@ Json::Value CompilerStack::assemblyJSON(std::string const& _contractName) const
 		return Json::Value();
 }
 
+void CompilerStack::assemblyJSON(std::string const& _contractName, util::JsonWriter& _writer) const
+{
+	if (m_stackState != CompilationSuccessful)
+		hypThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.qrvmAssembly)
+		currentContract.qrvmAssembly->assemblyJSON(_writer, sourceIndices());
+	else
+		_writer.write(Json::Value());
+}
+
 std::vector<std::string> CompilerStack::sourceNames() const
 {
 	return ranges::to<std::vector>(m_sources | ranges::views::keys);
@@ -1186,6 +1777,7 @@ std::string const& CompilerStack::Source::ipfsUrl() const
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 {
 	hypAssert(m_stackState < ParsedAndImported, "");
+	util::TimeReport::ScopedPhase phase("importResolution");
 	StringMap newSources;
 	try
 	{
@@ -1344,12 +1936,14 @@ bool onlySafeExperimentalFeaturesActivated(std::set<ExperimentalFeature> const&
 void CompilerStack::assembleYul(
 	ContractDefinition const& _contract,
 	std::shared_ptr<qrvmasm::Assembly> _assembly,
-	std::shared_ptr<qrvmasm::Assembly> _runtimeAssembly
+	std::shared_ptr<qrvmasm::Assembly> _runtimeAssembly,
+	langutil::ErrorReporter& _errorReporter
 )
 {
 	hypAssert(m_stackState >= AnalysisSuccessful, "");
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::TimeReport::ScopedPhase phase("assembling");
 
 	compiledContract.qrvmAssembly = _assembly;
 	hypAssert(compiledContract.qrvmAssembly, "");
@@ -1382,7 +1976,7 @@ void CompilerStack::assembleYul(
 	if (
 		compiledContract.runtimeObject.bytecode.size() > 0x6000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			5574_error,
 			_contract.location(),
 			"Contract code size is "s +
@@ -1399,7 +1993,7 @@ void CompilerStack::assembleYul(
 	if (
 		compiledContract.object.bytecode.size() > 0xC000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			3860_error,
 			_contract.location(),
 			"Contract initcode size is "s +
@@ -1429,6 +2023,7 @@ void CompilerStack::compileContract(
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), _contract.fullyQualifiedName());
 
 	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_qrvmVersion, m_revertStrings, m_optimiserSettings);
 	compiledContract.compiler = compiler;
@@ -1439,6 +2034,7 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Run optimiser and compile the contract.
+		util::TimeReport::ScopedPhase phase("legacyCodeGeneration");
 		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
 	}
 	catch(qrvmasm::OptimizerException const&)
@@ -1448,10 +2044,19 @@ void CompilerStack::compileContract(
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr(), m_errorReporter);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
+{
+	for (ContractDefinition const* contract: generateUnoptimizedIR(_contract, m_errorReporter))
+		optimizeIR(*contract);
+}
+
+std::vector<ContractDefinition const*> CompilerStack::generateUnoptimizedIR(
+	ContractDefinition const& _contract,
+	langutil::ErrorReporter& _errorReporter
+)
 {
 	hypAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1460,23 +2065,25 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 	if (!compiledContract.yulIR.empty())
-		return;
+		return {};
 
 	if (!*_contract.sourceUnit().annotation().useABICoderV2)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			2066_error,
 			_contract.location(),
 			"Contract requests the ABI coder v1, which is incompatible with the IR. "
 			"Using ABI coder v2 instead."
 		);
 
-	std::string dependenciesSource;
+	std::vector<ContractDefinition const*> generatedContracts;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency);
+		generatedContracts += generateUnoptimizedIR(*dependency, _errorReporter);
 
 	if (!_contract.canBeDeployed())
-		return;
+		return generatedContracts;
 
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), _contract.fullyQualifiedName());
+	util::TimeReport::ScopedPhase phase("irGeneration");
 	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
@@ -1494,28 +2101,51 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		createCBORMetadata(compiledContract, /* _forIR */ true),
 		otherYulSources
 	);
+	generatedContracts.push_back(&_contract);
+	return generatedContracts;
+}
+
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, util::ThreadPool* _threadPool)
+{
+	hypAssert(m_stackState >= AnalysisSuccessful, "");
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	hypAssert(!compiledContract.yulIR.empty(), "");
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), _contract.fullyQualifiedName());
+	util::TimeReport::PhaseSequence phases;
 
-	yul::YulStack stack(
+	phases.next("irAnalysis");
+	auto stack = std::make_shared<yul::YulStack>(
 		m_qrvmVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
+	bool yulAnalysisSuccessful = stack->parseAndAnalyze("", compiledContract.yulIR);
 	hypAssert(
 		yulAnalysisSuccessful,
 		compiledContract.yulIR + "\n\n"
 		"Invalid IR generated:\n" +
-		langutil::SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
+		langutil::SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
 	);
 
-	compiledContract.yulIRAst = stack.astJson();
-	stack.optimize();
-	compiledContract.yulIROptimized = stack.print(this);
-	compiledContract.yulIROptimizedAst = stack.astJson();
+	// The IR of contracts created via ``new`` is embedded into the IR of their creators. Reuse the
+	// objects optimised for those contracts instead of optimising them again for every creator.
+	std::map<std::string, std::shared_ptr<yul::YulStack const>> optimizedStacks;
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		if (auto const& dependencyStack = m_contracts.at(dependency->fullyQualifiedName()).yulIROptimizedStack)
+			optimizedStacks.emplace(dependencyStack->parserResult()->name.str(), dependencyStack);
+
+	phases.next("yulOptimizer");
+	stack->optimize(optimizedStacks, _threadPool);
+	compiledContract.yulIROptimizedStack = std::move(stack);
 }
 
-void CompilerStack::generateQRVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateQRVMFromIR(
+	ContractDefinition const& _contract,
+	langutil::ErrorReporter& _errorReporter,
+	util::ThreadPool* _threadPool
+)
 {
 	hypAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1523,26 +2153,16 @@ void CompilerStack::generateQRVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	hypAssert(!compiledContract.yulIROptimized.empty(), "");
+	hypAssert(compiledContract.yulIROptimizedStack, "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in QRVM dialect
-	yul::YulStack stack(
-		m_qrvmVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	hypAssert(analysisSuccessful);
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
-
+	util::TimeReport::ScopedUnit timeReportUnit(m_timeReport.get(), _contract.fullyQualifiedName());
 	std::string deployedName = IRNames::deployedObject(_contract);
 	hypAssert(!deployedName.empty(), "");
-	tie(compiledContract.qrvmAssembly, compiledContract.qrvmRuntimeAssembly) = stack.assembleQRVMWithDeployed(deployedName);
-	assembleYul(_contract, compiledContract.qrvmAssembly, compiledContract.qrvmRuntimeAssembly);
+	tie(compiledContract.qrvmAssembly, compiledContract.qrvmRuntimeAssembly) =
+		compiledContract.yulIROptimizedStack->assembleQRVMWithDeployed(deployedName, _threadPool);
+	assembleYul(_contract, compiledContract.qrvmAssembly, compiledContract.qrvmRuntimeAssembly, _errorReporter);
 }
 
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
@@ -1845,6 +2465,34 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
+Json::Value CompilerStack::timeReport() const
+{
+	hypAssert(m_timeReport, "Time report was not enabled.");
+
+	Json::Value report(Json::objectValue);
+	report["compilation"] = Json::arrayValue;
+	report["contracts"] = Json::objectValue;
+	for (auto const& [unit, phases]: m_timeReport->phases())
+	{
+		Json::Value phasesJson(Json::arrayValue);
+		for (util::TimeReport::Phase const& phase: phases)
+		{
+			Json::Value phaseJson(Json::objectValue);
+			phaseJson["name"] = phase.name;
+			phaseJson["count"] = Json::UInt64(phase.count);
+			phaseJson["wallTimeMilliseconds"] = std::chrono::duration<double, std::milli>(phase.wallTime).count();
+			if (phase.peakMemoryGrowth)
+				phaseJson["peakRSSGrowthBytes"] = Json::UInt64(*phase.peakMemoryGrowth);
+			phasesJson.append(std::move(phaseJson));
+		}
+		if (unit.empty())
+			report["compilation"] = std::move(phasesJson);
+		else
+			report["contracts"][unit] = std::move(phasesJson);
+	}
+	return report;
+}
+
 Json::Value CompilerStack::gasEstimates(std::string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -47,9 +47,11 @@
 #include <libhyputil/Common.h>
 #include <libhyputil/FixedHash.h>
 #include <libhyputil/LazyInit.h>
+#include <libhyputil/TimeReport.h>
 
 #include <json/json.h>
 
+#include <exception>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -70,11 +72,22 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace hyperion::util
+{
+class ThreadPool;
+}
+
+namespace hyperion::yul
+{
+class YulStack;
+}
+
 namespace hyperion::frontend
 {
 
 // forward declarations
 class ASTNode;
+class CompilationCache;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
@@ -146,6 +159,12 @@ public:
 	/// all settings are reset as well.
 	void reset(bool _keepSettings = false);
 
+	/// Resets the compiler like reset(), but keeps the ASTs of the current sources that were
+	/// parsed without errors or warnings. The next call to parse() takes them over for sources
+	/// whose content did not change instead of parsing these sources again. All analysis steps
+	/// are repeated for all sources.
+	void resetKeepingParsedSources(bool _keepSettings = false);
+
 	/// Sets path remappings.
 	/// Must be set before parsing.
 	void setRemappings(std::vector<ImportRemapper::Remapping> _remappings);
@@ -169,6 +188,21 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to parse the sources and to generate and
+	/// optimise code for the contracts. A value of 1 compiles everything on the calling thread.
+	/// The output does not depend on this setting.
+	void setParallelism(size_t _parallelism);
+
+	/// Sets the cache from which the code of requested contracts is restored instead of
+	/// generating it, and to which newly generated code is added.
+	/// Contracts restored from the cache have no QRVM assembly, so the cache must not be used
+	/// when assembly output or gas estimates are requested. No cache is used by default.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
+
+	/// Enables measuring the wall time and the peak memory growth of the compilation phases,
+	/// which are available via @a timeReport afterwards. Disabled by default.
+	void enableTimeReport(bool _enable = true);
+
 	/// Set the QRVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -308,6 +342,10 @@ public:
 	/// Prerequisite: Successful compilation.
 	virtual Json::Value assemblyJSON(std::string const& _contractName) const override;
 
+	/// Writes the JSON representation of the assembly to @a _writer.
+	/// Prerequisite: Successful compilation.
+	virtual void assemblyJSON(std::string const& _contractName, util::JsonWriter& _writer) const override;
+
 	/// @returns a JSON representing the contract ABI.
 	/// Prerequisite: Successful call to parse or compile.
 	Json::Value const& contractABI(std::string const& _contractName) const;
@@ -341,6 +379,10 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns a JSON object with the phases measured since the last reset, both the ones concerning
+	/// the whole compilation and the ones of each contract. Requires the time report to be enabled.
+	Json::Value timeReport() const;
+
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	void setMetadataFormat(MetadataFormat _metadataFormat) { m_metadataFormat = _metadataFormat; }
 
@@ -355,6 +397,9 @@ private:
 	{
 		std::shared_ptr<langutil::CharStream> charStream;
 		std::shared_ptr<SourceUnit> ast;
+		/// Whether parsing reported no errors or warnings, so that the AST can be reused
+		/// without losing any diagnostics.
+		bool parsedCleanly = false;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -374,9 +419,11 @@ private:
 		qrvmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		qrvmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
-		std::string yulIROptimized; ///< Optimized Yul IR code.
-		Json::Value yulIRAst; ///< JSON AST of Yul IR code.
-		Json::Value yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		/// Analysed and optimized Yul IR, used for code generation without re-parsing.
+		std::shared_ptr<yul::YulStack> yulIROptimizedStack;
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized Yul IR code, printed on demand.
+		util::LazyInit<Json::Value const> yulIRAst; ///< JSON AST of Yul IR code.
+		util::LazyInit<Json::Value const> yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json::Value const> abi;
 		util::LazyInit<Json::Value const> storageLayout;
@@ -391,6 +438,21 @@ private:
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
+	/// Parses the sources in @a _sourcesToParse and the ones they import like the serial loop
+	/// in parse(), but parses the sources known at each point on m_parallelism threads.
+	/// The sources are then processed in serial order and their node IDs are shifted, so that
+	/// the result, including the node IDs and diagnostics, is the same as with serial parsing.
+	/// Imported files are still read on the calling thread.
+	/// The nodes of the parsed sources get IDs after @a _reusedNodeIDs.
+	void parseInParallel(std::vector<std::string>& _sourcesToParse, int64_t _reusedNodeIDs);
+	/// Stores @a _ast as the AST of the source at @a _index of @a _sourcesToParse, resolves the
+	/// paths of its imports and appends the sources it imports that are not known yet to
+	/// @a _sourcesToParse.
+	void storeParsedSource(std::vector<std::string>& _sourcesToParse, size_t _index, ASTPointer<SourceUnit> _ast);
+	/// @returns the AST kept by resetKeepingParsedSources() for the source at @a _path if the
+	/// content of the source did not change, or nullptr otherwise.
+	ASTPointer<SourceUnit> takeParsedSource(std::string const& _path);
+
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile
 	/// @returns the newly loaded sources.
@@ -418,12 +480,13 @@ private:
 	/// @returns false on error.
 	bool analyzeExperimental();
 
-	/// Assembles the contract.
+	/// Assembles the contract and reports size limit violations to @a _errorReporter.
 	/// This function should only be internally called by compileContract and generateQRVMFromIR.
 	void assembleYul(
 		ContractDefinition const& _contract,
 		std::shared_ptr<qrvmasm::Assembly> _assembly,
-		std::shared_ptr<qrvmasm::Assembly> _runtimeAssembly
+		std::shared_ptr<qrvmasm::Assembly> _runtimeAssembly,
+		langutil::ErrorReporter& _errorReporter
 	);
 
 	/// Compile a single contract.
@@ -438,9 +501,53 @@ private:
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
 
+	/// Generate the unoptimized Yul IR for a single contract and the contracts it depends on.
+	/// Reports warnings to @a _errorReporter.
+	/// @returns the contracts whose IR was generated by this call, in order of generation.
+	std::vector<ContractDefinition const*> generateUnoptimizedIR(
+		ContractDefinition const& _contract,
+		langutil::ErrorReporter& _errorReporter
+	);
+
+	/// Analyse and optimise the IR generated by generateUnoptimizedIR.
+	/// Only accesses the state of the given contract and can therefore run concurrently
+	/// for different contracts.
+	/// If @a _threadPool is given, the sub-objects of the contract are optimised on it concurrently.
+	void optimizeIR(ContractDefinition const& _contract, util::ThreadPool* _threadPool = nullptr);
+
 	/// Generate QRVM representation for a single contract.
 	/// Depends on output generated by generateIR.
-	void generateQRVMFromIR(ContractDefinition const& _contract);
+	/// Only accesses the state of the given contract and can therefore run concurrently
+	/// for different contracts.
+	/// If @a _threadPool is given, the sub-assemblies of the contract are optimised on it concurrently.
+	void generateQRVMFromIR(
+		ContractDefinition const& _contract,
+		langutil::ErrorReporter& _errorReporter,
+		util::ThreadPool* _threadPool = nullptr
+	);
+
+	/// Compiles the given contracts like the serial loop in compile(), but generates and optimises
+	/// their code on m_parallelism threads. Diagnostics are collected per contract and
+	/// reported in the same order as in serial compilation.
+	/// @returns false on error.
+	bool compileInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// @returns the key under which the generated code of @a _contract is cached. It covers the
+	/// contract's metadata, which hashes all relevant sources and settings, the compiler version
+	/// and all settings affecting the generated code that are not part of the metadata.
+	util::h256 compilationCacheKey(Contract const& _contract) const;
+
+	/// Restores the generated code of @a _contract from m_compilationCache.
+	/// @returns false if there is no usable entry for @a _key.
+	bool loadFromCompilationCache(Contract& _contract, util::h256 const& _key);
+
+	/// Stores the generated code of @a _contract in m_compilationCache.
+	/// Must be called after compilation succeeded, but before linking.
+	void storeInCompilationCache(Contract const& _contract, util::h256 const& _key) const;
+
+	/// Reports @a _failure as a code generation error if it is one of the failures
+	/// compile() turns into errors and rethrows it otherwise.
+	void reportCodeGenerationFailure(std::exception_ptr const& _failure);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -499,9 +606,16 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateQrvmBytecode = true;
 	bool m_generateIR = false;
+	size_t m_parallelism = 1;
+	std::shared_ptr<CompilationCache> m_compilationCache;
+	std::unique_ptr<util::TimeReport> m_timeReport;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
+	/// Sources kept by resetKeepingParsedSources() for reuse by the next call to parse().
+	std::map<std::string, Source> m_parsedSources;
+	/// The QRVM version the sources in m_parsedSources were parsed for.
+	langutil::QRVMVersion m_parsedSourcesQRVMVersion;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
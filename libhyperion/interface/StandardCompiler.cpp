@@ -24,6 +24,7 @@
 #include <libhyperion/interface/StandardCompiler.h>
 #include <libhyperion/interface/ImportRemapper.h>
 
+#include <libhyperion/ast/ASTBinaryFormat.h>
 #include <libhyperion/ast/ASTJsonExporter.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
@@ -37,13 +38,16 @@
 
 #include <libhyputil/JSON.h>
 #include <libhyputil/Keccak256.h>
+#include <libhyputil/Common.h>
 #include <libhyputil/CommonData.h>
+#include <libhyputil/ThreadPool.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace hyperion;
 using namespace hyperion::yul;
@@ -190,6 +194,9 @@ bool isArtifactRequested(Json::Value const& _outputSelection, std::string const&
 			return true;
 		else if (selectedArtifact == "*")
 		{
+			// "astBinary" only duplicates "ast" and has to be requested explicitly.
+			if (_artifact == "astBinary")
+				continue;
 			// "ir", "irOptimized" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
 				return true;
@@ -294,6 +301,25 @@ bool isQrvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output derived from the QRVM assembly was requested. Such outputs
+/// cannot be restored from the compilation cache.
+bool isQrvmAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	static std::vector<std::string> const outputsThatRequireQrvmAssembly{
+		"qrvm.gasEstimates", "qrvm.legacyAssembly", "qrvm.assembly"
+	};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireQrvmAssembly)
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 /// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
 /// yet match "ir", "irAst", "irOptimized" or "irOptimizedAst"
 bool isIRRequested(Json::Value const& _outputSelection)
@@ -423,7 +449,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static std::set<std::string> keys{"debug", "qrvmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "qrvmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "timeReport", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -790,6 +816,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("timeReport"))
+	{
+		if (!settings["timeReport"].isBool())
+			return formatFatalError(Error::Type::JSONError, "\"settings.timeReport\" must be a Boolean.");
+		ret.timeReport = settings["timeReport"].asBool();
+	}
+
 	if (settings.isMember("qrvmVersion"))
 	{
 		if (!settings["qrvmVersion"].isString())
@@ -1138,6 +1178,14 @@ std::map<std::string, Json::Value> StandardCompiler::parseAstFromInput(StringMap
 	{
 		Json::Value ast;
 		astAssert(util::jsonParseStrict(sourceCode, ast), "Input file could not be parsed to JSON");
+		if (ast.isMember("astBinary"))
+		{
+			std::optional<std::string> data;
+			if (ast["astBinary"].isString())
+				data = util::fromBase64(ast["astBinary"].asString());
+			astAssert(data, "\"astBinary\" must be a base64 string");
+			ast["ast"] = ASTBinaryFormat::decode(*data);
+		}
 		std::string astKey = ast.isMember("ast") ? "ast" : "AST";
 
 		astAssert(ast.isMember(astKey), "astkey is not member");
@@ -1150,7 +1198,9 @@ std::map<std::string, Json::Value> StandardCompiler::parseAstFromInput(StringMap
 
 Json::Value StandardCompiler::compileHyperion(StandardCompiler::InputsAndSettings _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	// Shared with the deferred outputs, which are written after returning.
+	auto compilerStackPointer = std::make_shared<CompilerStack>(m_readFile);
+	CompilerStack& compilerStack = *compilerStackPointer;
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Hyperion")
@@ -1158,6 +1208,8 @@ Json::Value StandardCompiler::compileHyperion(StandardCompiler::InputsAndSetting
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.enableTimeReport(_inputsAndSettings.timeReport);
 	compilerStack.setQRVMVersion(_inputsAndSettings.qrvmVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -1173,6 +1225,8 @@ Json::Value StandardCompiler::compileHyperion(StandardCompiler::InputsAndSetting
 
 	compilerStack.enableQrvmBytecodeGeneration(isQrvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	if (m_compilationCache && !isQrvmAssemblyRequested(_inputsAndSettings.outputSelection))
+		compilerStack.setCompilationCache(m_compilationCache);
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1344,8 +1398,24 @@ Json::Value StandardCompiler::compileHyperion(StandardCompiler::InputsAndSetting
 		{
 			Json::Value sourceResult = Json::objectValue;
 			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			bool const astRequested = isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental);
+			bool const astBinaryRequested = isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "astBinary", wildcardMatchesExperimental);
+			if (astRequested && m_deferredOutputs)
+			{
+				sourceResult["ast"] = Json::nullValue;
+				(*m_deferredOutputs)[{"sources", sourceName, "ast"}] = [compilerStackPointer, sourceName](util::JsonWriter& _writer) {
+					CompilerStack const& stack = *compilerStackPointer;
+					ASTJsonExporter(stack.state(), stack.sourceIndices()).print(_writer, stack.ast(sourceName));
+				};
+			}
+			else if (astRequested)
 				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			if (astBinaryRequested)
+			{
+				ASTBinaryWriter writer;
+				ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).print(writer, compilerStack.ast(sourceName));
+				sourceResult["astBinary"] = util::toBase64(writer.finish());
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
@@ -1385,7 +1455,17 @@ Json::Value StandardCompiler::compileHyperion(StandardCompiler::InputsAndSetting
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "qrvm.assembly", wildcardMatchesExperimental))
 			qrvmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "qrvm.legacyAssembly", wildcardMatchesExperimental))
-			qrvmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+		{
+			if (m_deferredOutputs)
+			{
+				qrvmData["legacyAssembly"] = Json::nullValue;
+				(*m_deferredOutputs)[{"contracts", file, name, "qrvm", "legacyAssembly"}] = [compilerStackPointer, contractName](util::JsonWriter& _writer) {
+					compilerStackPointer->assemblyJSON(contractName, _writer);
+				};
+			}
+			else
+				qrvmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+		}
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "qrvm.methodIdentifiers", wildcardMatchesExperimental))
 			qrvmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "qrvm.gasEstimates", wildcardMatchesExperimental))
@@ -1446,6 +1526,9 @@ Json::Value StandardCompiler::compileHyperion(StandardCompiler::InputsAndSetting
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (_inputsAndSettings.timeReport)
+		output["timeReport"] = compilerStack.timeReport();
+
 	return output;
 }
 
@@ -1531,7 +1614,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		return output;
 	}
 
-	std::string contractName = stack.parserResult()->name.str();
+	std::string contractName(stack.parserResult()->name.str());
 
 	bool const wildcardMatchesExperimental = true;
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "ir", wildcardMatchesExperimental))
@@ -1544,7 +1627,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		sourceResult["ast"] = stack.astJson();
 		output["sources"][sourceName] = sourceResult;
 	}
-	stack.optimize();
+	std::unique_ptr<util::ThreadPool> threadPool;
+	if (_inputsAndSettings.parallelism > 1)
+		threadPool = std::make_unique<util::ThreadPool>(_inputsAndSettings.parallelism - 1);
+	stack.optimize({}, threadPool.get());
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject deployedObject;
@@ -1593,8 +1679,6 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
-
 	try
 	{
 		auto parsed = parseInput(_input);
@@ -1629,30 +1713,147 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 }
 
 std::string StandardCompiler::compile(std::string const& _input) noexcept
+{
+	ScopeGuard resetResult([&]() { m_deferredOutputs.reset(); m_result = {}; });
+	std::ostringstream serialized;
+	if (serialize(_input, serialized))
+		return serialized.str();
+	// The errors of the outputs that failed are now part of the result, so that a second
+	// attempt includes them.
+	serialized = std::ostringstream{};
+	if (!writeResult(serialized))
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+	return serialized.str();
+}
+
+bool StandardCompiler::compile(std::string const& _input, std::ostream& _output) noexcept
+{
+	ScopeGuard resetResult([&]() { m_deferredOutputs.reset(); m_result = {}; });
+	return serialize(_input, _output);
+}
+
+bool StandardCompiler::serialize(std::string const& _input, std::ostream& _output) noexcept
 {
 	Json::Value input;
 	std::string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+		{
+			_output << util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+			return true;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return true;
 	}
 
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+	m_deferredOutputs.emplace();
+	m_result = compile(input);
+	// cout << "Output: " << m_result.toStyledString() << endl;
+	return writeResult(_output);
+}
 
+bool StandardCompiler::writeResult(std::ostream& _output) noexcept
+{
+	bool errorsComplete = true;
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		util::JsonWriter writer(_output, m_jsonPrintingFormat);
+		std::vector<std::string> path;
+		std::vector<std::vector<std::string>> failedOutputs;
+		writeOutput(writer, m_result, path, failedOutputs, errorsComplete);
+		for (auto const& failedOutput: failedOutputs)
+			m_deferredOutputs->erase(failedOutput);
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		// The output written so far cannot be taken back.
+		return false;
+	}
+	return errorsComplete;
+}
+
+void StandardCompiler::writeOutput(
+	util::JsonWriter& _writer,
+	Json::Value const& _output,
+	std::vector<std::string>& _path,
+	std::vector<std::vector<std::string>>& _failedOutputs,
+	bool& _errorsComplete
+)
+{
+	DeferredOutputs const& deferredOutputs = *m_deferredOutputs;
+	// Deferred outputs below _path follow it in the order of the map.
+	auto deferred = deferredOutputs.lower_bound(_path);
+	if (
+		deferred == deferredOutputs.end() ||
+		deferred->first.size() < _path.size() ||
+		!std::equal(_path.begin(), _path.end(), deferred->first.begin())
+	)
+		_writer.write(_output);
+	else if (deferred->first == _path)
+	{
+		// A deferred output that fails is left at its null placeholder and reported as an error,
+		// keeping all other outputs.
+		Json::Value failure;
+		try
+		{
+			_writer.writeBuffered(deferred->second);
+			return;
+		}
+		catch (InternalCompilerError const& _exception)
+		{
+			failure = formatFatalError(
+				Error::Type::InternalCompilerError,
+				"Internal compiler error (" + _exception.lineInfo() + "): " + _exception.what()
+			);
+		}
+		catch (UnimplementedFeatureError const& _exception)
+		{
+			failure = formatFatalError(
+				Error::Type::UnimplementedFeatureError,
+				"Unimplemented feature (" + _exception.lineInfo() + "): " + _exception.what()
+			);
+		}
+		catch (util::Exception const& _exception)
+		{
+			failure = formatFatalError(
+				Error::Type::Exception,
+				"Exception while writing output: " + boost::diagnostic_information(_exception)
+			);
+		}
+		_writer.write(Json::nullValue);
+		_failedOutputs.push_back(_path);
+		for (Json::Value const& error: failure["errors"])
+			m_result["errors"].append(error);
+		// The members of the result are written in order, so its errors are already written
+		// if the failed output comes after them.
+		if (_path.front() > "errors")
+			_errorsComplete = false;
+	}
+	else
+	{
+		hypAssert(_output.isObject());
+		_writer.beginObject();
+		std::vector<std::string> names = _output.getMemberNames();
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			std::string const name = names[i];
+			_writer.key(name);
+			_path.push_back(name);
+			writeOutput(_writer, _output[name], _path, _failedOutputs, _errorsComplete);
+			_path.pop_back();
+			if (_path.empty())
+			{
+				// A failed deferred output can add the errors member to the result.
+				names = _output.getMemberNames();
+				i = static_cast<size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+			}
+		}
+		_writer.endObject();
 	}
 }
 
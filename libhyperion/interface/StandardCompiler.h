@@ -28,9 +28,13 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
+#include <map>
+#include <ostream>
 #include <optional>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace hyperion::frontend
 {
@@ -62,6 +66,16 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the serialized output to @a _output as it is produced instead of
+	/// building it in memory first.
+	/// @returns false if some outputs could not be produced after the errors of the output were
+	/// already written or if the output could not be written completely. These outputs are null
+	/// and their errors are missing from the output.
+	bool compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Sets the cache used by all subsequent compilations of Hyperion sources.
+	/// It is ignored for inputs that request assembly output or gas estimates.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, qrvmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -87,19 +101,51 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool timeReport = false;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
+	/// Functions that write an output to the serialized result, keyed by the path of the output.
+	using DeferredOutputs = std::map<std::vector<std::string>, std::function<void(util::JsonWriter&)>>;
+
 	std::map<std::string, Json::Value> parseAstFromInput(StringMap const& _sources);
 	Json::Value compileHyperion(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// Compiles @a _input and writes the result to @a _output, but leaves it in m_result.
+	/// @returns the result of writeResult().
+	bool serialize(std::string const& _input, std::ostream& _output) noexcept;
+	/// Writes m_result to @a _output. Deferred outputs that fail are removed and their errors
+	/// are added to m_result.
+	/// @returns false if such errors were added after the errors were written or if writing failed.
+	bool writeResult(std::ostream& _output) noexcept;
+	/// Writes @a _output, whose path in the result is @a _path, to @a _writer and substitutes the
+	/// outputs in m_deferredOutputs for the placeholders at their paths. The paths of failed
+	/// deferred outputs are added to @a _failedOutputs.
+	void writeOutput(
+		util::JsonWriter& _writer,
+		Json::Value const& _output,
+		std::vector<std::string>& _path,
+		std::vector<std::vector<std::string>>& _failedOutputs,
+		bool& _errorsComplete
+	);
+
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<CompilationCache> m_compilationCache;
+
+	/// Set while a serialized output is produced. The large outputs (the AST and the legacy assembly)
+	/// are then not included in the JSON output, which only contains null placeholders for them,
+	/// but are written directly to the serialized result.
+	std::optional<DeferredOutputs> m_deferredOutputs;
+	/// Result that is being serialized.
+	Json::Value m_result;
 };
 
 }
@@ -147,6 +147,65 @@ Result<boost::filesystem::path> FileRepository::tryResolvePath(std::string const
 	return candidates[0];
 }
 
+void FileRepository::markDirtySince(FileRepository const& _previous)
+{
+	auto const unchangedOnDisk = [&](std::string const& _sourceUnitName, std::string const& _content) -> bool {
+		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(stripFileUriSchemePrefix(_sourceUnitName));
+		if (!resolvedPath.message().empty())
+			return false;
+		try
+		{
+			return readFromDisk(resolvedPath.get()) == _content;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	};
+
+	m_dirtySourceUnits.clear();
+
+	for (auto const& [sourceUnitName, content]: m_sourceCodes)
+		if (
+			auto const previous = _previous.m_sourceCodes.find(sourceUnitName);
+			previous == _previous.m_sourceCodes.end() || previous->second != content
+		)
+			m_dirtySourceUnits.insert(sourceUnitName);
+
+	for (auto const& [sourceUnitName, content]: _previous.m_sourceCodes)
+		if (
+			!m_sourceCodes.count(sourceUnitName) &&
+			!(_previous.m_importedSourceUnits.count(sourceUnitName) && unchangedOnDisk(sourceUnitName, content))
+		)
+			m_dirtySourceUnits.insert(sourceUnitName);
+
+	for (std::string const& sourceUnitName: _previous.m_unresolvedSourceUnits)
+		if (!m_sourceCodes.count(sourceUnitName) && tryResolvePath(stripFileUriSchemePrefix(sourceUnitName)).message().empty())
+			m_dirtySourceUnits.insert(sourceUnitName);
+}
+
+std::string FileRepository::readFromDisk(boost::filesystem::path const& _path)
+{
+	std::time_t const lastWriteTime = boost::filesystem::last_write_time(_path);
+	uintmax_t const size = boost::filesystem::file_size(_path);
+	if (
+		auto const cachedFile = m_fileCache.find(_path);
+		cachedFile != m_fileCache.end() &&
+		cachedFile->second.lastWriteTime == lastWriteTime &&
+		cachedFile->second.size == size
+	)
+		return cachedFile->second.content;
+
+	std::string content = readFileAsString(_path);
+	// The modification time only has a resolution of seconds, so a file that is modified again
+	// in the second in which it was read could keep its modification time. Such files are not cached.
+	if (lastWriteTime < std::time(nullptr))
+		m_fileCache[_path] = CachedFile{lastWriteTime, size, content};
+	else
+		m_fileCache.erase(_path);
+	return content;
+}
+
 frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind, std::string const& _sourceUnitName)
 {
 	hypAssert(
@@ -163,11 +222,15 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 		std::string const strippedSourceUnitName = stripFileUriSchemePrefix(_sourceUnitName);
 		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(strippedSourceUnitName);
 		if (!resolvedPath.message().empty())
+		{
+			m_unresolvedSourceUnits.insert(_sourceUnitName);
 			return ReadCallback::Result{false, resolvedPath.message()};
+		}
 
-		auto contents = readFileAsString(resolvedPath.get());
+		auto contents = readFromDisk(resolvedPath.get());
 		hypAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
+		m_importedSourceUnits.insert(_sourceUnitName);
 		return ReadCallback::Result{true, std::move(contents)};
 	}
 	catch (std::exception const& _exception)
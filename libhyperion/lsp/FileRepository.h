@@ -20,8 +20,12 @@
 #include <libhyperion/interface/FileReader.h>
 #include <libhyputil/Result.h>
 
+#include <boost/filesystem.hpp>
+
+#include <ctime>
 #include <string>
 #include <map>
+#include <set>
 
 namespace hyperion::lsp
 {
@@ -57,6 +61,22 @@ public:
 
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
+	/// Compares the sources against the ones of @a _previous and flags every source unit
+	/// that was added, removed or modified as dirty.
+	/// Source units that @a _previous only loaded on import are compared against their current
+	/// content on disk, and imports it failed to resolve are flagged if they resolve now.
+	void markDirtySince(FileRepository const& _previous);
+
+	/// @returns the names of the source units flagged by the last call to markDirtySince().
+	std::set<std::string> const& dirtySourceUnits() const noexcept { return m_dirtySourceUnits; }
+
+	/// @returns the content of the file at @a _path. Files that were read before are only read
+	/// again if their size or modification time changed.
+	std::string readFromDisk(boost::filesystem::path const& _path);
+
+	/// Takes over the contents of the files that @a _previous read from disk.
+	void takeFileCacheFrom(FileRepository& _previous) { m_fileCache = std::move(_previous.m_fileCache); }
+
 private:
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
@@ -69,6 +89,24 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	/// Source units loaded from disk by the read callback.
+	std::set<std::string> m_importedSourceUnits;
+
+	/// Source units the read callback failed to resolve.
+	std::set<std::string> m_unresolvedSourceUnits;
+
+	/// Source units that changed relative to the repository passed to markDirtySince().
+	std::set<std::string> m_dirtySourceUnits;
+
+	struct CachedFile
+	{
+		std::time_t lastWriteTime;
+		uintmax_t size;
+		std::string content;
+	};
+	/// Contents of the files read from disk by their path.
+	std::map<boost::filesystem::path, CachedFile> m_fileCache;
 };
 
 }
@@ -30,12 +30,15 @@
 #include <libhyperion/lsp/RenameSymbol.h>
 #include <libhyperion/lsp/SemanticTokensBuilder.h>
 
+#include <libyul/YulString.h>
+
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
 
 #include <libhyputil/CommonIO.h>
 #include <libhyputil/Visitor.h>
 #include <libhyputil/JSON.h>
+#include <libhyputil/StringUtils.h>
 
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/filesystem.hpp>
@@ -188,6 +191,7 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	m_recompilationRequired = true;
 	Json::Value jsonIncludePaths = _settings["include-paths"];
 
 	if (jsonIncludePaths)
@@ -242,6 +246,7 @@ void LanguageServer::compile()
 
 	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
 	std::swap(oldRepository, m_fileRepository);
+	m_fileRepository.takeFileCacheFrom(oldRepository);
 
 	// Load all hyperion files from project.
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
@@ -250,7 +255,7 @@ void LanguageServer::compile()
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
 			m_fileRepository.setSourceByUri(
 				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+				m_fileRepository.readFromDisk(projectFile)
 			);
 		}
 
@@ -261,11 +266,33 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
-
-	m_compilerStack.reset(false);
+	m_fileRepository.markDirtySince(oldRepository);
+	if (!m_recompilationRequired && m_fileRepository.dirtySourceUnits().empty())
+	{
+		// Nothing changed, so keep the previous results along with the sources loaded on import.
+		oldRepository.takeFileCacheFrom(m_fileRepository);
+		std::swap(oldRepository, m_fileRepository);
+		return;
+	}
+	lspDebug(fmt::format(
+		"recompiling, dirty source units: {}",
+		util::joinHumanReadable(m_fileRepository.dirtySourceUnits())
+	));
+
+	// Sources whose content did not change are not parsed again, but all sources are analysed again.
+	// Their inline assembly blocks refer to YulStrings, so they have to be dropped to release the strings.
+	// No other YulString outlives a compilation.
+	if (yul::YulStringRepository::instance().arenaCapacity() > YulStringLimit)
+	{
+		lspDebug("releasing Yul identifiers, all source units are parsed again");
+		m_compilerStack.reset(false);
+		yul::YulStringRepository::reset();
+	}
+	else
+		m_compilerStack.resetKeepingParsedSources(false);
 	m_compilerStack.setSources(m_fileRepository.sourceUnits());
 	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	m_recompilationRequired = false;
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
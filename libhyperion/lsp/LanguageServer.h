@@ -61,6 +61,10 @@ enum class FileLoadStrategy
 class LanguageServer
 {
 public:
+	/// Size of the arenas of the YulString repository in bytes above which it is reset before
+	/// the next compilation.
+	static size_t constexpr YulStringLimit = 64 * 1024 * 1024;
+
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
 
@@ -100,6 +104,9 @@ private:
 	void changeConfiguration(Json::Value const&);
 
 	/// Compile everything until after analysis phase.
+	/// Keeps the results of the previous compilation if no source unit is dirty and the
+	/// configuration did not change since. Resets the YulString repository if it exceeds
+	/// YulStringLimit, in which case all sources are parsed again.
 	void compile();
 
 	std::vector<boost::filesystem::path> allHyperionFilesFromProject() const;
@@ -125,6 +132,8 @@ private:
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
 	frontend::CompilerStack m_compilerStack;
+	/// Set until the first compilation and whenever the configuration changes.
+	bool m_recompilationRequired = true;
 
 	/// User-supplied custom configuration settings (such as QRVM version).
 	Json::Value m_settingsObject;
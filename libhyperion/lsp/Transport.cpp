@@ -27,6 +27,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -35,6 +36,10 @@
 #if defined(_WIN32)
 #include <io.h>
 #include <fcntl.h>
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <cerrno>
 #endif
 
 using namespace hyperion::lsp;
@@ -221,3 +226,112 @@ void StdioTransport::flushOutput()
 	fflush(stdout);
 }
 // }}}
+
+// {{{ SocketTransport
+namespace
+{
+#if defined(MSG_NOSIGNAL)
+int constexpr c_sendFlags = MSG_NOSIGNAL;
+#else
+int constexpr c_sendFlags = 0;
+#endif
+}
+
+SocketTransport::SocketTransport(int _fileDescriptor):
+	m_fileDescriptor{_fileDescriptor}
+{
+#if defined(SO_NOSIGPIPE)
+	// Platforms without MSG_NOSIGNAL suppress SIGPIPE per socket instead.
+	int const enabled = 1;
+	::setsockopt(m_fileDescriptor, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+}
+
+bool SocketTransport::closed() const noexcept
+{
+	return m_closed && m_inputBuffer.empty();
+}
+
+bool SocketTransport::fillInputBuffer()
+{
+	if (m_closed)
+		return false;
+
+#if defined(_WIN32)
+	m_closed = true;
+	return false;
+#else
+	char chunk[4096];
+	ssize_t received = 0;
+	do
+		received = ::recv(m_fileDescriptor, chunk, sizeof(chunk), 0);
+	while (received < 0 && errno == EINTR);
+
+	if (received <= 0)
+	{
+		m_closed = true;
+		return false;
+	}
+	m_inputBuffer.append(chunk, static_cast<size_t>(received));
+	return true;
+#endif
+}
+
+std::string SocketTransport::readBytes(size_t _byteCount)
+{
+	while (m_inputBuffer.size() < _byteCount && fillInputBuffer())
+		;
+
+	size_t const length = std::min(_byteCount, m_inputBuffer.size());
+	std::string data = m_inputBuffer.substr(0, length);
+	m_inputBuffer.erase(0, length);
+	return data;
+}
+
+std::string SocketTransport::getline()
+{
+	size_t searchFrom = 0;
+	size_t newlinePos = m_inputBuffer.find('\n');
+	while (newlinePos == std::string::npos)
+	{
+		searchFrom = m_inputBuffer.size();
+		if (!fillInputBuffer())
+		{
+			std::string line = std::move(m_inputBuffer);
+			m_inputBuffer.clear();
+			return line;
+		}
+		newlinePos = m_inputBuffer.find('\n', searchFrom);
+	}
+
+	std::string line = m_inputBuffer.substr(0, newlinePos);
+	m_inputBuffer.erase(0, newlinePos + 1);
+	return line;
+}
+
+void SocketTransport::writeBytes(std::string_view _data)
+{
+	m_outputBuffer.append(_data.data(), _data.size());
+}
+
+void SocketTransport::flushOutput()
+{
+#if !defined(_WIN32)
+	std::string_view pending = m_outputBuffer;
+	while (!pending.empty())
+	{
+		// A peer that disconnected before reading its reply must not raise SIGPIPE.
+		ssize_t const sent = ::send(m_fileDescriptor, pending.data(), pending.size(), c_sendFlags);
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent <= 0)
+		{
+			m_closed = true;
+			break;
+		}
+		pending.remove_prefix(static_cast<size_t>(sent));
+	}
+#endif
+	m_outputBuffer.clear();
+}
+// }}}
@@ -180,4 +180,32 @@ protected:
 	void flushOutput() override;
 };
 
+/**
+ * Transport layer communicating over a connected stream socket, for example one end of
+ * a Unix domain socket connection. The file descriptor is not owned by the transport.
+ */
+class SocketTransport: public Transport
+{
+public:
+	explicit SocketTransport(int _fileDescriptor);
+
+	bool closed() const noexcept override;
+
+protected:
+	std::string readBytes(size_t _byteCount) override;
+	std::string getline() override;
+	void writeBytes(std::string_view _data) override;
+	void flushOutput() override;
+
+private:
+	/// Appends the next chunk of data received from the socket to the input buffer.
+	/// @returns false if the peer closed the connection or reading failed.
+	bool fillInputBuffer();
+
+	int m_fileDescriptor;
+	std::string m_inputBuffer;
+	std::string m_outputBuffer;
+	bool m_closed = false;
+};
+
 }
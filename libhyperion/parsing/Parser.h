@@ -38,16 +38,28 @@ namespace hyperion::frontend
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @param _recordNodes whether to keep track of the created nodes, so that their IDs can be
+	/// changed via shiftNodeIDs.
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
-		langutil::QRVMVersion _qrvmVersion
+		langutil::QRVMVersion _qrvmVersion,
+		bool _recordNodes = false
 	):
 		ParserBase(_errorReporter),
-		m_qrvmVersion(_qrvmVersion)
+		m_qrvmVersion(_qrvmVersion),
+		m_recordNodes(_recordNodes)
 	{}
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// @returns the ID of the most recently created AST node. Node IDs are consecutive and start at one.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+
+	/// Adds @a _offset to the IDs of the recorded nodes that are still alive and forgets them.
+	/// The nodes then have the IDs they would have had if @a _offset IDs had been assigned
+	/// before. This allows parsing sources independently of each other.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -197,6 +209,19 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Creates a node and records it if requested in the constructor.
+	/// Recorded nodes are not allocated together with their control block, so that nodes
+	/// discarded during look-ahead are freed right away and not only once shiftNodeIDs releases
+	/// the weak reference.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> makeNode(Args&&... _args)
+	{
+		if (!m_recordNodes)
+			return std::make_shared<NodeType>(std::forward<Args>(_args)...);
+		ASTPointer<NodeType> node(new NodeType(std::forward<Args>(_args)...));
+		m_recordedNodes.emplace_back(node);
+		return node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -231,6 +256,9 @@ private:
 	langutil::QRVMVersion m_qrvmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_recordNodes = false;
+	/// Nodes created since the last call to shiftNodeIDs. Discarded ones are expired.
+	std::vector<std::weak_ptr<ASTNode>> m_recordedNodes;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalHyperionEnabledInCurrentSourceUnit = false;
 };
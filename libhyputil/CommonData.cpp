@@ -123,6 +123,60 @@ bytes hyperion::util::fromHex(std::string const& _s, WhenError _throw)
 	return ret;
 }
 
+namespace
+{
+char const* const base64Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+std::string hyperion::util::toBase64(std::string_view _data)
+{
+	std::string ret;
+	ret.reserve((_data.size() + 2) / 3 * 4);
+	for (size_t i = 0; i < _data.size(); i += 3)
+	{
+		size_t const count = std::min<size_t>(3, _data.size() - i);
+		uint32_t group = 0;
+		for (size_t j = 0; j < 3; ++j)
+			group = (group << 8) | (j < count ? static_cast<uint8_t>(_data[i + j]) : 0u);
+		for (size_t j = 0; j < 4; ++j)
+			ret.push_back(j <= count ? base64Alphabet[(group >> (18 - 6 * j)) & 0x3f] : '=');
+	}
+	return ret;
+}
+
+std::optional<std::string> hyperion::util::fromBase64(std::string_view _base64)
+{
+	if (_base64.size() % 4 != 0)
+		return std::nullopt;
+	std::string ret;
+	ret.reserve(_base64.size() / 4 * 3);
+	for (size_t i = 0; i < _base64.size(); i += 4)
+	{
+		size_t padding = 0;
+		if (i + 4 == _base64.size() && _base64[i + 3] == '=')
+			padding = _base64[i + 2] == '=' ? 2 : 1;
+		uint32_t group = 0;
+		for (size_t j = 0; j < 4; ++j)
+		{
+			uint32_t value = 0;
+			if (j < 4 - padding)
+			{
+				char const* position = std::strchr(base64Alphabet, _base64[i + j]);
+				if (_base64[i + j] == '\0' || !position)
+					return std::nullopt;
+				value = static_cast<uint32_t>(position - base64Alphabet);
+			}
+			group = (group << 6) | value;
+		}
+		// Bits that are dropped by the padding have to be zero, so that every encoding is unique.
+		if ((padding == 1 && (group & 0xff)) || (padding == 2 && (group & 0xffff)))
+			return std::nullopt;
+		for (size_t j = 0; j < 3 - padding; ++j)
+			ret.push_back(static_cast<char>((group >> (16 - 8 * j)) & 0xff));
+	}
+	return ret;
+}
+
 bool hyperion::util::passesAddressChecksum(std::string const& _str, bool _strict)
 {
 	if (_str.length() != 41 || !boost::starts_with(_str, "Q"))
@@ -32,6 +32,7 @@
 #include <cstring>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <set>
 #include <functional>
 #include <utility>
@@ -418,6 +419,14 @@ int fromHex(char _i, WhenError _throw);
 /// @example fromHex("41626261") == asBytes("Abba")
 /// If _throw = ThrowType::DontThrow, it replaces bad hex characters with 0's, otherwise it will throw an exception.
 bytes fromHex(std::string const& _s, WhenError _throw = WhenError::DontThrow);
+
+/// Converts binary data to base64 as defined in RFC 4648, with padding.
+std::string toBase64(std::string_view _data);
+
+/// Converts a base64 string as defined in RFC 4648, with padding, into the encoded data.
+/// @returns nullopt if @a _base64 is not a valid encoding.
+std::optional<std::string> fromBase64(std::string_view _base64);
+
 /// Converts byte array to a string containing the same (binary) data. Unless
 /// the byte array happens to contain ASCII data, this won't be printable.
 inline std::string asString(bytes const& _b)
@@ -22,10 +22,11 @@
 
 #include <libhyputil/JSON.h>
 
+#include <libhyputil/Assertions.h>
 #include <libhyputil/CommonIO.h>
+#include <libhyputil/Exceptions.h>
 
-#include <boost/algorithm/string/replace.hpp>
-
+#include <algorithm>
 #include <sstream>
 #include <map>
 #include <memory>
@@ -41,17 +42,6 @@ namespace hyperion::util
 namespace
 {
 
-/// StreamWriterBuilder that can be constructed with specific settings
-class StreamWriterBuilder: public Json::StreamWriterBuilder
-{
-public:
-	explicit StreamWriterBuilder(std::map<std::string, Json::Value> const& _settings)
-	{
-		for (auto const& iter: _settings)
-			this->settings_[iter.first] = iter.second;
-	}
-};
-
 /// CharReaderBuilder with strict-mode settings
 class StrictModeCharReaderBuilder: public Json::CharReaderBuilder
 {
@@ -62,18 +52,6 @@ public:
 	}
 };
 
-/// Serialise the JSON object (@a _input) with specific builder (@a _builder)
-/// \param _input JSON input string
-/// \param _builder StreamWriterBuilder that is used to create new Json::StreamWriter
-/// \return serialized json object
-std::string print(Json::Value const& _input, Json::StreamWriterBuilder const& _builder)
-{
-	std::stringstream stream;
-	std::unique_ptr<Json::StreamWriter> writer(_builder.newStreamWriter());
-	writer->write(_input, &stream);
-	return stream.str();
-}
-
 /// Parse a JSON string (@a _input) with specified builder (@ _builder) and writes resulting JSON object to (@a _json)
 /// \param _builder CharReaderBuilder that is used to create new Json::CharReaders
 /// \param _input JSON input string
@@ -86,6 +64,103 @@ bool parse(Json::CharReaderBuilder& _builder, std::string const& _input, Json::V
 	return reader->parse(_input.c_str(), _input.c_str() + _input.length(), &_json, _errs);
 }
 
+/// @returns the code point of the UTF-8 sequence starting at @a _position and advances @a _position
+/// to the last byte of the sequence. Invalid sequences are decoded exactly like jsoncpp does it.
+unsigned decodeCodePoint(char const*& _position, char const* _end)
+{
+	unsigned constexpr replacementCharacter = 0xFFFD;
+	auto byte = [&](size_t _offset) { return static_cast<unsigned>(static_cast<unsigned char>(_position[_offset])); };
+
+	unsigned const first = byte(0);
+	if (first < 0x80)
+		return first;
+	if (first < 0xE0)
+	{
+		if (_end - _position < 2)
+			return replacementCharacter;
+		unsigned const codePoint = ((first & 0x1F) << 6) | (byte(1) & 0x3F);
+		_position += 1;
+		return codePoint < 0x80 ? replacementCharacter : codePoint;
+	}
+	if (first < 0xF0)
+	{
+		if (_end - _position < 3)
+			return replacementCharacter;
+		unsigned const codePoint = ((first & 0x0F) << 12) | ((byte(1) & 0x3F) << 6) | (byte(2) & 0x3F);
+		_position += 2;
+		if (0xD800 <= codePoint && codePoint <= 0xDFFF)
+			return replacementCharacter;
+		return codePoint < 0x800 ? replacementCharacter : codePoint;
+	}
+	if (first < 0xF8)
+	{
+		if (_end - _position < 4)
+			return replacementCharacter;
+		unsigned const codePoint =
+			((first & 0x07) << 18) | ((byte(1) & 0x3F) << 12) | ((byte(2) & 0x3F) << 6) | (byte(3) & 0x3F);
+		_position += 3;
+		return codePoint < 0x10000 ? replacementCharacter : codePoint;
+	}
+	return replacementCharacter;
+}
+
+void appendEscapedCodeUnit(std::string& _result, unsigned _codeUnit)
+{
+	static char constexpr digits[] = "0123456789abcdef";
+	_result += "\\u";
+	for (int shift = 12; shift >= 0; shift -= 4)
+		_result += digits[(_codeUnit >> shift) & 0xF];
+}
+
+/// @returns @a _string as a quoted JSON string. Everything except printable ASCII characters
+/// is escaped, in the same way as by jsoncpp's writer.
+std::string quotedString(std::string_view _string)
+{
+	bool const needsEscaping = std::any_of(_string.begin(), _string.end(), [](char _c) {
+		unsigned char const byte = static_cast<unsigned char>(_c);
+		return _c == '\\' || _c == '"' || byte < 0x20 || byte > 0x7F;
+	});
+
+	std::string result;
+	result.reserve(_string.size() + 2);
+	result += '"';
+	if (!needsEscaping)
+		result += _string;
+	else
+	{
+		char const* end = _string.data() + _string.size();
+		for (char const* position = _string.data(); position != end; ++position)
+			switch (*position)
+			{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\b': result += "\\b"; break;
+			case '\f': result += "\\f"; break;
+			case '\n': result += "\\n"; break;
+			case '\r': result += "\\r"; break;
+			case '\t': result += "\\t"; break;
+			default:
+			{
+				unsigned codePoint = decodeCodePoint(position, end);
+				if (codePoint < 0x20 || (0x80 <= codePoint && codePoint < 0x10000))
+					appendEscapedCodeUnit(result, codePoint);
+				else if (codePoint < 0x80)
+					result += static_cast<char>(codePoint);
+				else
+				{
+					// Encoded as a surrogate pair.
+					codePoint -= 0x10000;
+					appendEscapedCodeUnit(result, 0xD800 + ((codePoint >> 10) & 0x3FF));
+					appendEscapedCodeUnit(result, 0xDC00 + (codePoint & 0x3FF));
+				}
+				break;
+			}
+			}
+	}
+	result += '"';
+	return result;
+}
+
 /// Takes a JSON value (@ _json) and removes all its members with value 'null' recursively.
 void removeNullMembersHelper(Json::Value& _json)
 {
@@ -123,19 +198,240 @@ std::string jsonCompactPrint(Json::Value const& _input)
 
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 {
-	std::map<std::string, Json::Value> settings;
-	if (_format.format == JsonFormat::Pretty)
+	std::ostringstream stream;
+	JsonWriter(stream, _format).write(_input);
+	return stream.str();
+}
+
+JsonWriter::JsonWriter(std::ostream& _stream, JsonFormat const& _format):
+	m_stream(_stream),
+	m_pretty(_format.format == JsonFormat::Pretty),
+	m_indentation(m_pretty ? std::string(_format.indent, ' ') : std::string{})
+{
+}
+
+void JsonWriter::write(Json::Value const& _value)
+{
+	beginValue();
+	writeValue(_value);
+	endValue();
+}
+
+void JsonWriter::beginObject()
+{
+	beginValue();
+	m_containers.emplace_back(true);
+}
+
+void JsonWriter::key(std::string const& _name)
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isObject, Exception, "Not inside of an object.");
+	Container& object = m_containers.back();
+	assertThrow(
+		!object.hasElements || object.lastKey < _name,
+		Exception,
+		"Object members have to be written in ascending order of their names."
+	);
+	openContainer();
+	if (object.hasElements)
+		output(",");
+	object.hasElements = true;
+	object.lastKey = _name;
+	writeKey(_name);
+}
+
+void JsonWriter::endObject()
+{
+	endContainer(true);
+}
+
+void JsonWriter::beginArray()
+{
+	beginValue();
+	m_containers.emplace_back(false);
+}
+
+void JsonWriter::endArray()
+{
+	endContainer(false);
+}
+
+void JsonWriter::writeBuffered(std::function<void(JsonWriter&)> const& _write)
+{
+	std::ostringstream buffer;
+	JsonWriter bufferedWriter(*this, buffer);
+	_write(bufferedWriter);
+	m_stream << buffer.str();
+	continueFrom(bufferedWriter);
+}
+
+JsonWriter::JsonWriter(JsonWriter const& _writer, std::ostream& _stream):
+	m_stream(_stream)
+{
+	continueFrom(_writer);
+}
+
+void JsonWriter::continueFrom(JsonWriter const& _writer)
+{
+	m_pretty = _writer.m_pretty;
+	m_indentation = _writer.m_indentation;
+	m_indentString = _writer.m_indentString;
+	m_indented = _writer.m_indented;
+	m_pendingSpace = _writer.m_pendingSpace;
+	m_containers = _writer.m_containers;
+}
+
+void JsonWriter::writeValue(Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		output("null");
+		break;
+	case Json::intValue:
+		output(Json::valueToString(_value.asLargestInt()));
+		break;
+	case Json::uintValue:
+		output(Json::valueToString(_value.asLargestUInt()));
+		break;
+	case Json::realValue:
+		output(Json::valueToString(_value.asDouble()));
+		break;
+	case Json::stringValue:
 	{
-		settings["indentation"] = std::string(_format.indent, ' ');
-		settings["enableYAMLCompatibility"] = true;
+		char const* begin = nullptr;
+		char const* end = nullptr;
+		_value.getString(&begin, &end);
+		output(quotedString(std::string_view(begin, static_cast<size_t>(end - begin))));
+		break;
 	}
+	case Json::booleanValue:
+		output(_value.asBool() ? "true" : "false");
+		break;
+	case Json::arrayValue:
+		if (_value.empty())
+			output("[]");
+		else
+		{
+			writeWithIndent("[");
+			m_indentString += m_indentation;
+			for (Json::ArrayIndex i = 0; i < _value.size(); ++i)
+			{
+				if (i > 0)
+					output(",");
+				if (!m_indented)
+					writeIndent();
+				m_indented = true;
+				writeValue(_value[i]);
+				m_indented = false;
+			}
+			m_indentString.resize(m_indentString.size() - m_indentation.size());
+			writeWithIndent("]");
+		}
+		break;
+	case Json::objectValue:
+		if (_value.empty())
+			output("{}");
+		else
+		{
+			writeWithIndent("{");
+			m_indentString += m_indentation;
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				if (it != _value.begin())
+					output(",");
+				char const* end = nullptr;
+				char const* name = it.memberName(&end);
+				writeKey(std::string_view(name, static_cast<size_t>(end - name)));
+				writeValue(*it);
+			}
+			m_indentString.resize(m_indentString.size() - m_indentation.size());
+			writeWithIndent("}");
+		}
+		break;
+	}
+}
+
+void JsonWriter::beginValue()
+{
+	if (m_containers.empty() || m_containers.back().isObject)
+		return;
+	Container& array = m_containers.back();
+	openContainer();
+	if (array.hasElements)
+		output(",");
+	array.hasElements = true;
+	if (!m_indented)
+		writeIndent();
+	m_indented = true;
+}
+
+void JsonWriter::endValue()
+{
+	if (!m_containers.empty() && !m_containers.back().isObject)
+		m_indented = false;
+}
+
+void JsonWriter::openContainer()
+{
+	Container& container = m_containers.back();
+	if (container.opened)
+		return;
+	container.opened = true;
+	writeWithIndent(container.isObject ? "{" : "[");
+	m_indentString += m_indentation;
+}
+
+void JsonWriter::endContainer(bool _isObject)
+{
+	assertThrow(
+		!m_containers.empty() && m_containers.back().isObject == _isObject,
+		Exception,
+		_isObject ? "Not inside of an object." : "Not inside of an array."
+	);
+	if (!m_containers.back().opened)
+		output(_isObject ? "{}" : "[]");
 	else
-		settings["indentation"] = "";
-	StreamWriterBuilder writerBuilder(settings);
-	std::string result = print(_input, writerBuilder);
-	if (_format.format == JsonFormat::Pretty)
-		boost::replace_all(result, " \n", "\n");
-	return result;
+	{
+		m_indentString.resize(m_indentString.size() - m_indentation.size());
+		writeWithIndent(_isObject ? "}" : "]");
+	}
+	m_containers.pop_back();
+	endValue();
+}
+
+void JsonWriter::writeKey(std::string_view _name)
+{
+	writeWithIndent(quotedString(_name));
+	output(":");
+	m_pendingSpace = m_pretty;
+}
+
+void JsonWriter::writeIndent()
+{
+	if (m_indentation.empty())
+		return;
+	// No trailing space after a colon at the end of the line.
+	m_pendingSpace = false;
+	m_stream << '\n' << m_indentString;
+}
+
+void JsonWriter::writeWithIndent(std::string_view _text)
+{
+	if (!m_indented)
+		writeIndent();
+	output(_text);
+	m_indented = false;
+}
+
+void JsonWriter::output(std::string_view _text)
+{
+	if (m_pendingSpace)
+	{
+		m_stream << ' ';
+		m_pendingSpace = false;
+	}
+	m_stream << _text;
 }
 
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs /* = nullptr */)
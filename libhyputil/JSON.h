@@ -25,9 +25,12 @@
 
 #include <json/json.h>
 
+#include <functional>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
+#include <vector>
 
 namespace hyperion::util
 {
@@ -62,6 +65,97 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 
+/**
+ * Receiver of a JSON document that is produced one value at a time, so that large documents
+ * do not have to be built as a Json::Value first. Members of objects are passed in ascending
+ * order of their names.
+ */
+class JsonOutput
+{
+public:
+	virtual ~JsonOutput() = default;
+
+	/// Writes @a _value as the next value.
+	virtual void write(Json::Value const& _value) = 0;
+
+	/// Starts an object as the next value. Each of its members is written as a call to key()
+	/// followed by the value.
+	virtual void beginObject() = 0;
+	/// Starts the member @a _name of the current object.
+	virtual void key(std::string const& _name) = 0;
+	virtual void endObject() = 0;
+
+	/// Starts an array as the next value. Its elements are the values written until endArray().
+	virtual void beginArray() = 0;
+	virtual void endArray() = 0;
+};
+
+/**
+ * Serialiser that writes JSON to a stream while the document is being produced.
+ *
+ * The output is identical to that of jsonPrint() for the same document and format. Since jsoncpp
+ * orders object members by name, the members of each object have to be written in ascending order
+ * of their names.
+ */
+class JsonWriter: public JsonOutput
+{
+public:
+	JsonWriter(std::ostream& _stream, JsonFormat const& _format);
+
+	void write(Json::Value const& _value) override;
+
+	void beginObject() override;
+	void key(std::string const& _name) override;
+	void endObject() override;
+
+	void beginArray() override;
+	void endArray() override;
+
+	/// Writes the next value by calling @a _write with a writer that buffers it. The value is only
+	/// passed on if @a _write returns, so that nothing is written if it throws.
+	void writeBuffered(std::function<void(JsonWriter&)> const& _write);
+
+private:
+	/// Creates a writer to @a _stream that continues where @a _writer left off.
+	JsonWriter(JsonWriter const& _writer, std::ostream& _stream);
+	/// Takes over the state of @a _writer, apart from the stream.
+	void continueFrom(JsonWriter const& _writer);
+
+	struct Container
+	{
+		explicit Container(bool _isObject): isObject(_isObject) {}
+
+		bool isObject;
+		/// Whether the opening bracket was written. This is delayed until the first element,
+		/// since empty containers are formatted differently.
+		bool opened = false;
+		bool hasElements = false;
+		std::string lastKey;
+	};
+
+	void writeValue(Json::Value const& _value);
+	/// Writes the separator and indentation that precede the next value.
+	void beginValue();
+	void endValue();
+	void openContainer();
+	void endContainer(bool _isObject);
+	void writeKey(std::string_view _name);
+	void writeIndent();
+	void writeWithIndent(std::string_view _text);
+	void output(std::string_view _text);
+
+	std::ostream& m_stream;
+	bool m_pretty = false;
+	/// Indentation per level, empty if the output consists of a single line.
+	std::string m_indentation;
+	std::string m_indentString;
+	/// Whether the current line is already indented. Follows the logic of jsoncpp's writer.
+	bool m_indented = true;
+	/// Whether the space after the last colon still has to be written. It is omitted at the end of a line.
+	bool m_pendingSpace = false;
+	std::vector<Container> m_containers;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -0,0 +1,153 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libhyputil/Assertions.h>
+#include <libhyputil/CommonData.h>
+#include <libhyputil/Exceptions.h>
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace hyperion::util
+{
+
+DEV_SIMPLE_EXCEPTION(BadJournaledMapCheckpoint);
+
+/**
+ * Map that records the previous values of all entries it modifies while a checkpoint is active.
+ *
+ * This allows joining the map with its own state at a checkpoint, i.e. removing every entry
+ * whose value differs from the one at the checkpoint, in time proportional to the number of
+ * modified keys instead of the size of the map. Checkpoints have to be joined in reverse order
+ * of their creation.
+ *
+ * @tparam Map the underlying map type, e.g. std::map or std::unordered_map.
+ */
+template<typename Map>
+class JournaledMap
+{
+public:
+	using key_type = typename Map::key_type;
+	using mapped_type = typename Map::mapped_type;
+
+	/// @returns the underlying map. It must not be modified directly.
+	Map const& data() const { return m_data; }
+	bool empty() const { return m_data.empty(); }
+	mapped_type const* valueOrNullptr(key_type const& _key) const { return util::valueOrNullptr(m_data, _key); }
+
+	void set(key_type const& _key, mapped_type _value)
+	{
+		auto [it, inserted] = m_data.try_emplace(_key, _value);
+		if (inserted)
+			record(_key, std::nullopt);
+		else if (it->second != _value)
+		{
+			record(_key, it->second);
+			it->second = std::move(_value);
+		}
+	}
+
+	void erase(key_type const& _key)
+	{
+		auto it = m_data.find(_key);
+		if (it != m_data.end())
+		{
+			record(_key, it->second);
+			m_data.erase(it);
+		}
+	}
+
+	/// Erases all entries for which @a _predicate returns true when called with key and value.
+	template<typename Predicate>
+	void eraseIf(Predicate&& _predicate)
+	{
+		for (auto it = m_data.begin(); it != m_data.end();)
+			if (_predicate(it->first, it->second))
+			{
+				record(it->first, it->second);
+				it = m_data.erase(it);
+			}
+			else
+				++it;
+	}
+
+	void clear()
+	{
+		if (m_activeCheckpoints > 0)
+			for (auto const& [key, value]: m_data)
+				m_journal.emplace_back(key, value);
+		m_data.clear();
+	}
+
+	/// Starts recording modifications.
+	/// @returns a checkpoint to be passed to joinWithCheckpoint.
+	size_t checkpoint()
+	{
+		++m_activeCheckpoints;
+		return m_journal.size();
+	}
+
+	/// Removes all entries whose value is different from or was absent at the point @a _checkpoint
+	/// was created and ends the recording started by it.
+	void joinWithCheckpoint(size_t _checkpoint)
+	{
+		assertThrow(
+			m_activeCheckpoints > 0 && _checkpoint <= m_journal.size(),
+			BadJournaledMapCheckpoint,
+			"Checkpoint joined twice or out of order."
+		);
+
+		// The first record of each key holds its value at the checkpoint.
+		std::map<key_type, std::optional<mapped_type>> valuesAtCheckpoint;
+		for (size_t i = _checkpoint; i < m_journal.size(); ++i)
+			valuesAtCheckpoint.try_emplace(m_journal[i].first, std::move(m_journal[i].second));
+		m_journal.resize(_checkpoint);
+		--m_activeCheckpoints;
+
+		for (auto& [key, valueAtCheckpoint]: valuesAtCheckpoint)
+		{
+			auto it = m_data.find(key);
+			bool unchanged = valueAtCheckpoint ? (it != m_data.end() && it->second == *valueAtCheckpoint) : it == m_data.end();
+			if (unchanged)
+				continue;
+			if (it != m_data.end())
+				m_data.erase(it);
+			// Only the net change since the checkpoint is relevant for enclosing checkpoints.
+			if (valueAtCheckpoint)
+				record(key, std::move(valueAtCheckpoint));
+		}
+	}
+
+private:
+	void record(key_type const& _key, std::optional<mapped_type> _oldValue)
+	{
+		if (m_activeCheckpoints > 0)
+			m_journal.emplace_back(_key, std::move(_oldValue));
+	}
+
+	Map m_data;
+	/// Keys modified while a checkpoint was active, together with their previous value.
+	std::vector<std::pair<key_type, std::optional<mapped_type>>> m_journal;
+	size_t m_activeCheckpoints = 0;
+};
+
+}
@@ -63,8 +63,12 @@ public:
 	{
 		this->m_value.swap(_other.m_value);
 		_other.m_value.reset();
+		return *this;
 	}
 
+	/// Drops the value, so that it is computed again on the next call to init().
+	void reset() { m_value.reset(); }
+
 	template<typename F>
 	value_type& init(F&& _fun)
 	{
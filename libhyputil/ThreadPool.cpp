@@ -0,0 +1,97 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyputil/ThreadPool.h>
+
+using namespace hyperion;
+using namespace hyperion::util;
+
+ThreadPool::ThreadPool(size_t _threads)
+{
+	m_workers.reserve(_threads);
+	for (size_t i = 0; i < _threads; ++i)
+		m_workers.emplace_back([this] { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_stateChanged.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+std::vector<std::exception_ptr> ThreadPool::parallelFor(
+	size_t _count,
+	std::function<void(size_t)> const& _task
+)
+{
+	std::vector<std::exception_ptr> failures(_count);
+	size_t pending = _count;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	// Queue in reverse at the front, so that the batch starts with index zero and is processed
+	// before any batch submitted earlier.
+	for (size_t index = _count; index > 0; --index)
+		m_tasks.emplace_front([&, index = index - 1]() {
+			try
+			{
+				_task(index);
+			}
+			catch (...)
+			{
+				failures[index] = std::current_exception();
+			}
+			std::lock_guard<std::mutex> taskLock(m_mutex);
+			--pending;
+			m_stateChanged.notify_all();
+		});
+	m_stateChanged.notify_all();
+
+	while (pending > 0)
+		if (!m_tasks.empty())
+			runQueuedTask(lock);
+		else
+			m_stateChanged.wait(lock, [&] { return pending == 0 || !m_tasks.empty(); });
+
+	return failures;
+}
+
+void ThreadPool::work()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_stateChanged.wait(lock, [&] { return m_stopping || !m_tasks.empty(); });
+		if (m_tasks.empty())
+			return;
+		runQueuedTask(lock);
+	}
+}
+
+void ThreadPool::runQueuedTask(std::unique_lock<std::mutex>& _lock)
+{
+	std::function<void()> task = std::move(m_tasks.front());
+	m_tasks.pop_front();
+	_lock.unlock();
+	task();
+	_lock.lock();
+}
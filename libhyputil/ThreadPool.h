@@ -0,0 +1,77 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-size pool of worker threads for running independent units of work.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hyperion::util
+{
+
+/**
+ * Fixed-size pool of worker threads.
+ *
+ * Work is submitted in batches via @a parallelFor, which blocks until the whole batch is done.
+ * While waiting, the calling thread executes queued tasks itself. The tasks of the most recently
+ * submitted batch are executed first, so a task can submit a nested batch to the same pool
+ * without starving it.
+ */
+class ThreadPool
+{
+public:
+	/// Creates a pool with @a _threads worker threads. Together with the thread calling
+	/// @a parallelFor, up to @a _threads + 1 tasks run concurrently.
+	explicit ThreadPool(size_t _threads);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Runs @a _task for every index in [0, @a _count) and waits until all of them have finished.
+	/// A task throwing an exception does not affect the other tasks.
+	/// @returns for each index the exception thrown by its task or a null pointer on success.
+	std::vector<std::exception_ptr> parallelFor(size_t _count, std::function<void(size_t)> const& _task);
+
+	/// @returns the number of worker threads.
+	size_t size() const { return m_workers.size(); }
+
+private:
+	void work();
+	/// Removes the first task from the queue and runs it with @a _lock released.
+	/// Requires the queue to be non-empty.
+	void runQueuedTask(std::unique_lock<std::mutex>& _lock);
+
+	std::mutex m_mutex;
+	/// Signalled whenever tasks are queued or finished and on shutdown.
+	std::condition_variable m_stateChanged;
+	std::deque<std::function<void()>> m_tasks;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+}
@@ -0,0 +1,148 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyputil/TimeReport.h>
+
+#include <algorithm>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace hyperion::util;
+
+namespace
+{
+
+/// Report and unit that the phases measured on this thread are recorded in.
+thread_local TimeReport* t_report = nullptr;
+thread_local std::string t_unit;
+
+std::optional<size_t> peakResidentSetSize()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return std::nullopt;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS and in kilobytes everywhere else.
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return std::nullopt;
+#endif
+}
+
+}
+
+TimeReport::ScopedUnit::ScopedUnit(TimeReport* _report, std::string _unit):
+	m_previousReport(t_report),
+	m_previousUnit(std::move(t_unit))
+{
+	t_report = _report;
+	t_unit = std::move(_unit);
+}
+
+TimeReport::ScopedUnit::~ScopedUnit()
+{
+	t_report = m_previousReport;
+	t_unit = std::move(m_previousUnit);
+}
+
+TimeReport::ScopedPhase::ScopedPhase(std::string_view _name, std::string_view _nameSuffix):
+	m_report(t_report)
+{
+	if (!m_report)
+		return;
+
+	m_unit = t_unit;
+	m_name.reserve(_name.size() + _nameSuffix.size());
+	m_name.append(_name).append(_nameSuffix);
+	m_report->begin(m_unit, m_name);
+	m_peakMemory = peakResidentSetSize();
+	m_start = Clock::now();
+}
+
+TimeReport::ScopedPhase::~ScopedPhase()
+{
+	if (!m_report)
+		return;
+
+	Clock::duration const wallTime = Clock::now() - m_start;
+	std::optional<size_t> peakMemoryGrowth;
+	if (std::optional<size_t> const peakMemory = peakResidentSetSize(); peakMemory && m_peakMemory)
+		peakMemoryGrowth = *peakMemory - std::min(*peakMemory, *m_peakMemory);
+	m_report->record(m_unit, m_name, wallTime, peakMemoryGrowth);
+}
+
+bool TimeReport::active() noexcept
+{
+	return t_report != nullptr;
+}
+
+TimeReport* TimeReport::current() noexcept
+{
+	return t_report;
+}
+
+std::string const& TimeReport::currentUnit() noexcept
+{
+	return t_unit;
+}
+
+std::map<std::string, std::vector<TimeReport::Phase>> TimeReport::phases() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_phases;
+}
+
+void TimeReport::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_phases.clear();
+}
+
+void TimeReport::begin(std::string const& _unit, std::string const& _name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<Phase>& phases = m_phases[_unit];
+	auto it = std::find_if(phases.begin(), phases.end(), [&](Phase const& _phase) { return _phase.name == _name; });
+	if (it == phases.end())
+		phases.push_back(Phase{_name, 0, {}, std::nullopt});
+}
+
+void TimeReport::record(
+	std::string const& _unit,
+	std::string const& _name,
+	Clock::duration _wallTime,
+	std::optional<size_t> _peakMemoryGrowth
+)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<Phase>& phases = m_phases[_unit];
+	auto it = std::find_if(phases.begin(), phases.end(), [&](Phase const& _phase) { return _phase.name == _name; });
+	if (it == phases.end())
+		it = phases.insert(phases.end(), Phase{_name, 0, {}, std::nullopt});
+
+	++it->count;
+	it->wallTime += _wallTime;
+	if (_peakMemoryGrowth)
+		it->peakMemoryGrowth = it->peakMemoryGrowth.value_or(0) + *_peakMemoryGrowth;
+}
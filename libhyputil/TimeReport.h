@@ -0,0 +1,134 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of wall time and memory usage of compilation phases.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hyperion::util
+{
+
+/**
+ * Report on the wall time and the growth of the peak resident set size of compilation phases.
+ *
+ * Phases are measured via @a ScopedPhase anywhere in the compiler and are recorded in the report
+ * and unit (e.g. a contract) that the current thread was assigned via @a ScopedUnit. If there is
+ * none, measuring a phase does nothing. Repeated phases of the same name and unit are accumulated.
+ *
+ * The peak resident set size is a property of the whole process, so its growth is only
+ * attributed accurately to a phase if no other phase runs concurrently.
+ */
+class TimeReport
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Phase
+	{
+		std::string name;
+		/// Number of times the phase was run.
+		size_t count = 0;
+		Clock::duration wallTime{};
+		/// Growth of the peak resident set size of the process in bytes, if the platform reports it.
+		std::optional<size_t> peakMemoryGrowth;
+	};
+
+	/// Records the phases measured on the current thread in the unit @a _unit of @a _report until
+	/// destroyed. If @a _report is null, phases are not recorded in the meantime.
+	class ScopedUnit
+	{
+	public:
+		ScopedUnit(TimeReport* _report, std::string _unit);
+		~ScopedUnit();
+
+		ScopedUnit(ScopedUnit const&) = delete;
+		ScopedUnit& operator=(ScopedUnit const&) = delete;
+
+	private:
+		TimeReport* m_previousReport;
+		std::string m_previousUnit;
+	};
+
+	/// Measures the lifetime of this object as the phase @a _name followed by @a _nameSuffix.
+	class ScopedPhase
+	{
+	public:
+		explicit ScopedPhase(std::string_view _name, std::string_view _nameSuffix = {});
+		~ScopedPhase();
+
+		ScopedPhase(ScopedPhase const&) = delete;
+		ScopedPhase& operator=(ScopedPhase const&) = delete;
+
+	private:
+		TimeReport* m_report;
+		std::string m_unit;
+		std::string m_name;
+		Clock::time_point m_start;
+		std::optional<size_t> m_peakMemory;
+	};
+
+	/// Measures consecutive phases, each of which ends when the next one begins.
+	class PhaseSequence
+	{
+	public:
+		void next(std::string_view _name) { m_current.reset(); m_current.emplace(_name); }
+		void end() { m_current.reset(); }
+
+	private:
+		std::optional<ScopedPhase> m_current;
+	};
+
+	/// @returns true if phases measured on the current thread are recorded.
+	static bool active() noexcept;
+	/// @returns the report that phases measured on the current thread are recorded in, if any.
+	/// Together with @a currentUnit, it allows continuing the recording on other threads.
+	static TimeReport* current() noexcept;
+	/// @returns the unit that phases measured on the current thread are recorded in.
+	static std::string const& currentUnit() noexcept;
+
+	/// @returns the recorded phases per unit in the order in which they were first started.
+	std::map<std::string, std::vector<Phase>> phases() const;
+
+	void clear();
+
+private:
+	/// Adds the phase @a _name to @a _unit unless it exists already, so that phases are listed
+	/// in the order of their first start instead of their first end.
+	void begin(std::string const& _unit, std::string const& _name);
+	void record(
+		std::string const& _unit,
+		std::string const& _name,
+		Clock::duration _wallTime,
+		std::optional<size_t> _peakMemoryGrowth
+	);
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::vector<Phase>> m_phases;
+};
+
+}
@@ -51,6 +51,9 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace hyperion;
 using namespace hyperion::langutil;
 
@@ -101,19 +104,14 @@ std::string CharStream::lineAtPosition(int _position) const
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = std::string::size_type;
-	using diff_type = std::string::difference_type;
-	size_type searchPosition = std::min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	std::vector<size_t> const& starts = lineStarts();
+	size_t searchPosition = std::min<size_t>(m_source.size(), size_t(_position));
+	// The line is the last one that starts at or before the position.
+	auto lineStart = std::prev(std::upper_bound(starts.begin(), starts.end(), searchPosition));
+	return LineColumn{
+		static_cast<int>(lineStart - starts.begin()),
+		static_cast<int>(searchPosition - *lineStart)
+	};
 }
 
 std::string_view CharStream::text(SourceLocation const& _location) const
@@ -146,12 +144,25 @@ std::string CharStream::singleLineSnippet(std::string const& _sourceCode, Source
 
 std::optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	if (_lineColumn.line < 0 || _lineColumn.column < 0)
+		return std::nullopt;
+
+	std::vector<size_t> const& starts = lineStarts();
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	if (line >= starts.size())
+		return std::nullopt;
+
+	// Excludes the linefeed that terminates the line.
+	size_t const endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	size_t const offset = starts[line] + static_cast<size_t>(_lineColumn.column);
+	if (offset > endOfLine)
+		return std::nullopt;
+	return static_cast<int>(offset);
 }
 
 std::optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
 {
-	if (_input.line < 0)
+	if (_input.line < 0 || _input.column < 0)
 		return std::nullopt;
 
 	size_t offset = 0;
@@ -172,3 +183,20 @@ std::optional<int> CharStream::translateLineColumnToPosition(std::string const&
 	return offset + static_cast<size_t>(_input.column);
 }
 
+std::vector<size_t> const& CharStream::lineStarts() const
+{
+	if (auto starts = std::atomic_load(&m_lineStarts))
+		return *starts;
+
+	auto starts = std::make_shared<std::vector<size_t>>();
+	starts->push_back(0);
+	for (size_t position = m_source.find('\n'); position != std::string::npos; position = m_source.find('\n', position + 1))
+		starts->push_back(position + 1);
+
+	// If another thread got there first, keep its table so that references to it stay valid.
+	std::shared_ptr<std::vector<size_t> const> computed = std::move(starts);
+	std::shared_ptr<std::vector<size_t> const> expected;
+	if (std::atomic_compare_exchange_strong(&m_lineStarts, &expected, computed))
+		return *computed;
+	return *expected;
+}
@@ -51,10 +51,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace hyperion::langutil
 {
@@ -103,12 +105,15 @@ public:
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
 	std::string lineAtPosition(int _position) const;
+	/// Translates an absolute position to line:column.
+	/// Runs in logarithmic time in the number of lines, apart from the first call, which has to
+	/// build the table of line starts.
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
 
 	/// Translates a line:column to the absolute position.
+	/// Uses the same table of line starts as translatePositionToLineColumn.
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
@@ -142,10 +147,18 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// @returns the offsets at which the lines of the source start, in ascending order.
+	/// The first entry is always zero. The table is built on first use and may be requested
+	/// concurrently from several threads.
+	std::vector<size_t> const& lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
+	/// Lazily computed result of lineStarts(). Only accessed atomically and never replaced once set,
+	/// since the source does not change.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -0,0 +1,263 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <liblangutil/CharacterRuns.h>
+
+#include <liblangutil/Common.h>
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HYPERION_CHARACTER_RUNS_AVX2 1
+#define HYPERION_CHARACTER_RUNS_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+// MSVC does not define __SSE2__, but SSE2 is always available on x64.
+#include <emmintrin.h>
+#define HYPERION_CHARACTER_RUNS_SSE2 1
+#define HYPERION_CHARACTER_RUNS_SIMD 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace hyperion;
+using namespace hyperion::langutil;
+
+namespace
+{
+
+#if defined(HYPERION_CHARACTER_RUNS_AVX2)
+/// Byte-wise operations on blocks of 32 bytes. Comparisons yield 0xff for true and 0x00 for false.
+struct Simd
+{
+	using Vector = __m256i;
+	static size_t constexpr width = 32;
+
+	static Vector load(char const* _data) { return _mm256_loadu_si256(reinterpret_cast<Vector const*>(_data)); }
+	static Vector splat(uint8_t _byte) { return _mm256_set1_epi8(static_cast<char>(_byte)); }
+	static Vector equal(Vector _bytes, uint8_t _byte) { return _mm256_cmpeq_epi8(_bytes, splat(_byte)); }
+	/// Unsigned range check: _low <= x <= _high iff max(x, _low) == x and min(x, _high) == x.
+	static Vector inRange(Vector _bytes, uint8_t _low, uint8_t _high)
+	{
+		return _mm256_and_si256(
+			_mm256_cmpeq_epi8(_mm256_max_epu8(_bytes, splat(_low)), _bytes),
+			_mm256_cmpeq_epi8(_mm256_min_epu8(_bytes, splat(_high)), _bytes)
+		);
+	}
+	static Vector either(Vector _a, Vector _b) { return _mm256_or_si256(_a, _b); }
+	static Vector butNot(Vector _a, Vector _b) { return _mm256_andnot_si256(_b, _a); }
+	static Vector invert(Vector _a) { return _mm256_xor_si256(_a, splat(0xff)); }
+	/// @returns a bit mask with bit i set iff byte i of @a _a is non-zero.
+	static uint32_t mask(Vector _a) { return static_cast<uint32_t>(_mm256_movemask_epi8(_a)); }
+};
+#elif defined(HYPERION_CHARACTER_RUNS_SSE2)
+/// Byte-wise operations on blocks of 16 bytes. Comparisons yield 0xff for true and 0x00 for false.
+struct Simd
+{
+	using Vector = __m128i;
+	static size_t constexpr width = 16;
+
+	static Vector load(char const* _data) { return _mm_loadu_si128(reinterpret_cast<Vector const*>(_data)); }
+	static Vector splat(uint8_t _byte) { return _mm_set1_epi8(static_cast<char>(_byte)); }
+	static Vector equal(Vector _bytes, uint8_t _byte) { return _mm_cmpeq_epi8(_bytes, splat(_byte)); }
+	/// Unsigned range check: _low <= x <= _high iff max(x, _low) == x and min(x, _high) == x.
+	static Vector inRange(Vector _bytes, uint8_t _low, uint8_t _high)
+	{
+		return _mm_and_si128(
+			_mm_cmpeq_epi8(_mm_max_epu8(_bytes, splat(_low)), _bytes),
+			_mm_cmpeq_epi8(_mm_min_epu8(_bytes, splat(_high)), _bytes)
+		);
+	}
+	static Vector either(Vector _a, Vector _b) { return _mm_or_si128(_a, _b); }
+	static Vector butNot(Vector _a, Vector _b) { return _mm_andnot_si128(_b, _a); }
+	static Vector invert(Vector _a) { return _mm_xor_si128(_a, splat(0xff)); }
+	/// @returns a bit mask with bit i set iff byte i of @a _a is non-zero.
+	static uint32_t mask(Vector _a) { return static_cast<uint32_t>(_mm_movemask_epi8(_a)); }
+};
+#endif
+
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+/// @returns the index of the least significant set bit of @a _value, which must not be zero.
+size_t countTrailingZeros(uint32_t _value)
+{
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward(&index, _value);
+	return static_cast<size_t>(index);
+#else
+	return static_cast<size_t>(__builtin_ctz(_value));
+#endif
+}
+#endif
+
+/// Each character class defines which bytes it accepts, once for a single byte and,
+/// if SIMD is available, once for a block of bytes. Both definitions have to agree.
+
+struct WhiteSpace
+{
+	bool accepts(char _c) const { return isWhiteSpace(_c); }
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+	Simd::Vector accepts(Simd::Vector _bytes) const
+	{
+		return Simd::either(
+			Simd::either(Simd::equal(_bytes, ' '), Simd::equal(_bytes, '\n')),
+			Simd::either(Simd::equal(_bytes, '\t'), Simd::equal(_bytes, '\r'))
+		);
+	}
+#endif
+};
+
+struct IdentifierPart
+{
+	bool allowDot;
+
+	bool accepts(char _c) const { return isIdentifierPart(_c) || (allowDot && _c == '.'); }
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+	Simd::Vector accepts(Simd::Vector _bytes) const
+	{
+		Simd::Vector result = Simd::either(
+			Simd::either(Simd::inRange(_bytes, 'a', 'z'), Simd::inRange(_bytes, 'A', 'Z')),
+			Simd::either(Simd::inRange(_bytes, '0', '9'), Simd::either(Simd::equal(_bytes, '_'), Simd::equal(_bytes, '$')))
+		);
+		if (allowDot)
+			result = Simd::either(result, Simd::equal(_bytes, '.'));
+		return result;
+	}
+#endif
+};
+
+/// Bytes that may start a line break, see Scanner::isUnicodeLinebreak.
+bool isLineBreakLead(char _c)
+{
+	uint8_t const byte = static_cast<uint8_t>(_c);
+	return (0x0a <= byte && byte <= 0x0d) || byte == 0xc2 || byte == 0xe2;
+}
+
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+Simd::Vector lineBreakLeads(Simd::Vector _bytes)
+{
+	return Simd::either(
+		Simd::inRange(_bytes, 0x0a, 0x0d),
+		Simd::either(Simd::equal(_bytes, 0xc2), Simd::equal(_bytes, 0xe2))
+	);
+}
+#endif
+
+struct NonLineBreak
+{
+	bool accepts(char _c) const { return !isLineBreakLead(_c); }
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+	Simd::Vector accepts(Simd::Vector _bytes) const { return Simd::invert(lineBreakLeads(_bytes)); }
+#endif
+};
+
+struct MultiLineComment
+{
+	bool accepts(char _c) const { return _c != '*' && _c != '\n' && _c != '\r'; }
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+	Simd::Vector accepts(Simd::Vector _bytes) const
+	{
+		return Simd::invert(Simd::either(
+			Simd::equal(_bytes, '*'),
+			Simd::either(Simd::equal(_bytes, '\n'), Simd::equal(_bytes, '\r'))
+		));
+	}
+#endif
+};
+
+struct StringBody
+{
+	char quote;
+	bool isUnicode;
+
+	bool accepts(char _c) const
+	{
+		if (_c == quote || _c == '\\')
+			return false;
+		if (isUnicode)
+			return !isLineBreakLead(_c);
+		return 0x20 <= static_cast<uint8_t>(_c) && static_cast<uint8_t>(_c) <= 0x7e;
+	}
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+	Simd::Vector accepts(Simd::Vector _bytes) const
+	{
+		Simd::Vector const delimiters = Simd::either(
+			Simd::equal(_bytes, static_cast<uint8_t>(quote)),
+			Simd::equal(_bytes, '\\')
+		);
+		if (isUnicode)
+			return Simd::invert(Simd::either(delimiters, lineBreakLeads(_bytes)));
+		return Simd::butNot(Simd::inRange(_bytes, 0x20, 0x7e), delimiters);
+	}
+#endif
+};
+
+template <class CharacterClass>
+size_t runLength(std::string_view _text, CharacterClass const& _class)
+{
+	size_t position = 0;
+#ifdef HYPERION_CHARACTER_RUNS_SIMD
+	uint32_t constexpr fullMask = static_cast<uint32_t>((uint64_t(1) << Simd::width) - 1);
+	for (; position + Simd::width <= _text.size(); position += Simd::width)
+		if (uint32_t const rejected = ~Simd::mask(_class.accepts(Simd::load(_text.data() + position))) & fullMask)
+			return position + countTrailingZeros(rejected);
+#endif
+	while (position < _text.size() && _class.accepts(_text[position]))
+		++position;
+	return position;
+}
+
+}
+
+size_t hyperion::langutil::whiteSpaceRunLength(std::string_view _text)
+{
+	return runLength(_text, WhiteSpace{});
+}
+
+size_t hyperion::langutil::identifierPartRunLength(std::string_view _text, bool _allowDot)
+{
+	return runLength(_text, IdentifierPart{_allowDot});
+}
+
+size_t hyperion::langutil::nonLineBreakRunLength(std::string_view _text)
+{
+	return runLength(_text, NonLineBreak{});
+}
+
+size_t hyperion::langutil::multiLineCommentRunLength(std::string_view _text)
+{
+	return runLength(_text, MultiLineComment{});
+}
+
+size_t hyperion::langutil::stringRunLength(std::string_view _text, char _quote, bool _isUnicode)
+{
+	return runLength(_text, StringBody{_quote, _isUnicode});
+}
+
+char const* hyperion::langutil::characterRunInstructionSet()
+{
+#if defined(HYPERION_CHARACTER_RUNS_AVX2)
+	return "AVX2";
+#elif defined(HYPERION_CHARACTER_RUNS_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
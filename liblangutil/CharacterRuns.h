@@ -0,0 +1,57 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Block-wise search for runs of characters the scanner can consume without looking at them
+ * one by one.
+ *
+ * Each function returns the length of the longest prefix of its argument that consists only
+ * of characters of a given class. Depending on the target, blocks of 32 (AVX2) or 16 (SSE2)
+ * bytes are classified at once; the remainder and other targets use the scalar definition.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace hyperion::langutil
+{
+
+/// @returns the length of the prefix of @a _text that consists of whitespace as defined by isWhiteSpace.
+size_t whiteSpaceRunLength(std::string_view _text);
+
+/// @returns the length of the prefix of @a _text that consists of identifier parts as defined by
+/// isIdentifierPart and, if @a _allowDot is set, dots.
+size_t identifierPartRunLength(std::string_view _text, bool _allowDot);
+
+/// @returns the length of the prefix of @a _text that contains no line terminator (0x0a to 0x0d)
+/// and no lead byte (0xc2 or 0xe2) of the UTF-8 encoding of NEL, LS or PS.
+size_t nonLineBreakRunLength(std::string_view _text);
+
+/// @returns the length of the prefix of @a _text that contains neither '*', '\n' nor '\r'.
+size_t multiLineCommentRunLength(std::string_view _text);
+
+/// @returns the length of the prefix of @a _text that contains neither @a _quote nor a backslash and
+/// that, for non-unicode strings, only consists of printable ASCII characters or, for unicode strings,
+/// does not contain anything nonLineBreakRunLength stops at.
+size_t stringRunLength(std::string_view _text, char _quote, bool _isUnicode);
+
+/// @returns the name of the instruction set the functions above use, i.e. "AVX2", "SSE2" or "scalar".
+char const* characterRunInstructionSet();
+
+}
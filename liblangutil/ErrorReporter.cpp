@@ -134,6 +134,34 @@ ErrorList const& ErrorReporter::errors() const
 	return m_errorList;
 }
 
+bool ErrorReporter::appendWithinLimits(ErrorList const& _errorList)
+{
+	unsigned errors = 0;
+	unsigned warnings = 0;
+	unsigned infos = 0;
+	for (auto const& error: _errorList)
+		if (error->type() == Error::Type::Warning)
+			++warnings;
+		else if (error->type() == Error::Type::Info)
+			++infos;
+		else
+			++errors;
+
+	// Mirrors the conditions in checkForExcessiveErrors.
+	if (
+		m_warningCount + warnings >= c_maxWarningsAllowed ||
+		m_infoCount + infos >= c_maxInfosAllowed ||
+		m_errorCount + errors > c_maxErrorsAllowed
+	)
+		return false;
+
+	m_errorCount += errors;
+	m_warningCount += warnings;
+	m_infoCount += infos;
+	m_errorList += _errorList;
+	return true;
+}
+
 void ErrorReporter::clear()
 {
 	m_errorList.clear();
@@ -53,6 +53,12 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends errors that were reported to a different reporter and counts them as if they
+	/// had been reported here.
+	/// @returns false, without appending anything, if this would reach one of the limits on the
+	/// number of reported errors, i.e. if reporting them here would have had a different effect.
+	bool appendWithinLimits(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
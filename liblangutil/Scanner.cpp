@@ -50,6 +50,7 @@
  * Hyperion scanner.
  */
 
+#include <liblangutil/CharacterRuns.h>
 #include <liblangutil/Common.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
@@ -191,6 +192,18 @@ std::optional<unsigned> Scanner::scanUnicode()
 	return x;
 }
 
+void Scanner::addLiteralCharsAndAdvance(size_t _length)
+{
+	m_tokens[NextNext].literal.append(remainingSource().substr(0, _length));
+	skip(_length);
+}
+
+void Scanner::addCommentLiteralCharsAndAdvance(size_t _length)
+{
+	m_skippedComments[NextNext].literal.append(remainingSource().substr(0, _length));
+	skip(_length);
+}
+
 // This supports codepoints between 0000 and FFFF.
 void Scanner::addUnicodeAsUTF8(unsigned codepoint)
 {
@@ -249,8 +262,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
+	// m_char is not necessarily the character at the current position (see skipMultiLineComment),
+	// so consume it on its own before skipping the rest of the run.
 	while (isWhiteSpace(m_char))
+	{
 		advance();
+		skip(whiteSpaceRunLength(remainingSource()));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -288,7 +306,13 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All sequences start with 0xE2, so only positions holding that byte need to be checked.
+	std::string const& source = _stream.source();
+	for (
+		size_t currentPos = source.find('\xE2', _startPosition);
+		currentPos < endPosition;
+		currentPos = source.find('\xE2', currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -313,8 +337,11 @@ Token Scanner::skipSingleLineComment()
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
 	while (!isUnicodeLinebreak())
+	{
 		if (!advance())
 			break;
+		skip(nonLineBreakRunLength(remainingSource()));
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -384,6 +411,12 @@ size_t Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+		if (size_t const length = nonLineBreakRunLength(remainingSource()))
+		{
+			// Same as going through the loop for each of these characters.
+			endPosition = m_source.position() + length - 1;
+			addCommentLiteralCharsAndAdvance(length);
+		}
 	}
 	literal.complete();
 	return endPosition;
@@ -409,6 +442,8 @@ Token Scanner::skipMultiLineComment()
 			m_char = ' ';
 			return Token::Whitespace;
 		}
+		if (m_char != '*')
+			skip(multiLineCommentRunLength(remainingSource()));
 	}
 	// Unterminated multi-line comment.
 	return setError(ScannerError::IllegalCommentTerminator);
@@ -461,6 +496,7 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		addCommentLiteralCharsAndAdvance(multiLineCommentRunLength(remainingSource()));
 	}
 	literal.complete();
 	if (!endFound)
@@ -837,6 +873,13 @@ Token Scanner::scanString(bool const _isUnicode)
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		if (size_t const length = stringRunLength(remainingSource(), quote, _isUnicode))
+		{
+			// Plain characters that are added to the literal as they are.
+			addLiteralCharsAndAdvance(length);
+			continue;
+		}
+
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -1053,8 +1096,7 @@ std::tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	addLiteralCharsAndAdvance(identifierPartRunLength(remainingSource(), m_kind == ScannerKind::Yul));
 	literal.complete();
 
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
@@ -58,6 +58,7 @@
 
 #include <optional>
 #include <iosfwd>
+#include <string_view>
 
 namespace hyperion::langutil
 {
@@ -200,10 +201,17 @@ private:
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Appends the next @a _length characters of the source to the literal and advances past them.
+	void addLiteralCharsAndAdvance(size_t _length);
+	/// Appends the next @a _length characters of the source to the comment literal and advances past them.
+	void addCommentLiteralCharsAndAdvance(size_t _length);
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
 	bool advance() { m_char = m_source.advanceAndGet(); return !m_source.isPastEndOfInput(); }
+	/// Advances by @a _amount characters, which must not go past the end of the input.
+	/// Only valid if m_char is the character at the current source position.
+	void skip(size_t _amount) { if (_amount > 0) m_char = m_source.advanceAndGet(_amount); }
 	void rollback(size_t _amount) { m_char = m_source.rollback(_amount); }
 	/// Rolls back to the start of the current token and re-runs the scanner.
 	void rescan();
@@ -255,6 +263,8 @@ private:
 
 	/// Return the current source position.
 	size_t sourcePos() const { return m_source.position(); }
+	/// @returns the source from the current position to the end of the input.
+	std::string_view remainingSource() const { return std::string_view(m_source.source()).substr(sourcePos()); }
 	bool isSourcePastEndOfInput() const { return m_source.isPastEndOfInput(); }
 
 	enum TokenIndex { Current, Next, NextNext };
@@ -41,6 +41,8 @@ public:
 	virtual std::string const* runtimeSourceMapping(std::string const& _contractName) const = 0;
 
 	virtual Json::Value assemblyJSON(std::string const& _contractName) const = 0;
+	/// Writes the same representation as assemblyJSON() to @a _writer without building it in memory.
+	virtual void assemblyJSON(std::string const& _contractName, util::JsonWriter& _writer) const = 0;
 	virtual std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes) const = 0;
 
 	virtual std::string const filesystemFriendlyName(std::string const& _contractName) const = 0;
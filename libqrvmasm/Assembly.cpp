@@ -36,17 +36,22 @@
 
 #include <libhyputil/JSON.h>
 #include <libhyputil/StringUtils.h>
+#include <libhyputil/ThreadPool.h>
+#include <libhyputil/TimeReport.h>
 
 #include <fmt/format.h>
 
+#include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/drop_exactly.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/map.hpp>
 
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <iterator>
+#include <variant>
 
 using namespace hyperion;
 using namespace hyperion::qrvmasm;
@@ -428,59 +433,83 @@ std::string Assembly::assemblyString(
 	return tmp.str();
 }
 
+std::vector<Json::Value> Assembly::assemblyItemJSON(
+	AssemblyItem const& _item,
+	std::map<std::string, unsigned> const& _sourceIndices
+) const
+{
+	int sourceIndex = -1;
+	if (_item.location().sourceName)
+	{
+		auto iter = _sourceIndices.find(*_item.location().sourceName);
+		if (iter != _sourceIndices.end())
+			sourceIndex = static_cast<int>(iter->second);
+	}
+
+	std::vector<Json::Value> result;
+	auto [name, data] = _item.nameAndData();
+	Json::Value jsonItem;
+	jsonItem["name"] = name;
+	jsonItem["begin"] = _item.location().start;
+	jsonItem["end"] = _item.location().end;
+	if (_item.m_modifierDepth != 0)
+		jsonItem["modifierDepth"] = static_cast<int>(_item.m_modifierDepth);
+	std::string jumpType = _item.getJumpTypeAsString();
+	if (!jumpType.empty())
+		jsonItem["jumpType"] = jumpType;
+	if (name == "PUSHLIB")
+		data = m_libraries.at(h256(data));
+	else if (name == "PUSHIMMUTABLE" || name == "ASSIGNIMMUTABLE")
+		data = m_immutables.at(h256(data));
+	if (!data.empty())
+		jsonItem["value"] = data;
+	jsonItem["source"] = sourceIndex;
+	result.emplace_back(std::move(jsonItem));
+
+	if (_item.type() == AssemblyItemType::Tag)
+	{
+		Json::Value jumpdest;
+		jumpdest["name"] = "JUMPDEST";
+		jumpdest["begin"] = _item.location().start;
+		jumpdest["end"] = _item.location().end;
+		jumpdest["source"] = sourceIndex;
+		if (_item.m_modifierDepth != 0)
+			jumpdest["modifierDepth"] = static_cast<int>(_item.m_modifierDepth);
+		result.emplace_back(std::move(jumpdest));
+	}
+	return result;
+}
+
+Json::Value Assembly::sourceListJSON(std::map<std::string, unsigned> const& _sourceIndices)
+{
+	Json::Value jsonSourceList = Json::arrayValue;
+	for (auto const& [name, index]: _sourceIndices)
+		jsonSourceList[index] = name;
+	return jsonSourceList;
+}
+
+std::string Assembly::dataKeyJSON(h256 const& _hash)
+{
+	return util::toHex(toBigEndian((u256)_hash), util::HexPrefix::DontAdd, util::HexCase::Upper);
+}
+
+std::string Assembly::subKeyJSON(size_t _subIndex)
+{
+	std::stringstream hexStr;
+	hexStr << std::hex << _subIndex;
+	return hexStr.str();
+}
+
 Json::Value Assembly::assemblyJSON(std::map<std::string, unsigned> const& _sourceIndices, bool _includeSourceList) const
 {
 	Json::Value root;
 	root[".code"] = Json::arrayValue;
 	Json::Value& code = root[".code"];
 	for (AssemblyItem const& item: m_items)
-	{
-		int sourceIndex = -1;
-		if (item.location().sourceName)
-		{
-			auto iter = _sourceIndices.find(*item.location().sourceName);
-			if (iter != _sourceIndices.end())
-				sourceIndex = static_cast<int>(iter->second);
-		}
-
-		auto [name, data] = item.nameAndData();
-		Json::Value jsonItem;
-		jsonItem["name"] = name;
-		jsonItem["begin"] = item.location().start;
-		jsonItem["end"] = item.location().end;
-		if (item.m_modifierDepth != 0)
-			jsonItem["modifierDepth"] = static_cast<int>(item.m_modifierDepth);
-		std::string jumpType = item.getJumpTypeAsString();
-		if (!jumpType.empty())
-			jsonItem["jumpType"] = jumpType;
-		if (name == "PUSHLIB")
-			data = m_libraries.at(h256(data));
-		else if (name == "PUSHIMMUTABLE" || name == "ASSIGNIMMUTABLE")
-			data = m_immutables.at(h256(data));
-		if (!data.empty())
-			jsonItem["value"] = data;
-		jsonItem["source"] = sourceIndex;
-		code.append(std::move(jsonItem));
-
-		if (item.type() == AssemblyItemType::Tag)
-		{
-			Json::Value jumpdest;
-			jumpdest["name"] = "JUMPDEST";
-			jumpdest["begin"] = item.location().start;
-			jumpdest["end"] = item.location().end;
-			jumpdest["source"] = sourceIndex;
-			if (item.m_modifierDepth != 0)
-				jumpdest["modifierDepth"] = static_cast<int>(item.m_modifierDepth);
-			code.append(std::move(jumpdest));
-		}
-	}
+		for (Json::Value& jsonItem: assemblyItemJSON(item, _sourceIndices))
+			code.append(std::move(jsonItem));
 	if (_includeSourceList)
-	{
-		root["sourceList"] = Json::arrayValue;
-		Json::Value& jsonSourceList = root["sourceList"];
-		for (auto const& [name, index]: _sourceIndices)
-			jsonSourceList[index] = name;
-	}
+		root["sourceList"] = sourceListJSON(_sourceIndices);
 
 	if (!m_data.empty() || !m_subs.empty())
 	{
@@ -488,14 +517,10 @@ Json::Value Assembly::assemblyJSON(std::map<std::string, unsigned> const& _sourc
 		Json::Value& data = root[".data"];
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
-				data[util::toHex(toBigEndian((u256)i.first), util::HexPrefix::DontAdd, util::HexCase::Upper)] = util::toHex(i.second);
+				data[dataKeyJSON(i.first)] = util::toHex(i.second);
 
 		for (size_t i = 0; i < m_subs.size(); ++i)
-		{
-			std::stringstream hexStr;
-			hexStr << std::hex << i;
-			data[hexStr.str()] = m_subs[i]->assemblyJSON(_sourceIndices, /*_includeSourceList = */false);
-		}
+			data[subKeyJSON(i)] = m_subs[i]->assemblyJSON(_sourceIndices, /*_includeSourceList = */false);
 	}
 
 	if (!m_auxiliaryData.empty())
@@ -504,6 +529,58 @@ Json::Value Assembly::assemblyJSON(std::map<std::string, unsigned> const& _sourc
 	return root;
 }
 
+void Assembly::assemblyJSON(
+	util::JsonWriter& _writer,
+	std::map<std::string, unsigned> const& _sourceIndices,
+	bool _includeSourceList
+) const
+{
+	// Members are written in the order of their names, which jsoncpp uses.
+	_writer.beginObject();
+	if (!m_auxiliaryData.empty())
+	{
+		_writer.key(".auxdata");
+		_writer.write(util::toHex(m_auxiliaryData));
+	}
+
+	_writer.key(".code");
+	_writer.beginArray();
+	for (AssemblyItem const& item: m_items)
+		for (Json::Value const& jsonItem: assemblyItemJSON(item, _sourceIndices))
+			_writer.write(jsonItem);
+	_writer.endArray();
+
+	if (!m_data.empty() || !m_subs.empty())
+	{
+		// Data items are identified by their hash, sub assemblies by their index.
+		std::map<std::string, std::variant<bytes const*, Assembly const*>> data;
+		for (auto const& i: m_data)
+			if (u256(i.first) >= m_subs.size())
+				data[dataKeyJSON(i.first)] = &i.second;
+		for (size_t i = 0; i < m_subs.size(); ++i)
+			data[subKeyJSON(i)] = m_subs[i].get();
+
+		_writer.key(".data");
+		_writer.beginObject();
+		for (auto const& [key, value]: data)
+		{
+			_writer.key(key);
+			if (auto const* sub = std::get_if<Assembly const*>(&value))
+				(*sub)->assemblyJSON(_writer, _sourceIndices, /*_includeSourceList = */false);
+			else
+				_writer.write(util::toHex(*std::get<bytes const*>(value)));
+		}
+		_writer.endObject();
+	}
+
+	if (_includeSourceList)
+	{
+		_writer.key("sourceList");
+		_writer.write(sourceListJSON(_sourceIndices));
+	}
+	_writer.endObject();
+}
+
 std::pair<std::shared_ptr<Assembly>, std::vector<std::string>> Assembly::fromJSON(
 	Json::Value const& _json,
 	std::vector<std::string> const& _sourceList,
@@ -687,32 +764,66 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 	return AssemblyItem{AssignImmutable, h};
 }
 
-Assembly& Assembly::optimise(OptimiserSettings const& _settings)
+Assembly& Assembly::optimise(OptimiserSettings const& _settings, util::ThreadPool* _threadPool)
 {
-	optimiseInternal(_settings, {});
+	util::TimeReport::ScopedPhase phase("assemblyOptimization");
+	optimiseInternal(_settings, {}, _threadPool);
 	return *this;
 }
 
+bool Assembly::subsOptimisableIndependently() const
+{
+	std::set<Assembly const*> visited;
+	std::function<bool(Assembly const&)> visit = [&](Assembly const& _assembly) {
+		// Optimised assemblies only return their tag replacements.
+		if (_assembly.m_tagReplacements)
+			return true;
+		if (!visited.insert(&_assembly).second)
+			return false;
+		return ranges::all_of(_assembly.m_subs, [&](auto const& _sub) { return visit(*_sub); });
+	};
+	return ranges::all_of(m_subs, [&](auto const& _sub) { return visit(*_sub); });
+}
+
 std::map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+	std::set<size_t> _tagsReferencedFromOutside,
+	util::ThreadPool* _threadPool
 )
 {
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	// The replacements of a sub only affect the items referring to that sub, so the tags
+	// referenced from here do not depend on the order in which the subs are optimised.
+	if (_threadPool && m_subs.size() > 1 && subsOptimisableIndependently())
 	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		std::vector<std::set<size_t>> referencedTags;
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			referencedTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+		std::vector<std::exception_ptr> failures = _threadPool->parallelFor(m_subs.size(), [&](size_t _subId) {
+			m_subs[_subId]->optimiseInternal(_settings, std::move(referencedTags[_subId]), _threadPool);
+		});
+		for (std::exception_ptr const& failure: failures)
+			if (failure)
+				std::rethrow_exception(failure);
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			BlockDeduplicator::applyTagReplacement(m_items, *m_subs[subId]->m_tagReplacements, subId);
 	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		{
+			OptimiserSettings settings = _settings;
+			Assembly& sub = *m_subs[subId];
+			std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
+				settings,
+				JumpdestRemover::referencedTags(m_items, subId),
+				_threadPool
+			);
+			// Apply the replacements (can be empty).
+			BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		}
 
 	std::map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
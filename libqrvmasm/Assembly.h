@@ -41,6 +41,12 @@
 #include <map>
 #include <utility>
 
+namespace hyperion::util
+{
+class JsonWriter;
+class ThreadPool;
+}
+
 namespace hyperion::qrvmasm
 {
 
@@ -135,7 +141,9 @@ public:
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
-	Assembly& optimise(OptimiserSettings const& _settings);
+	/// If @a _threadPool is given, sub-assemblies that do not share any not yet optimised
+	/// assembly are optimised concurrently on it. The result is the same as without it.
+	Assembly& optimise(OptimiserSettings const& _settings, util::ThreadPool* _threadPool = nullptr);
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -151,6 +159,13 @@ public:
 
 	/// Create a JSON representation of the assembly.
 	Json::Value assemblyJSON(std::map<std::string, unsigned> const& _sourceIndices, bool _includeSourceList = true) const;
+	/// Writes the JSON representation of the assembly to @a _writer item by item. The output is the
+	/// same as that of printing the result of the function above.
+	void assemblyJSON(
+		util::JsonWriter& _writer,
+		std::map<std::string, unsigned> const& _sourceIndices,
+		bool _includeSourceList = true
+	) const;
 
 	/// Constructs an @a Assembly from the serialized JSON representation.
 	/// @param _json JSON object containing assembly in the format produced by assemblyJSON().
@@ -180,7 +195,14 @@ protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
-	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	std::map<u256, u256> const& optimiseInternal(
+		OptimiserSettings const& _settings,
+		std::set<size_t> _tagsReferencedFromOutside,
+		util::ThreadPool* _threadPool
+	);
+	/// @returns true if no assembly that is not optimised yet can be reached from more than one sub,
+	/// i.e. if optimising the subs in any order or concurrently leads to the same result.
+	bool subsOptimisableIndependently() const;
 
 	unsigned codeSize(unsigned subTagSize) const;
 
@@ -196,6 +218,19 @@ protected:
 	/// @returns AssemblyItem of _json argument.
 	AssemblyItem createAssemblyItemFromJSON(Json::Value const& _json, std::vector<std::string> const& _sourceList);
 
+	/// @returns the elements of the ".code" array in the JSON representation of @a _item.
+	/// Tags are followed by a JUMPDEST.
+	std::vector<Json::Value> assemblyItemJSON(
+		AssemblyItem const& _item,
+		std::map<std::string, unsigned> const& _sourceIndices
+	) const;
+	/// @returns the "sourceList" member of the JSON representation.
+	static Json::Value sourceListJSON(std::map<std::string, unsigned> const& _sourceIndices);
+	/// @returns the key of the data item @a _hash in the ".data" member of the JSON representation.
+	static std::string dataKeyJSON(util::h256 const& _hash);
+	/// @returns the key of sub assembly @a _subIndex in the ".data" member of the JSON representation.
+	static std::string subKeyJSON(size_t _subIndex);
+
 private:
 	bool m_invalid = false;
 
@@ -24,9 +24,59 @@
 #include <libqrvmasm/Assembly.h>
 #include <libqrvmasm/GasMeter.h>
 
+#include <libhyputil/CommonData.h>
+#include <libhyputil/TimeReport.h>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
 using namespace hyperion;
 using namespace hyperion::qrvmasm;
 
+namespace
+{
+
+/// Representations of constants found by ComputeMethod, keyed by the value and all parameters
+/// that influence the gas estimates used during the search.
+class RepresentationCache
+{
+public:
+	using Key = std::tuple<u256, langutil::QRVMVersion, bool, size_t, size_t>;
+
+	static RepresentationCache& instance()
+	{
+		static RepresentationCache cache;
+		return cache;
+	}
+
+	std::optional<AssemblyItems> find(Key const& _key)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (AssemblyItems const* routine = util::valueOrNullptr(m_routines, _key))
+			return *routine;
+		return std::nullopt;
+	}
+
+	void insert(Key _key, AssemblyItems _routine)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		// Bound the memory used by long-running processes.
+		if (m_routines.size() >= maxSize)
+			m_routines.clear();
+		m_routines.emplace(std::move(_key), std::move(_routine));
+	}
+
+private:
+	static size_t constexpr maxSize = 0x10000;
+
+	std::mutex m_mutex;
+	std::map<Key, AssemblyItems> m_routines;
+};
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -298,6 +348,27 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 	return stack.size() == 1 && stack.front() == _value;
 }
 
+AssemblyItems ComputeMethod::cachedRepresentation(u256 const& _value)
+{
+	RepresentationCache::Key key{
+		_value,
+		m_params.qrvmVersion,
+		m_params.isCreation,
+		m_params.runs,
+		m_params.multiplicity
+	};
+	if (std::optional<AssemblyItems> routine = RepresentationCache::instance().find(key))
+	{
+		util::TimeReport::ScopedPhase phase("constantRepresentationCacheHit");
+		return std::move(*routine);
+	}
+
+	util::TimeReport::ScopedPhase phase("constantRepresentationSearch");
+	AssemblyItems routine = findRepresentation(_value);
+	RepresentationCache::instance().insert(std::move(key), routine);
+	return routine;
+}
+
 bigint ComputeMethod::gasNeeded(AssemblyItems const& _routine) const
 {
 	auto numExps = static_cast<size_t>(count(_routine.begin(), _routine.end(), Instruction::EXP));
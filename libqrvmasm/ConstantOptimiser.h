@@ -135,7 +135,7 @@ public:
 	explicit ComputeMethod(Params const& _params, u256 const& _value):
 		ConstantOptimisationMethod(_params, _value)
 	{
-		m_routine = findRepresentation(m_value);
+		m_routine = cachedRepresentation(m_value);
 		assertThrow(
 			checkRepresentation(m_value, m_routine),
 			OptimizerException,
@@ -150,6 +150,9 @@ public:
 	}
 
 protected:
+	/// @returns the result of @a findRepresentation, which is shared by all compilations in the
+	/// process with the same parameters.
+	AssemblyItems cachedRepresentation(u256 const& _value);
 	/// Tries to recursively find a way to compute @a _value.
 	AssemblyItems findRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
@@ -24,6 +24,7 @@
 
 #include <libqrvmasm/KnownState.h>
 #include <libqrvmasm/AssemblyItem.h>
+#include <libhyputil/CommonData.h>
 #include <libhyputil/Keccak256.h>
 
 #include <functional>
@@ -32,6 +33,22 @@ using namespace hyperion;
 using namespace hyperion::qrvmasm;
 using namespace hyperion::langutil;
 
+namespace
+{
+
+/// @returns a reference to the object pointed to by @a _shared that is not shared with
+/// any other state, copying or creating it if needed.
+template <class T> T& modifiable(std::shared_ptr<T>& _shared)
+{
+	if (!_shared)
+		_shared = std::make_shared<T>();
+	else if (_shared.use_count() > 1)
+		_shared = std::make_shared<T>(*_shared);
+	return *_shared;
+}
+
+}
+
 std::ostream& KnownState::stream(std::ostream& _out) const
 {
 	auto streamExpressionClass = [this](std::ostream& _out, Id _id)
@@ -210,49 +227,54 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 	return op;
 }
 
+/// Removes the elements of the sorted map @a _map for which @a _remove returns true, in linear time.
+/// Erasing from a flat map one by one would move its tail each time.
+/// @a _remove may modify the value of elements it keeps.
+template <class Mapping, class Predicate> void removeIf(Mapping& _map, Predicate _remove)
+{
+	Mapping kept;
+	kept.reserve(_map.size());
+	for (auto& element: _map)
+		if (!_remove(element))
+			kept.emplace_hint(kept.end(), std::move(element));
+	_map = std::move(kept);
+}
+
 /// Helper function for KnownState::reduceToCommonKnowledge, removes everything from
 /// _this which is not in or not equal to the value in _other.
 template <class Mapping> void intersect(Mapping& _this, Mapping const& _other)
 {
-	for (auto it = _this.begin(); it != _this.end();)
-		if (_other.count(it->first) && _other.at(it->first) == it->second)
-			++it;
-		else
-			it = _this.erase(it);
+	removeIf(_this, [&](auto const& _element) {
+		auto other = _other.find(_element.first);
+		return other == _other.end() || other->second != _element.second;
+	});
 }
 
 void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers)
 {
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (_other.m_stackElements.count(it->first - stackDiff))
-		{
-			Id other = _other.m_stackElements.at(it->first - stackDiff);
-			if (it->second == other)
-				++it;
-			else
-			{
-				std::set<u256> theseTags = tagsInExpression(it->second);
-				std::set<u256> otherTags = tagsInExpression(other);
-				if (!theseTags.empty() && !otherTags.empty())
-				{
-					theseTags.insert(otherTags.begin(), otherTags.end());
-					it->second = tagUnion(theseTags);
-					++it;
-				}
-				else
-					it = m_stackElements.erase(it);
-			}
-		}
-		else
-			it = m_stackElements.erase(it);
+	removeIf(m_stackElements, [&](auto& _element) {
+		auto other = _other.m_stackElements.find(_element.first - stackDiff);
+		if (other == _other.m_stackElements.end())
+			return true;
+		if (_element.second == other->second)
+			return false;
+		std::set<u256> theseTags = tagsInExpression(_element.second);
+		std::set<u256> otherTags = tagsInExpression(other->second);
+		if (theseTags.empty() || otherTags.empty())
+			return true;
+		theseTags.insert(otherTags.begin(), otherTags.end());
+		_element.second = tagUnion(theseTags);
+		return false;
+	});
 
 	// Use the smaller stack height. Essential to terminate in case of loops.
 	if (m_stackHeight > _other.m_stackHeight)
 	{
-		std::map<int, Id> shiftedStack;
+		decltype(m_stackElements) shiftedStack;
+		shiftedStack.reserve(m_stackElements.size());
 		for (auto const& stackElement: m_stackElements)
-			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
+			shiftedStack.emplace_hint(shiftedStack.end(), stackElement.first - stackDiff, stackElement.second);
 		m_stackElements = std::move(shiftedStack);
 		m_stackHeight = _other.m_stackHeight;
 	}
@@ -292,11 +314,9 @@ KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation
 
 void KnownState::clearTagUnions()
 {
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (m_tagUnions.left.count(it->second))
-			it = m_stackElements.erase(it);
-		else
-			++it;
+	if (!m_tagUnions)
+		return;
+	removeIf(m_stackElements, [&](auto const& _element) { return m_tagUnions->left.count(_element.second) > 0; });
 }
 
 void KnownState::setStackElement(int _stackHeight, Id _class)
@@ -408,8 +428,9 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count({arguments, length}))
-		return m_knownKeccak256Hashes.at({arguments, length});
+	if (m_knownKeccak256Hashes)
+		if (Id const* knownHash = util::valueOrNullptr(*m_knownKeccak256Hashes, std::make_pair(arguments, length)))
+			return *knownHash;
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -422,13 +443,13 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[{arguments, length}] = v;
+	return modifiable(m_knownKeccak256Hashes)[{std::move(arguments), length}] = v;
 }
 
 std::set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 {
-	if (m_tagUnions.left.count(_expressionId))
-		return m_tagUnions.left.at(_expressionId);
+	if (m_tagUnions && m_tagUnions->left.count(_expressionId))
+		return m_tagUnions->left.at(_expressionId);
 	// Might be a tag, then return the set of itself.
 	ExpressionClasses::Expression expr = m_expressionClasses->representative(_expressionId);
 	if (expr.item && expr.item->type() == PushTag)
@@ -439,12 +460,12 @@ std::set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 
 KnownState::Id KnownState::tagUnion(std::set<u256> _tags)
 {
-	if (m_tagUnions.right.count(_tags))
-		return m_tagUnions.right.at(_tags);
+	if (m_tagUnions && m_tagUnions->right.count(_tags))
+		return m_tagUnions->right.at(_tags);
 	else
 	{
 		Id id = m_expressionClasses->newClass(SourceLocation());
-		m_tagUnions.right.insert(make_pair(_tags, id));
+		modifiable(m_tagUnions).right.insert(make_pair(_tags, id));
 		return id;
 	}
 }
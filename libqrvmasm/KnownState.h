@@ -36,6 +36,7 @@
 #endif
 
 #include <boost/bimap.hpp>
+#include <boost/container/flat_map.hpp>
 
 #if defined(_MSC_VER)
 #pragma warning(pop)
@@ -112,7 +113,7 @@ public:
 	/// Resets any knowledge about memory.
 	void resetMemory() { m_memoryContent.clear(); }
 	/// Resets known Keccak-256 hashes
-	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.clear(); }
+	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.reset(); }
 	/// Resets any knowledge about the current stack.
 	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
 	/// Resets any knowledge.
@@ -127,6 +128,7 @@ public:
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
 	/// @returns a shared pointer to a copy of this state.
+	/// Known Keccak-256 hashes and tag unions are shared with the copy until either of them is modified.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
@@ -146,10 +148,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	boost::container::flat_map<int, Id> const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	boost::container::flat_map<Id, Id> const& storageContent() const { return m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -178,22 +180,25 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	/// The stack, storage and memory knowledge is kept in sorted vectors since it is small
+	/// and copied at every basic block boundary.
+	boost::container::flat_map<int, Id> m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	boost::container::flat_map<Id, Id> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	boost::container::flat_map<Id, Id> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
-	/// that is accessed.
-	std::map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
+	/// that is accessed. Shared between copies of the state until modified, null if empty.
+	std::shared_ptr<std::map<std::pair<std::vector<Id>, unsigned>, Id>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	/// Shared between copies of the state until modified, null if empty.
+	std::shared_ptr<boost::bimap<Id, std::set<u256>>> m_tagUnions;
 };
 
 }
@@ -101,6 +101,13 @@ Json::Value QRVMAssemblyStack::assemblyJSON(std::string const& _contractName) co
 	return m_qrvmAssembly->assemblyJSON(sourceIndices());
 }
 
+void QRVMAssemblyStack::assemblyJSON(std::string const& _contractName, util::JsonWriter& _writer) const
+{
+	hypAssert(_contractName == m_name);
+	hypAssert(m_qrvmAssembly);
+	m_qrvmAssembly->assemblyJSON(_writer, sourceIndices());
+}
+
 std::string QRVMAssemblyStack::assemblyString(std::string const& _contractName, StringMap const& _sourceCodes) const
 {
 	hypAssert(_contractName == m_name);
@@ -54,6 +54,7 @@ public:
 	virtual std::string const* runtimeSourceMapping(std::string const& _contractName) const override;
 
 	virtual Json::Value assemblyJSON(std::string const& _contractName) const override;
+	virtual void assemblyJSON(std::string const& _contractName, util::JsonWriter& _writer) const override;
 	virtual std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes) const override;
 
 	virtual std::string const filesystemFriendlyName(std::string const& _contractName) const override;
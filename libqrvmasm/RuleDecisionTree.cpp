@@ -0,0 +1,68 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Decision tree used to pre-select the simplification rules that can match an expression.
+ */
+
+#include <libqrvmasm/RuleDecisionTree.h>
+
+#include <libqrvmasm/Exceptions.h>
+
+using namespace hyperion;
+using namespace hyperion::qrvmasm;
+
+void RuleDecisionTree::addRule(std::vector<PatternNode> const& _patternNodes)
+{
+	size_t nodeIndex = 0;
+	// Number of pattern nodes that still have to follow for the sequence to be complete.
+	size_t open = 1;
+	for (PatternNode const& patternNode: _patternNodes)
+	{
+		assertThrow(open > 0, OptimizerException, "Pattern node sequence too long.");
+		--open;
+		switch (patternNode.kind)
+		{
+		case PatternNode::Kind::Any:
+			nodeIndex = child(m_nodes[nodeIndex].any);
+			break;
+		case PatternNode::Kind::Constant:
+			if (patternNode.value)
+				nodeIndex = child(m_nodes[nodeIndex].constants[*patternNode.value]);
+			else
+				nodeIndex = child(m_nodes[nodeIndex].anyConstant);
+			break;
+		case PatternNode::Kind::Operation:
+			nodeIndex = child(m_nodes[nodeIndex].operations[{patternNode.instruction, patternNode.argumentCount}]);
+			open += patternNode.argumentCount;
+			break;
+		}
+	}
+	assertThrow(open == 0, OptimizerException, "Incomplete pattern node sequence.");
+	m_nodes[nodeIndex].rules.push_back(m_ruleCount++);
+}
+
+size_t RuleDecisionTree::child(size_t& _childIndex)
+{
+	if (!_childIndex)
+	{
+		// Adding to the deque does not invalidate _childIndex.
+		_childIndex = m_nodes.size();
+		m_nodes.emplace_back();
+	}
+	return _childIndex;
+}
@@ -0,0 +1,157 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Decision tree used to pre-select the simplification rules that can match an expression.
+ */
+
+#pragma once
+
+#include <libqrvmasm/Instruction.h>
+
+#include <libhyputil/CommonData.h>
+#include <libhyputil/Numeric.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace hyperion::qrvmasm
+{
+
+/**
+ * Discrimination tree over the patterns of a list of simplification rules.
+ *
+ * Every pattern is flattened in pre-order into a sequence of pattern nodes, which is a path
+ * in the tree. Looking up an expression follows all paths compatible with it at once and
+ * returns the indices of the rules at their ends. Match groups are ignored and the tree
+ * never looks into expressions matched by "any", so a candidate still has to be matched
+ * against its full pattern, but rules that cannot match are never tried.
+ */
+class RuleDecisionTree
+{
+public:
+	/// A single node of a pattern, without its arguments.
+	struct PatternNode
+	{
+		enum class Kind { Any, Constant, Operation };
+
+		Kind kind = Kind::Any;
+		/// Only valid for operations.
+		Instruction instruction = Instruction::STOP;
+		/// Number of argument patterns that follow in pre-order. Only valid for operations.
+		size_t argumentCount = 0;
+		/// The value a constant has to have, if it requires a specific one.
+		std::optional<u256> value;
+	};
+
+	RuleDecisionTree(): m_nodes(1) {}
+
+	/// Adds the rule with the next index, given as the pre-order sequence of its pattern nodes.
+	void addRule(std::vector<PatternNode> const& _patternNodes);
+
+	/// @returns the number of rules added so far.
+	size_t ruleCount() const { return m_ruleCount; }
+
+	/// @returns the indices of all rules that might match @a _expression, in ascending order.
+	/// @a _adapter provides access to the expressions referred to by a @a Handle:
+	///  - `Handle resolve(Handle)`: the expression that a pattern other than "any" is matched against,
+	///  - `bool isConstant(Handle)` and `u256 constantValue(Handle)`,
+	///  - `std::optional<Instruction> pushOperationArguments(Handle, std::vector<Handle>&)`:
+	///    if the expression is an operation that can be matched, pushes its arguments in
+	///    reverse order and returns its instruction.
+	template <class Handle, class Adapter>
+	std::vector<size_t> candidates(Handle _expression, Adapter const& _adapter) const
+	{
+		std::vector<size_t> result;
+		std::vector<Handle> pending{_expression};
+		collect(0, pending, _adapter, result);
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+private:
+	struct Node
+	{
+		/// Rules whose pattern ends at this node, in ascending order.
+		std::vector<size_t> rules;
+		/// Child nodes, referenced by their index in m_nodes. Zero means "no child".
+		size_t any = 0;
+		size_t anyConstant = 0;
+		std::map<u256, size_t> constants;
+		std::map<std::pair<Instruction, size_t>, size_t> operations;
+	};
+
+	/// @returns the index of the child node referenced by @a _childIndex, creating it if needed.
+	size_t child(size_t& _childIndex);
+
+	template <class Handle, class Adapter>
+	void collect(size_t _nodeIndex, std::vector<Handle>& _pending, Adapter const& _adapter, std::vector<size_t>& _result) const
+	{
+		Node const& node = m_nodes[_nodeIndex];
+		if (_pending.empty())
+		{
+			_result += node.rules;
+			return;
+		}
+
+		Handle expression = _pending.back();
+		_pending.pop_back();
+
+		if (node.any)
+			collect(node.any, _pending, _adapter, _result);
+
+		if (node.anyConstant || !node.constants.empty() || !node.operations.empty())
+		{
+			Handle resolved = _adapter.resolve(expression);
+			if (_adapter.isConstant(resolved))
+			{
+				if (node.anyConstant)
+					collect(node.anyConstant, _pending, _adapter, _result);
+				if (!node.constants.empty())
+					if (size_t const* next = util::valueOrNullptr(node.constants, _adapter.constantValue(resolved)))
+						collect(*next, _pending, _adapter, _result);
+			}
+			else if (!node.operations.empty())
+			{
+				size_t const pendingSize = _pending.size();
+				if (std::optional<Instruction> instruction = _adapter.pushOperationArguments(resolved, _pending))
+				{
+					size_t const argumentCount = _pending.size() - pendingSize;
+					if (size_t const* next = util::valueOrNullptr(node.operations, std::make_pair(*instruction, argumentCount)))
+						collect(*next, _pending, _adapter, _result);
+					_pending.resize(pendingSize);
+					// Patterns without arguments match operations regardless of their arguments.
+					if (argumentCount > 0)
+						if (size_t const* next = util::valueOrNullptr(node.operations, std::make_pair(*instruction, size_t(0))))
+							collect(*next, _pending, _adapter, _result);
+				}
+			}
+		}
+
+		_pending.push_back(expression);
+	}
+
+	/// The root is at index zero.
+	std::deque<Node> m_nodes;
+	size_t m_ruleCount = 0;
+};
+
+}
@@ -23,11 +23,18 @@
 
 #include <libqrvmasm/Instruction.h>
 #include <libhyputil/CommonData.h>
+
+#include <array>
 #include <functional>
 
 namespace hyperion::qrvmasm
 {
 
+/// Expressions matched by the match groups of the patterns of one rule list, indexed by
+/// match group. Index zero stands for "no match group" and is not used.
+template <class Expression>
+using MatchGroups = std::array<Expression const*, 8>;
+
 /**
  * Rule that contains a pattern, an action that can be applied
  * after the pattern has matched and optional condition to check if the
@@ -36,6 +36,34 @@ using namespace hyperion;
 using namespace hyperion::qrvmasm;
 using namespace hyperion::langutil;
 
+namespace
+{
+
+/// Provides access to the expression classes for the rule decision tree.
+struct ExpressionAdapter
+{
+	using Expression = ExpressionClasses::Expression;
+
+	Expression const* resolve(Expression const* _expr) const { return _expr; }
+	bool isConstant(Expression const* _expr) const { return _expr->item && _expr->item->type() == Push; }
+	u256 constantValue(Expression const* _expr) const { return _expr->item->data(); }
+	std::optional<Instruction> pushOperationArguments(
+		Expression const* _expr,
+		std::vector<Expression const*>& _arguments
+	) const
+	{
+		if (!_expr->item || _expr->item->type() != Operation)
+			return std::nullopt;
+		for (auto it = _expr->arguments.rbegin(); it != _expr->arguments.rend(); ++it)
+			_arguments.push_back(&classes.representative(*it));
+		return _expr->item->instruction();
+	}
+
+	ExpressionClasses const& classes;
+};
+
+}
+
 SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	Expression const& _expr,
 	ExpressionClasses const& _classes
@@ -44,8 +72,9 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	for (size_t ruleIndex: m_decisionTree.candidates(&_expr, ExpressionAdapter{_classes}))
 	{
+		SimplificationRule<Pattern> const& rule = m_rules[ruleIndex];
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -57,7 +86,7 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -68,7 +97,10 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	std::vector<RuleDecisionTree::PatternNode> patternNodes;
+	_rule.pattern.appendPatternNodes(patternNodes);
+	m_decisionTree.addRule(patternNodes);
+	m_rules.push_back(_rule);
 }
 
 Rules::Rules()
@@ -102,8 +134,9 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups<Expression>& _matchGroups)
 {
+	assertThrow(_group < _matchGroups.size(), OptimizerException, "Match group out of range.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -114,9 +147,10 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		Expression const*& matched = (*m_matchGroups)[m_matchGroup];
+		if (!matched)
+			matched = &_expr;
+		else if (matched->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
@@ -126,6 +160,30 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+void Pattern::appendPatternNodes(std::vector<RuleDecisionTree::PatternNode>& _nodes) const
+{
+	using Kind = RuleDecisionTree::PatternNode::Kind;
+	RuleDecisionTree::PatternNode node;
+	if (m_type == Operation)
+	{
+		node.kind = Kind::Operation;
+		node.instruction = m_instruction;
+		node.argumentCount = m_arguments.size();
+	}
+	else if (m_type == Push)
+	{
+		node.kind = Kind::Constant;
+		if (m_requireDataMatch)
+			node.value = data();
+	}
+	else
+		// The tree does not distinguish other item types, so they are pre-selected like "any".
+		assertThrow(m_arguments.empty(), OptimizerException, "");
+	_nodes.push_back(std::move(node));
+	for (Pattern const& argument: m_arguments)
+		argument.appendPatternNodes(_nodes);
+}
+
 AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 {
 	if (m_type == Operation)
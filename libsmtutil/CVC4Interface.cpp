@@ -121,6 +121,18 @@ std::pair<CheckResult, std::vector<std::string>> CVC4Interface::check(std::vecto
 	return std::make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	try
+	{
+		m_solver.interrupt();
+	}
+	catch (CVC4::Exception const&)
+	{
+		// Thrown if the engine is not checking a query at the moment.
+	}
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
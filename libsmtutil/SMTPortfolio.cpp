@@ -26,6 +26,9 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <mutex>
+#include <thread>
+
 using namespace hyperion;
 using namespace hyperion::util;
 using namespace hyperion::frontend;
@@ -53,6 +56,15 @@ SMTPortfolio::SMTPortfolio(
 #endif
 }
 
+SMTPortfolio::SMTPortfolio(
+	std::vector<std::unique_ptr<SolverInterface>> _solvers,
+	std::optional<unsigned> _queryTimeout
+):
+	SolverInterface(_queryTimeout),
+	m_solvers(std::move(_solvers))
+{
+}
+
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
@@ -95,6 +107,10 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  * A solver did not answer the query if it returns either:
  *   UNKNOWN (it tried but couldn't solve it) or ERROR (crash, internal error, API error, etc).
  *
+ * The solvers run concurrently and the first one to answer interrupts the others,
+ * which then usually return UNKNOWN. Solvers that answer before they notice the
+ * interruption still take part in the decision below.
+ *
  * Ideally all solvers answer the query and agree on what the answer is
  * (all say SAT or all say UNSAT).
  *
@@ -102,12 +118,14 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  * 1) If at least one solver answers the query, all the non-answer results are ignored.
  *   Here SAT/UNSAT is preferred over UNKNOWN since it's an actual answer, and over ERROR
  *   because one buggy solver/integration shouldn't break the portfolio.
+ *   If several solvers answer, the model of the first one in the portfolio is used.
  *
  * 2) If at least one solver answers SAT and at least one answers UNSAT, at least one of them is buggy
  * and the result is CONFLICTING.
  *   In the future if we have more than 2 solvers enabled we could go with the majority.
  *
  * 3) If NO solver answers the query:
+ *   If a solver threw a SolverError, the error is rethrown.
  *   If at least one solver returned UNKNOWN (where the rest returned ERROR), the result is UNKNOWN.
  *   This is preferred over ERROR since the SMTChecker might decide to abstract the query
  *   when it is told that this is a hard query to solve.
@@ -116,13 +134,16 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	std::vector<SolverRun> runs(m_solvers.size());
+	std::vector<std::pair<CheckResult, std::vector<std::string>>> answers(m_solvers.size(), {CheckResult::ERROR, {}});
+	std::vector<std::exception_ptr> exceptions(m_solvers.size());
+	race(_expressionsToEvaluate, runs, answers, exceptions);
+	m_queryStatistics.emplace_back(std::move(runs));
+
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto&& [result, values]: answers)
 	{
-		CheckResult result;
-		std::vector<std::string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -139,9 +160,97 @@ std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector
 		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
 			lastResult = result;
 	}
+
+	bool const answered = solverAnswered(lastResult) || lastResult == CheckResult::CONFLICTING;
+	for (auto const& exception: exceptions)
+		if (exception)
+			try
+			{
+				std::rethrow_exception(exception);
+			}
+			catch (SolverError const&)
+			{
+				if (!answered)
+					throw;
+			}
+
 	return std::make_pair(lastResult, finalValues);
 }
 
+void SMTPortfolio::race(
+	std::vector<Expression> const& _expressionsToEvaluate,
+	std::vector<SolverRun>& _runs,
+	std::vector<std::pair<CheckResult, std::vector<std::string>>>& _answers,
+	std::vector<std::exception_ptr>& _exceptions
+)
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	bool const concurrent = false;
+#else
+	bool const concurrent = m_solvers.size() > 1;
+#endif
+
+	std::mutex mutex;
+	bool answered = false;
+	std::vector<bool> running(m_solvers.size(), false);
+
+	auto runSolver = [&](size_t _index) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (answered && concurrent)
+			{
+				_runs[_index].cancelled = true;
+				return;
+			}
+			running[_index] = true;
+		}
+
+		auto const start = std::chrono::steady_clock::now();
+		std::pair<CheckResult, std::vector<std::string>> answer{CheckResult::ERROR, {}};
+		try
+		{
+			answer = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			_exceptions[_index] = std::current_exception();
+		}
+		auto const latency = std::chrono::steady_clock::now() - start;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		running[_index] = false;
+		_runs[_index].result = answer.first;
+		_runs[_index].latency = std::chrono::duration_cast<std::chrono::microseconds>(latency);
+		if (solverAnswered(answer.first) && !answered)
+		{
+			answered = true;
+			// A solver that is about to start its check can miss the interruption,
+			// but it is still bounded by the query timeout and resource limit.
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (running[i])
+				{
+					m_solvers[i]->interrupt();
+					_runs[i].cancelled = true;
+				}
+		}
+		_answers[_index] = std::move(answer);
+	};
+
+	if (!concurrent)
+	{
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			runSolver(i);
+		return;
+	}
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		threads.emplace_back(runSolver, i);
+	runSolver(0);
+	for (std::thread& thread: threads)
+		thread.join();
+}
+
 std::vector<std::string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -23,7 +23,10 @@
 #include <libhyperion/interface/ReadFile.h>
 #include <libhyputil/FixedHash.h>
 
+#include <chrono>
+#include <exception>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace hyperion::smtutil
@@ -32,6 +35,8 @@ namespace hyperion::smtutil
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
+ * Queries are sent to all solvers concurrently and the first solver to answer
+ * interrupts the others.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
  */
@@ -49,6 +54,21 @@ public:
 		std::optional<unsigned> _queryTimeout = {},
 		bool _printQuery = false
 	);
+	/// Creates a portfolio of the given solvers. If an SMTLib2Interface is among them, it has to come first.
+	explicit SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> _solvers,
+		std::optional<unsigned> _queryTimeout = {}
+	);
+
+	/// Outcome of one solver on one query.
+	struct SolverRun
+	{
+		CheckResult result = CheckResult::ERROR;
+		/// Wall-clock time spent in the solver, zero if it was not run.
+		std::chrono::microseconds latency{0};
+		/// Whether the solver was interrupted or not run at all because another solver answered first.
+		bool cancelled = false;
+	};
 
 	void reset() override;
 
@@ -66,12 +86,28 @@ public:
 
 	std::string dumpQuery(std::vector<Expression> const& _expressionsToEvaluate);
 
+	/// @returns the runs of all queries checked so far, each listing the solvers in the order
+	/// smtlib2, z3, cvc4 (restricted to the enabled ones).
+	std::vector<std::vector<SolverRun>> const& queryStatistics() const { return m_queryStatistics; }
+
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Runs all solvers on the query, each on its own thread, and interrupts the remaining ones
+	/// as soon as one of them answers. The first solver runs on the calling thread, so that
+	/// the SMT callback is never invoked from a different thread.
+	void race(
+		std::vector<Expression> const& _expressionsToEvaluate,
+		std::vector<SolverRun>& _runs,
+		std::vector<std::pair<CheckResult, std::vector<std::string>>>& _answers,
+		std::vector<std::exception_ptr>& _exceptions
+	);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
 
 	std::vector<Expression> m_assertions;
+
+	std::vector<std::vector<SolverRun>> m_queryStatistics;
 };
 
 }
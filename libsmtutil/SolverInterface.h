@@ -542,6 +542,11 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that is running on another thread to return early, which then
+	/// reports UNKNOWN. Has no effect on solvers that cannot be interrupted.
+	/// Can be called just after check() returned and must not affect later calls then.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
@@ -98,6 +98,11 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 {
 	CheckResult result;
 	std::vector<std::string> values;
+	{
+		std::lock_guard<std::mutex> lock(m_interruptMutex);
+		m_checking = true;
+		m_interrupted = false;
+	}
 	try
 	{
 		switch (m_solver.check())
@@ -136,9 +141,28 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 		values.clear();
 	}
 
+	{
+		std::lock_guard<std::mutex> lock(m_interruptMutex);
+		m_checking = false;
+		// An interruption that arrives after Z3 finished the check leaves the context cancelled,
+		// so that the next push() fails. Running any check clears that state.
+		if (m_interrupted)
+			z3::solver(m_context).check();
+	}
+
 	return std::make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	std::lock_guard<std::mutex> lock(m_interruptMutex);
+	if (!m_checking)
+		return;
+	m_interrupted = true;
+	// Thread-safe, unlike the rest of the context.
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
@@ -21,6 +21,8 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <mutex>
+
 namespace hyperion::smtutil
 {
 
@@ -44,6 +46,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -68,6 +71,12 @@ private:
 	z3::context m_context;
 	z3::solver m_solver;
 
+	/// Protects the state of the running check against concurrent calls to interrupt().
+	std::mutex m_interruptMutex;
+	bool m_checking = false;
+	/// Whether interrupt() reached the context during the current check.
+	bool m_interrupted = false;
+
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
 };
@@ -48,12 +48,21 @@ struct DebugData
 		astID(std::move(_astID))
 	{}
 
+	/// @returns a debug data object with the given contents.
+	/// A single object is shared by all callers that do not provide any information.
 	static std::shared_ptr<DebugData const> create(
 		langutil::SourceLocation _nativeLocation = {},
 		langutil::SourceLocation _originLocation = {},
 		std::optional<int64_t> _astID = {}
 	)
 	{
+		if (!_nativeLocation.isValid() && !_originLocation.isValid() && !_astID)
+		{
+			static std::shared_ptr<DebugData const> const empty = std::make_shared<DebugData const>(
+				langutil::SourceLocation{}
+			);
+			return empty;
+		}
 		return std::make_shared<DebugData const>(
 			std::move(_nativeLocation),
 			std::move(_originLocation),
@@ -116,7 +116,7 @@ std::vector<YulString> AsmAnalyzer::operator()(Literal const& _literal)
 		m_errorReporter.typeError(
 			5170_error,
 			nativeLocationOf(_literal),
-			"Invalid type \"" + _literal.type.str() + "\" for literal \"" + _literal.value.str() + "\"."
+			"Invalid type \"" + std::string(_literal.type.str()) + "\" for literal \"" + std::string(_literal.value.str()) + "\"."
 		);
 
 	return {_literal.type};
@@ -135,7 +135,7 @@ std::vector<YulString> AsmAnalyzer::operator()(Identifier const& _identifier)
 				m_errorReporter.declarationError(
 					4990_error,
 					nativeLocationOf(_identifier),
-					"Variable " + _identifier.name.str() + " used before it was declared."
+					"Variable " + std::string(_identifier.name.str()) + " used before it was declared."
 				);
 			type = _var.type;
 		},
@@ -144,7 +144,7 @@ std::vector<YulString> AsmAnalyzer::operator()(Identifier const& _identifier)
 			m_errorReporter.typeError(
 				6041_error,
 				nativeLocationOf(_identifier),
-				"Function " + _identifier.name.str() + " used without being called."
+				"Function " + std::string(_identifier.name.str()) + " used without being called."
 			);
 		}
 	}))
@@ -169,7 +169,7 @@ std::vector<YulString> AsmAnalyzer::operator()(Identifier const& _identifier)
 			m_errorReporter.declarationError(
 				8198_error,
 				nativeLocationOf(_identifier),
-				"Identifier \"" + _identifier.name.str() + "\" not found."
+				"Identifier \"" + std::string(_identifier.name.str()) + "\" not found."
 			);
 
 	}
@@ -206,7 +206,7 @@ void AsmAnalyzer::operator()(Assignment const& _assignment)
 				9005_error,
 				nativeLocationOf(_assignment),
 				"Variable " +
-				_variableName.name.str() +
+				std::string(_variableName.name.str()) +
 				" occurs multiple times on the left-hand side of the assignment."
 			);
 
@@ -217,7 +217,7 @@ void AsmAnalyzer::operator()(Assignment const& _assignment)
 			8678_error,
 			nativeLocationOf(_assignment),
 			"Variable count for assignment to \"" +
-			joinHumanReadable(applyMap(_assignment.variableNames, [](auto const& _identifier){ return _identifier.name.str(); })) +
+			joinHumanReadable(applyMap(_assignment.variableNames, [](auto const& _identifier){ return std::string(_identifier.name.str()); })) +
 			"\" does not match number of values (" +
 			std::to_string(numVariables) +
 			" vs. " +
@@ -255,7 +255,7 @@ void AsmAnalyzer::operator()(VariableDeclaration const& _varDecl)
 				3812_error,
 				nativeLocationOf(_varDecl),
 				"Variable count mismatch for declaration of \"" +
-				joinHumanReadable(applyMap(_varDecl.variables, [](auto const& _identifier){ return _identifier.name.str(); })) +
+				joinHumanReadable(applyMap(_varDecl.variables, [](auto const& _identifier){ return std::string(_identifier.name.str()); })) +
 				+ "\": " +
 				std::to_string(numVariables) +
 				" variables and " +
@@ -273,7 +273,7 @@ void AsmAnalyzer::operator()(VariableDeclaration const& _varDecl)
 				m_errorReporter.typeError(
 					3947_error,
 					nativeLocationOf(variable),
-					"Assigning value of type \"" + givenType.str() + "\" to variable of type \"" + variable.type.str() + "\"."
+					"Assigning value of type \"" + std::string(givenType.str()) + "\" to variable of type \"" + std::string(variable.type.str()) + "\"."
 				);
 		}
 	}
@@ -349,7 +349,7 @@ std::vector<YulString> AsmAnalyzer::operator()(FunctionCall const& _funCall)
 			m_errorReporter.declarationError(
 				4619_error,
 				nativeLocationOf(_funCall.functionName),
-				"Function \"" + _funCall.functionName.name.str() + "\" not found."
+				"Function \"" + std::string(_funCall.functionName.name.str()) + "\" not found."
 			);
 		yulAssert(!watcher.ok(), "Expected a reported error.");
 	}
@@ -358,7 +358,7 @@ std::vector<YulString> AsmAnalyzer::operator()(FunctionCall const& _funCall)
 		m_errorReporter.typeError(
 			7000_error,
 			nativeLocationOf(_funCall.functionName),
-			"Function \"" + _funCall.functionName.name.str() + "\" expects " +
+			"Function \"" + std::string(_funCall.functionName.name.str()) + "\" expects " +
 			std::to_string(parameterTypes->size()) +
 			" arguments but got " +
 			std::to_string(_funCall.arguments.size()) + "."
@@ -388,14 +388,14 @@ std::vector<YulString> AsmAnalyzer::operator()(FunctionCall const& _funCall)
 				);
 			else if (*literalArgumentKind == LiteralKind::String)
 			{
-				std::string functionName = _funCall.functionName.name.str();
+				std::string functionName(_funCall.functionName.name.str());
 				if (functionName == "datasize" || functionName == "dataoffset")
 				{
 					if (!m_dataNames.count(std::get<Literal>(arg).value))
 						m_errorReporter.typeError(
 							3517_error,
 							nativeLocationOf(arg),
-							"Unknown data object \"" + std::get<Literal>(arg).value.str() + "\"."
+							"Unknown data object \"" + std::string(std::get<Literal>(arg).value.str()) + "\"."
 						);
 				}
 				else if (functionName.substr(0, "verbatim_"s.size()) == "verbatim_")
@@ -545,9 +545,9 @@ void AsmAnalyzer::expectBoolExpression(Expression const& _expr)
 			1733_error,
 			nativeLocationOf(_expr),
 			"Expected a value of boolean type \"" +
-			m_dialect.boolType.str() +
+			std::string(m_dialect.boolType.str()) +
 			"\" but got \"" +
-			type.str() +
+			std::string(type.str()) +
 			"\""
 		);
 }
@@ -574,7 +574,7 @@ void AsmAnalyzer::checkAssignment(Identifier const& _variable, YulString _valueT
 			m_errorReporter.declarationError(
 				1133_error,
 				nativeLocationOf(_variable),
-				"Variable " + _variable.name.str() + " used before it was declared."
+				"Variable " + std::string(_variable.name.str()) + " used before it was declared."
 			);
 		else
 			variableType = &std::get<Scope::Variable>(*var).type;
@@ -598,9 +598,9 @@ void AsmAnalyzer::checkAssignment(Identifier const& _variable, YulString _valueT
 			9547_error,
 			nativeLocationOf(_variable),
 			"Assigning a value of type \"" +
-			_valueType.str() +
+			std::string(_valueType.str()) +
 			"\" to a variable of type \"" +
-			variableType->str() +
+			std::string(variableType->str()) +
 			"\"."
 		);
 
@@ -622,21 +622,21 @@ void AsmAnalyzer::expectValidIdentifier(YulString _identifier, SourceLocation co
 		m_errorReporter.syntaxError(
 			3384_error,
 			_location,
-			"\"" + _identifier.str() + "\" is not a valid identifier (ends with a dot)."
+			"\"" + std::string(_identifier.str()) + "\" is not a valid identifier (ends with a dot)."
 		);
 
 	if (_identifier.str().find("..") != std::string::npos)
 		m_errorReporter.syntaxError(
 			7771_error,
 			_location,
-			"\"" + _identifier.str() + "\" is not a valid identifier (contains consecutive dots)."
+			"\"" + std::string(_identifier.str()) + "\" is not a valid identifier (contains consecutive dots)."
 		);
 
 	if (m_dialect.reservedIdentifier(_identifier))
 		m_errorReporter.declarationError(
 			5017_error,
 			_location,
-			"The identifier \"" + _identifier.str() + "\" is reserved and can not be used."
+			"The identifier \"" + std::string(_identifier.str()) + "\" is reserved and can not be used."
 		);
 }
 
@@ -708,5 +708,5 @@ bool AsmAnalyzer::validateInstructions(qrvmasm::Instruction _instr, SourceLocati
 
 bool AsmAnalyzer::validateInstructions(FunctionCall const& _functionCall)
 {
-	return validateInstructions(_functionCall.functionName.name.str(), nativeLocationOf(_functionCall.functionName));
+	return validateInstructions(std::string(_functionCall.functionName.name.str()), nativeLocationOf(_functionCall.functionName));
 }
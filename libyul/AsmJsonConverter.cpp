@@ -40,8 +40,8 @@ Json::Value AsmJsonConverter::operator()(TypedName const& _node) const
 {
 	yulAssert(!_node.name.empty(), "Invalid variable name.");
 	Json::Value ret = createAstNode(originLocationOf(_node), nativeLocationOf(_node), "YulTypedName");
-	ret["name"] = _node.name.str();
-	ret["type"] = _node.type.str();
+	ret["name"] = std::string(_node.name.str());
+	ret["type"] = std::string(_node.type.str());
 	return ret;
 }
 
@@ -52,7 +52,7 @@ Json::Value AsmJsonConverter::operator()(Literal const& _node) const
 	{
 	case LiteralKind::Number:
 		yulAssert(
-			util::isValidDecimal(_node.value.str()) || util::isValidHex(_node.value.str()),
+			util::isValidDecimal(std::string(_node.value.str())) || util::isValidHex(std::string(_node.value.str())),
 			"Invalid number literal"
 		);
 		ret["kind"] = "number";
@@ -62,12 +62,12 @@ Json::Value AsmJsonConverter::operator()(Literal const& _node) const
 		break;
 	case LiteralKind::String:
 		ret["kind"] = "string";
-		ret["hexValue"] = util::toHex(util::asBytes(_node.value.str()));
+		ret["hexValue"] = util::toHex(util::asBytes(std::string(_node.value.str())));
 		break;
 	}
-	ret["type"] = _node.type.str();
-	if (util::validateUTF8(_node.value.str()))
-		ret["value"] = _node.value.str();
+	ret["type"] = std::string(_node.type.str());
+	if (util::validateUTF8(std::string(_node.value.str())))
+		ret["value"] = std::string(_node.value.str());
 	return ret;
 }
 
@@ -75,7 +75,7 @@ Json::Value AsmJsonConverter::operator()(Identifier const& _node) const
 {
 	yulAssert(!_node.name.empty(), "Invalid identifier");
 	Json::Value ret = createAstNode(originLocationOf(_node), nativeLocationOf(_node), "YulIdentifier");
-	ret["name"] = _node.name.str();
+	ret["name"] = std::string(_node.name.str());
 	return ret;
 }
 
@@ -119,7 +119,7 @@ Json::Value AsmJsonConverter::operator()(FunctionDefinition const& _node) const
 {
 	yulAssert(!_node.name.empty(), "Invalid function name.");
 	Json::Value ret = createAstNode(originLocationOf(_node), nativeLocationOf(_node), "YulFunctionDefinition");
-	ret["name"] = _node.name.str();
+	ret["name"] = std::string(_node.name.str());
 	for (auto const& var: _node.parameters)
 		ret["parameters"].append((*this)(var));
 	for (auto const& var: _node.returnVariables)
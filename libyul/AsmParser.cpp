@@ -66,8 +66,12 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 		case UseSourceLocationFrom::Scanner:
 			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			// All nodes carry the same location, so they can share a single object.
+			if (!m_locationOverrideDebugData)
+				m_locationOverrideDebugData = DebugData::create(m_locationOverride, m_locationOverride);
+			return m_locationOverrideDebugData;
 		case UseSourceLocationFrom::Comments:
+			// The native location differs for every node, so there is nothing to share here.
 			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
 	hypAssert(false, "");
@@ -397,7 +401,7 @@ Statement Parser::parseStatement()
 			auto const& identifier = std::get<Identifier>(elementary);
 
 			if (m_dialect.builtin(identifier.name))
-				fatalParserError(6272_error, "Cannot assign to builtin function \"" + identifier.name.str() + "\".");
+				fatalParserError(6272_error, "Cannot assign to builtin function \"" + std::string(identifier.name.str()) + "\".");
 
 			assignment.variableNames.emplace_back(identifier);
 
@@ -483,7 +487,7 @@ Expression Parser::parseExpression()
 				fatalParserError(
 					7104_error,
 					nativeLocationOf(_identifier),
-					"Builtin function \"" + _identifier.name.str() + "\" must be called."
+					"Builtin function \"" + std::string(_identifier.name.str()) + "\" must be called."
 				);
 			return std::move(_identifier);
 		},
@@ -675,7 +679,7 @@ YulString Parser::expectAsmIdentifier()
 {
 	YulString name{currentLiteral()};
 	if (currentToken() == Token::Identifier && m_dialect.builtin(name))
-		fatalParserError(5568_error, "Cannot use builtin function name \"" + name.str() + "\" as identifier name.");
+		fatalParserError(5568_error, "Cannot use builtin function name \"" + std::string(name.str()) + "\" as identifier name.");
 	// NOTE: We keep the expectation here to ensure the correct source location for the error above.
 	expectToken(Token::Identifier);
 	return name;
@@ -161,6 +161,8 @@ private:
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
 	UseSourceLocationFrom m_useSourceLocationFrom = UseSourceLocationFrom::Scanner;
+	/// Debug data shared by all nodes if the location is overridden.
+	mutable std::shared_ptr<DebugData const> m_locationOverrideDebugData;
 	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
 	bool m_insideFunction = false;
 };
@@ -49,8 +49,8 @@ std::string AsmPrinter::operator()(Literal const& _literal)
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
-		yulAssert(isValidDecimal(_literal.value.str()) || isValidHex(_literal.value.str()), "Invalid number literal");
-		return locationComment + _literal.value.str() + appendTypeName(_literal.type);
+		yulAssert(isValidDecimal(std::string(_literal.value.str())) || isValidHex(std::string(_literal.value.str())), "Invalid number literal");
+		return locationComment + std::string(_literal.value.str()) + appendTypeName(_literal.type);
 	case LiteralKind::Boolean:
 		yulAssert(_literal.value == "true"_yulstring || _literal.value == "false"_yulstring, "Invalid bool literal.");
 		return locationComment + ((_literal.value == "true"_yulstring) ? "true" : "false") + appendTypeName(_literal.type, true);
@@ -58,13 +58,13 @@ std::string AsmPrinter::operator()(Literal const& _literal)
 		break;
 	}
 
-	return locationComment + escapeAndQuoteString(_literal.value.str()) + appendTypeName(_literal.type);
+	return locationComment + escapeAndQuoteString(std::string(_literal.value.str())) + appendTypeName(_literal.type);
 }
 
 std::string AsmPrinter::operator()(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return formatDebugData(_identifier) + _identifier.name.str();
+	return formatDebugData(_identifier) + std::string(_identifier.name.str());
 }
 
 std::string AsmPrinter::operator()(ExpressionStatement const& _statement)
@@ -110,7 +110,7 @@ std::string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
 
 	std::string out = formatDebugData(_functionDefinition);
-	out += "function " + _functionDefinition.name.str() + "(";
+	out += "function " + std::string(_functionDefinition.name.str()) + "(";
 	out += boost::algorithm::join(
 		_functionDefinition.parameters | ranges::views::transform(
 			[this](TypedName argument) { return formatTypedName(argument); }
@@ -238,7 +238,7 @@ std::string AsmPrinter::operator()(Block const& _block)
 std::string AsmPrinter::formatTypedName(TypedName _variable)
 {
 	yulAssert(!_variable.name.empty(), "Invalid variable name.");
-	return formatDebugData(_variable) + _variable.name.str() + appendTypeName(_variable.type);
+	return formatDebugData(_variable) + std::string(_variable.name.str()) + appendTypeName(_variable.type);
 }
 
 std::string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
@@ -254,7 +254,7 @@ std::string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) con
 	if (_type.empty())
 		return {};
 	else
-		return ":" + _type.str();
+		return ":" + std::string(_type.str());
 }
 
 std::string AsmPrinter::formatSourceLocation(
@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
 
+#include <mutex>
+
 using namespace hyperion::yul;
 using namespace hyperion::langutil;
 
@@ -51,9 +53,11 @@ bool Dialect::validTypeForLiteral(LiteralKind _kind, YulString, YulString _type)
 
 Dialect const& Dialect::yulDeprecated()
 {
+	static std::mutex mutex;
 	static std::unique_ptr<Dialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard lock(mutex); dialect.reset(); }};
 
+	std::lock_guard lock(mutex);
 	if (!dialect)
 	{
 		// TODO will probably change, especially the list of types.
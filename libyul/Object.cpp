@@ -40,7 +40,7 @@ using namespace hyperion::yul;
 
 std::string Data::toString(Dialect const*, DebugInfoSelection const&, CharStreamProvider const*) const
 {
-	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
+	return "data \"" + std::string(name.str()) + "\" hex\"" + util::toHex(data) + "\"";
 }
 
 std::string Object::toString(
@@ -72,7 +72,7 @@ std::string Object::toString(
 	for (auto const& obj: subObjects)
 		inner += "\n" + obj->toString(_dialect, _debugInfoSelection, _hyperionSourceProvider);
 
-	return useSrcComment + "object \"" + name.str() + "\" {\n" + indent(inner) + "\n}";
+	return useSrcComment + "object \"" + std::string(name.str()) + "\" {\n" + indent(inner) + "\n}";
 }
 
 Json::Value Data::toJson() const
@@ -97,7 +97,7 @@ Json::Value Object::toJson() const
 
 	Json::Value ret{Json::objectValue};
 	ret["nodeType"] = "YulObject";
-	ret["name"] = name.str();
+	ret["name"] = std::string(name.str());
 	ret["code"] = codeJson;
 	ret["subObjects"] = subObjectsJson;
 	return ret;
@@ -119,8 +119,8 @@ std::set<YulString> Object::qualifiedDataNames() const
 			for (YulString const& subSubObj: subObject->qualifiedDataNames())
 				if (subObject->name != subSubObj)
 				{
-					yulAssert(qualifiedNames.count(YulString{subObject->name.str() + "." + subSubObj.str()}) == 0, "");
-					qualifiedNames.insert(YulString{subObject->name.str() + "." + subSubObj.str()});
+					yulAssert(qualifiedNames.count(YulString{std::string(subObject->name.str()) + "." + std::string(subSubObj.str())}) == 0, "");
+					qualifiedNames.insert(YulString{std::string(subObject->name.str()) + "." + std::string(subSubObj.str())});
 				}
 	}
 
@@ -134,7 +134,7 @@ std::vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 	yulAssert(_qualifiedName != name, "");
 	yulAssert(subIndexByName.count(name) == 0, "");
 
-	if (boost::algorithm::starts_with(_qualifiedName.str(), name.str() + "."))
+	if (boost::algorithm::starts_with(_qualifiedName.str(), std::string(name.str()) + "."))
 		_qualifiedName = YulString{_qualifiedName.str().substr(name.str().length() + 1)};
 	yulAssert(!_qualifiedName.empty(), "");
 
@@ -149,10 +149,10 @@ std::vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 		auto subIndexIt = object->subIndexByName.find(YulString{currentSubObjectName});
 		yulAssert(
 			subIndexIt != object->subIndexByName.end(),
-			"Assembly object <" + _qualifiedName.str() + "> not found or does not contain code."
+			"Assembly object <" + std::string(_qualifiedName.str()) + "> not found or does not contain code."
 		);
 		object = dynamic_cast<Object const*>(object->subObjects[subIndexIt->second].get());
-		yulAssert(object, "Assembly object <" + _qualifiedName.str() + "> not found or does not contain code.");
+		yulAssert(object, "Assembly object <" + std::string(_qualifiedName.str()) + "> not found or does not contain code.");
 		yulAssert(object->subId != std::numeric_limits<size_t>::max(), "");
 		path.push_back({object->subId});
 	}
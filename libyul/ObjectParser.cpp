@@ -204,7 +204,7 @@ YulString ObjectParser::parseUniqueName(Object const* _containingObject)
 	else if (_containingObject && _containingObject->name == name)
 		parserError(8311_error, "Object name cannot be the same as the name of the containing object.");
 	else if (_containingObject && _containingObject->subIndexByName.count(name))
-		parserError(8794_error, "Object name \"" + name.str() + "\" already exists inside the containing object.");
+		parserError(8794_error, "Object name \"" + std::string(name.str()) + "\" already exists inside the containing object.");
 	advance();
 	return name;
 }
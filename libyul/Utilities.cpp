@@ -90,13 +90,20 @@ u256 hyperion::yul::valueOfNumberLiteral(Literal const& _literal)
 {
 	yulAssert(_literal.kind == LiteralKind::Number, "Expected number literal!");
 
-	static std::map<YulString, u256> numberCache;
-	static YulStringRepository::ResetCallback callback{[&] { numberCache.clear(); }};
+	// Thread-local, so that concurrent optimiser runs do not contend on a lock.
+	// Entries are keyed by YulString and become stale when the repository is reset.
+	thread_local std::map<YulString, u256> numberCache;
+	thread_local size_t cacheGeneration = YulStringRepository::generation();
+	if (cacheGeneration != YulStringRepository::generation())
+	{
+		numberCache.clear();
+		cacheGeneration = YulStringRepository::generation();
+	}
 
 	auto&& [it, isNew] = numberCache.try_emplace(_literal.value, 0);
 	if (isNew)
 	{
-		std::string const& literalString = _literal.value.str();
+		std::string const literalString(_literal.value.str());
 		yulAssert(isValidDecimal(literalString) || isValidHex(literalString), "Invalid number literal!");
 		it->second = u256(literalString);
 	}
@@ -108,7 +115,7 @@ u256 hyperion::yul::valueOfStringLiteral(Literal const& _literal)
 	yulAssert(_literal.kind == LiteralKind::String, "Expected string literal!");
 	yulAssert(_literal.value.str().size() <= 32, "Literal string too long!");
 
-	return u256(h256(_literal.value.str(), h256::FromBinary, h256::AlignLeft));
+	return u256(h256(std::string(_literal.value.str()), h256::FromBinary, h256::AlignLeft));
 }
 
 u256 yul::valueOfBoolLiteral(Literal const& _literal)
@@ -30,11 +30,15 @@
 #include <libyul/backends/qrvm/QRVMObjectCompiler.h>
 #include <libyul/backends/qrvm/QRVMMetrics.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/Suite.h>
 #include <libqrvmasm/Assembly.h>
+#include <liblangutil/Common.h>
 #include <liblangutil/Scanner.h>
 #include <libhyperion/interface/OptimiserSettings.h>
+#include <libhyputil/ThreadPool.h>
+#include <libhyputil/TimeReport.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -61,6 +65,96 @@ Dialect const& languageToDialect(YulStack::Language _language, QRVMVersion _vers
 	return Dialect::yulDeprecated();
 }
 
+/// @returns the positions in @a _target of the non-whitespace characters of @a _source, indexed by
+/// their positions in @a _source, starting at @a _sourceStart and @a _targetStart, respectively.
+/// All other positions are mapped to -1. Empty if the texts differ in more than whitespace.
+std::vector<int> matchNonWhiteSpace(
+	std::string_view _source,
+	size_t _sourceStart,
+	std::string_view _target,
+	size_t _targetStart
+)
+{
+	std::vector<int> positions(_source.size(), -1);
+	size_t targetPosition = _targetStart;
+	for (size_t sourcePosition = _sourceStart; sourcePosition < _source.size(); ++sourcePosition)
+	{
+		if (isWhiteSpace(_source[sourcePosition]))
+			continue;
+		while (targetPosition < _target.size() && isWhiteSpace(_target[targetPosition]))
+			++targetPosition;
+		if (targetPosition == _target.size() || _target[targetPosition] != _source[sourcePosition])
+			return {};
+		positions[sourcePosition] = static_cast<int>(targetPosition++);
+	}
+	return positions;
+}
+
+/// Copies code and translates its native locations using a mapping of positions created by
+/// matchNonWhiteSpace(). Locations that cannot be translated are dropped.
+class NativeLocationTranslator: public ASTCopier
+{
+public:
+	NativeLocationTranslator(std::vector<int> _positions, std::shared_ptr<std::string const> _sourceName):
+		m_positions(std::move(_positions)),
+		m_sourceName(std::move(_sourceName))
+	{}
+
+protected:
+	std::shared_ptr<DebugData const> translateDebugData(std::shared_ptr<DebugData const> const& _debugData) override
+	{
+		if (!_debugData)
+			return _debugData;
+		// Debug data shared by several nodes stays shared.
+		std::shared_ptr<DebugData const>& translated = m_translated[_debugData.get()];
+		if (!translated)
+		{
+			SourceLocation nativeLocation = translateLocation(_debugData->nativeLocation);
+			// Without @src comments, the parser uses the native location as origin as well.
+			SourceLocation originLocation =
+				_debugData->originLocation == _debugData->nativeLocation ?
+				nativeLocation :
+				_debugData->originLocation;
+			translated = DebugData::create(std::move(nativeLocation), std::move(originLocation), _debugData->astID);
+		}
+		return translated;
+	}
+
+private:
+	int translatePosition(int _position) const
+	{
+		if (_position < 0 || static_cast<size_t>(_position) >= m_positions.size())
+			return -1;
+		return m_positions[static_cast<size_t>(_position)];
+	}
+
+	SourceLocation translateLocation(SourceLocation const& _location) const
+	{
+		// Locations start at a token and end after one, so both ends are next to non-whitespace characters.
+		int start = translatePosition(_location.start);
+		int end = _location.end > _location.start ? translatePosition(_location.end - 1) + 1 : start;
+		if (start < 0 || end <= 0)
+			return {};
+		return SourceLocation{start, end, m_sourceName};
+	}
+
+	std::vector<int> m_positions;
+	std::shared_ptr<std::string const> m_sourceName;
+	std::map<DebugData const*, std::shared_ptr<DebugData const>> m_translated;
+};
+
+/// Copies the tree rooted at @a _object, sharing data, so that the copy can be analyzed without
+/// modifying the original. The code is copied using @a _copier.
+std::shared_ptr<Object> copyObjectTree(Object const& _object, ASTCopier& _copier)
+{
+	auto copy = std::make_shared<Object>(_object);
+	copy->code = std::make_shared<Block>(_copier.translate(*_object.code));
+	for (auto& subNode: copy->subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			subNode = copyObjectTree(*subObject, _copier);
+	return copy;
+}
+
 }
 
 
@@ -86,7 +180,10 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
-void YulStack::optimize()
+void YulStack::optimize(
+	std::map<std::string, std::shared_ptr<YulStack const>> const& _optimizedStacks,
+	util::ThreadPool* _threadPool
+)
 {
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
 	yulAssert(m_parserResult);
@@ -99,7 +196,7 @@ void YulStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+	optimize(*m_parserResult, true, _optimizedStacks, _threadPool);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -150,17 +247,69 @@ void YulStack::compileQRVM(AbstractAssembly& _assembly, bool _optimize) const
 	QRVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize);
 }
 
-void YulStack::optimize(Object& _object, bool _isCreation)
+void YulStack::optimize(
+	Object& _object,
+	bool _isCreation,
+	std::map<std::string, std::shared_ptr<YulStack const>> const& _optimizedStacks,
+	util::ThreadPool* _threadPool
+)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+	std::vector<Object*> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
-			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
+			if (auto optimizedStack = _optimizedStacks.find(std::string(subObject->name.str())); optimizedStack != _optimizedStacks.end())
+			{
+				// The copy is re-analyzed after optimization, while the original may be in use elsewhere.
+				// The native locations of the optimized object refer to the source of the other stack,
+				// which is contained in this source apart from indentation, starting at the same header.
+				YulStack const& stack = *optimizedStack->second;
+				yulAssert(stack.m_charStream && stack.m_parserResult, "");
+				std::string const header = "object \"" + optimizedStack->first + "\"";
+				std::string_view const source = stack.m_charStream->source();
+				SourceLocation const location = nativeLocationOf(*subObject->code);
+				size_t const sourceStart = source.find(header);
+				size_t const targetStart =
+					location.start >= 0 ?
+					m_charStream->source().rfind(header, static_cast<size_t>(location.start)) :
+					std::string::npos;
+				std::vector<int> positions;
+				if (sourceStart != std::string::npos && targetStart != std::string::npos)
+					positions = matchNonWhiteSpace(source, sourceStart, m_charStream->source(), targetStart);
+				NativeLocationTranslator translator(std::move(positions), location.sourceName);
+				std::shared_ptr<Object> copy = copyObjectTree(*stack.m_parserResult, translator);
+				copy->subId = subObject->subId;
+				subNode = std::move(copy);
+				continue;
+			}
+			subObjects.push_back(subObject);
 		}
 
+	auto const optimizeSubObject = [&](size_t _index) {
+		Object& subObject = *subObjects[_index];
+		bool isCreation = !boost::ends_with(subObject.name.str(), "_deployed");
+		optimize(subObject, isCreation, _optimizedStacks, _threadPool);
+	};
+	if (_threadPool && subObjects.size() > 1)
+	{
+		// Sibling objects do not share any code, so they can be optimized independently.
+		util::TimeReport* timeReport = util::TimeReport::current();
+		std::string const& timeReportUnit = util::TimeReport::currentUnit();
+		std::vector<std::exception_ptr> failures = _threadPool->parallelFor(subObjects.size(), [&](size_t _index) {
+			util::TimeReport::ScopedUnit scopedUnit(timeReport, timeReportUnit);
+			optimizeSubObject(_index);
+		});
+		// Report the failure a sequential run would have run into first.
+		for (std::exception_ptr const& failure: failures)
+			if (failure)
+				std::rethrow_exception(failure);
+	}
+	else
+		for (size_t index = 0; index < subObjects.size(); ++index)
+			optimizeSubObject(index);
+
 	Dialect const& dialect = languageToDialect(m_language, m_qrvmVersion);
 	std::unique_ptr<GasMeter> meter;
 	if (QRVMDialect const* qrvmDialect = dynamic_cast<QRVMDialect const*>(&dialect))
@@ -255,7 +404,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName) cons
 }
 
 std::pair<std::shared_ptr<qrvmasm::Assembly>, std::shared_ptr<qrvmasm::Assembly>>
-YulStack::assembleQRVMWithDeployed(std::optional<std::string_view> _deployName) const
+YulStack::assembleQRVMWithDeployed(std::optional<std::string_view> _deployName, util::ThreadPool* _threadPool) const
 {
 	yulAssert(m_analysisSuccessful, "");
 	yulAssert(m_parserResult, "");
@@ -272,9 +421,15 @@ YulStack::assembleQRVMWithDeployed(std::optional<std::string_view> _deployName)
 		!m_optimiserSettings.runYulOptimiser &&
 		!yul::MSizeFinder::containsMSize(languageToDialect(m_language, m_qrvmVersion), *m_parserResult)
 	);
-	compileQRVM(adapter, optimize);
+	{
+		util::TimeReport::ScopedPhase phase("qrvmCodeTransform");
+		compileQRVM(adapter, optimize);
+	}
 
-	assembly.optimise(qrvmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_qrvmVersion));
+	assembly.optimise(
+		qrvmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_qrvmVersion),
+		_threadPool
+	);
 
 	std::optional<size_t> subIndex;
 
@@ -35,6 +35,7 @@
 
 #include <json/json.h>
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -48,6 +49,11 @@ namespace hyperion::langutil
 class Scanner;
 }
 
+namespace hyperion::util
+{
+class ThreadPool;
+}
+
 namespace hyperion::yul
 {
 class AbstractAssembly;
@@ -100,7 +106,17 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// Sub-objects named like a key of @a _optimizedStacks are not optimized again but replaced
+	/// by a copy of the object of the mapped stack. That stack has to be the result of optimizing
+	/// the same object with the same settings, and its source has to be contained in the source
+	/// of this stack apart from whitespace. The native locations of the copy are translated
+	/// into the source of this stack, or dropped if that is not possible.
+	/// If @a _threadPool is given, sibling sub-objects are optimized concurrently on it.
+	/// The result does not depend on the order in which they finish.
+	void optimize(
+		std::map<std::string, std::shared_ptr<YulStack const>> const& _optimizedStacks = {},
+		util::ThreadPool* _threadPool = nullptr
+	);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine) const;
@@ -116,10 +132,12 @@ public:
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	/// Similar to @a assemblyWithDeployed, but returns QRVM assembly objects.
+	/// If @a _threadPool is given, sub-assemblies are optimised concurrently on it.
 	/// Only available for QRVM.
 	std::pair<std::shared_ptr<qrvmasm::Assembly>, std::shared_ptr<qrvmasm::Assembly>>
 	assembleQRVMWithDeployed(
-		std::optional<std::string_view> _deployName = {}
+		std::optional<std::string_view> _deployName = {},
+		util::ThreadPool* _threadPool = nullptr
 	) const;
 
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
@@ -139,7 +157,12 @@ private:
 
 	void compileQRVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	void optimize(
+		yul::Object& _object,
+		bool _isCreation,
+		std::map<std::string, std::shared_ptr<YulStack const>> const& _optimizedStacks,
+		util::ThreadPool* _threadPool
+	);
 
 	Language m_language = Language::Assembly;
 	langutil::QRVMVersion m_qrvmVersion;
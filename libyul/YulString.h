@@ -23,10 +23,16 @@
 
 #include <fmt/format.h>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <functional>
 
 namespace hyperion::yul
@@ -34,14 +40,19 @@ namespace hyperion::yul
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// A Handle consists of a pointer to the stored string (whose value depends on the insertion order
+/// of YulStrings and is potentially non-deterministic) and a deterministic string hash.
+/// The strings are stored in shards selected by their hash, each of which copies their characters
+/// into a bump-allocated arena of large chunks. Insertions only lock the shard they go to and
+/// resolving a Handle to its string does not lock at all, so that YulStrings can be created
+/// and used concurrently.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		/// The characters of the string, preceded by its length (see Arena).
+		char const* data;
 		std::uint64_t hash;
 	};
 
@@ -51,24 +62,67 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string_view _string)
 	{
 		if (_string.empty())
-			return { 0, emptyHash() };
+			return emptyHandle();
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		Shard& shard = m_shards[h % ShardCount];
+		{
+			std::shared_lock lock(shard.mutex);
+			if (char const* stored = shard.find(_string, h))
+				return Handle{stored, h};
+		}
+		std::unique_lock lock(shard.mutex);
+		// Another thread may have inserted the string in the meantime.
+		if (char const* stored = shard.find(_string, h))
+			return Handle{stored, h};
+		char const* stored = shard.arena.store(_string);
+		shard.hashToString.emplace(h, stored);
+
+		return Handle{stored, h};
+	}
+
+	static Handle emptyHandle()
+	{
+		// A length of zero and no characters.
+		alignas(size_t) static char const empty[sizeof(size_t)] = {};
+		return Handle{empty + sizeof(size_t), emptyHash()};
+	}
+
+	/// @returns the string stored at @a _data, which has to come from a Handle.
+	static std::string_view view(char const* _data)
+	{
+		size_t size = 0;
+		std::memcpy(&size, _data - sizeof(size), sizeof(size));
+		return {_data, size};
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
-	static std::uint64_t hash(std::string const& v)
+	/// @returns the number of distinct non-empty strings in the repository.
+	size_t size() const
+	{
+		size_t count = 0;
+		for (Shard const& shard: m_shards)
+		{
+			std::shared_lock lock(shard.mutex);
+			count += shard.hashToString.size();
+		}
+		return count;
+	}
+
+	/// @returns the number of bytes allocated for the arenas of all shards.
+	size_t arenaCapacity() const
+	{
+		size_t capacity = 0;
+		for (Shard const& shard: m_shards)
+		{
+			std::shared_lock lock(shard.mutex);
+			capacity += shard.arena.capacity();
+		}
+		return capacity;
+	}
+
+	static std::uint64_t hash(std::string_view v)
 	{
 		// FNV hash - can be replaced by a better one, e.g. xxhash64
 		std::uint64_t hash = emptyHash();
@@ -81,41 +135,145 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
+	/// Clear the repository and release the memory held by its strings.
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
+		// The callbacks are copied, so that they run without holding the lock. They take locks
+		// of their own, and registering a callback must not wait for them.
+		std::vector<std::function<void()>> callbacks;
+		{
+			ResetCallbacks& registered = resetCallbacks();
+			std::lock_guard lock(registered.mutex);
+			callbacks = registered.functions;
+		}
+		for (auto const& cb: callbacks)
 			cb();
-		instance() = YulStringRepository{};
+		instance().clear();
+		++generationCounter();
 	}
+	/// @returns the number of resets so far. Caches that cannot register a reset callback,
+	/// e.g. because they are thread-local, can compare it to detect stale entries.
+	static size_t generation() { return generationCounter().load(std::memory_order_relaxed); }
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+			// Function-local statics that register callbacks are first initialised by whichever
+			// compilation thread gets there first.
+			ResetCallbacks& registered = YulStringRepository::resetCallbacks();
+			std::lock_guard lock(registered.mutex);
+			registered.functions.emplace_back(std::move(_fun));
 		}
 	};
 
 private:
+	static constexpr size_t ShardCount = 16;
+
+	/// Bump allocator that stores each string as its length followed by its characters.
+	/// Memory is only released as a whole, so that the stored strings keep their address.
+	class Arena
+	{
+	public:
+		/// @returns a pointer to the stored characters of @a _string.
+		char const* store(std::string_view _string)
+		{
+			size_t const length = _string.size();
+			// Keeps the length fields aligned.
+			size_t const required = (sizeof(length) + length + alignof(size_t) - 1) / alignof(size_t) * alignof(size_t);
+			char* position = nullptr;
+			if (required > ChunkSize / 4)
+				// Large strings get a chunk of their own, so that the rest of the current chunk is not lost.
+				position = allocate(required);
+			else
+			{
+				if (required > m_available)
+				{
+					m_next = allocate(ChunkSize);
+					m_available = ChunkSize;
+				}
+				position = m_next;
+				m_next += required;
+				m_available -= required;
+			}
+			std::memcpy(position, &length, sizeof(length));
+			std::memcpy(position + sizeof(length), _string.data(), length);
+			return position + sizeof(length);
+		}
+
+		size_t capacity() const { return m_capacity; }
+
+	private:
+		static constexpr size_t ChunkSize = 64 * 1024;
+
+		char* allocate(size_t _size)
+		{
+			m_chunks.emplace_back(new char[_size]);
+			m_capacity += _size;
+			return m_chunks.back().get();
+		}
+
+		std::vector<std::unique_ptr<char[]>> m_chunks;
+		char* m_next = nullptr;
+		size_t m_available = 0;
+		size_t m_capacity = 0;
+	};
+
+	struct Shard
+	{
+		/// @returns the stored copy of @a _string with hash @a _hash if it is already present.
+		/// Requires the caller to hold a lock on mutex.
+		char const* find(std::string_view _string, std::uint64_t _hash) const
+		{
+			auto range = hashToString.equal_range(_hash);
+			for (auto it = range.first; it != range.second; ++it)
+				if (view(it->second) == _string)
+					return it->second;
+			return nullptr;
+		}
+
+		Arena arena;
+		std::unordered_multimap<std::uint64_t, char const*> hashToString;
+		mutable std::shared_mutex mutex;
+	};
+
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	void clear()
 	{
-		static std::vector<std::function<void()>> callbacks;
+		for (Shard& shard: m_shards)
+		{
+			std::unique_lock lock(shard.mutex);
+			shard.hashToString = {};
+			shard.arena = {};
+		}
+	}
+
+	struct ResetCallbacks
+	{
+		std::mutex mutex;
+		std::vector<std::function<void()>> functions;
+	};
+
+	static ResetCallbacks& resetCallbacks()
+	{
+		static ResetCallbacks callbacks;
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	static std::atomic<size_t>& generationCounter()
+	{
+		static std::atomic<size_t> counter{0};
+		return counter;
+	}
+
+	std::array<Shard, ShardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -126,7 +284,7 @@ class YulString
 {
 public:
 	YulString() = default;
-	explicit YulString(std::string const& _s): m_handle(YulStringRepository::instance().stringToHandle(_s)) {}
+	explicit YulString(std::string_view _s): m_handle(YulStringRepository::instance().stringToHandle(_s)) {}
 	YulString(YulString const&) = default;
 	YulString(YulString&&) = default;
 	YulString& operator=(YulString const&) = default;
@@ -134,37 +292,35 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical handles (only identical strings have
+	/// identical handles and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.data == _other.m_handle.data) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the handle.
+	bool operator==(YulString const& _other) const { return m_handle.data == _other.m_handle.data; }
+	bool operator!=(YulString const& _other) const { return m_handle.data != _other.m_handle.data; }
 
-	bool empty() const { return m_handle.id == 0; }
-	std::string const& str() const
-	{
-		return YulStringRepository::instance().idToString(m_handle.id);
-	}
+	bool empty() const { return str().empty(); }
+	/// @returns the characters of the string, which stay valid until the repository is reset.
+	std::string_view str() const { return YulStringRepository::view(m_handle.data); }
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string. Only the empty string is not stored in the repository.
+	YulStringRepository::Handle m_handle = YulStringRepository::emptyHandle();
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
 {
-	return YulString(std::string(_string, _size));
+	return YulString(std::string_view(_string, _size));
 }
 
 }
@@ -195,7 +195,7 @@ OptimizedQRVMCodeTransform::OptimizedQRVMCodeTransform(
 			bool useNamedLabel = _useNamedLabelsForFunctions != UseNamedLabels::Never && !nameAlreadySeen;
 			functionLabels[&functionInfo] = useNamedLabel ?
 				m_assembly.namedLabel(
-					function->name.str(),
+					std::string(function->name.str()),
 					function->arguments.size(),
 					function->returns.size(),
 					functionInfo.debugData ? functionInfo.debugData->astID : std::nullopt
@@ -267,8 +267,8 @@ void OptimizedQRVMCodeTransform::createStackLayout(std::shared_ptr<DebugData con
 				YulString varNameDeep = slotVariableName(deepSlot);
 				YulString varNameTop = slotVariableName(m_stack.back());
 				std::string msg =
-					"Cannot swap " + (varNameDeep.empty() ? "Slot " + stackSlotToString(deepSlot) : "Variable " + varNameDeep.str()) +
-					" with " + (varNameTop.empty() ? "Slot " + stackSlotToString(m_stack.back()) : "Variable " + varNameTop.str()) +
+					"Cannot swap " + (varNameDeep.empty() ? "Slot " + stackSlotToString(deepSlot) : "Variable " + std::string(varNameDeep.str())) +
+					" with " + (varNameTop.empty() ? "Slot " + stackSlotToString(m_stack.back()) : "Variable " + std::string(varNameTop.str())) +
 					": too deep in the stack by " + std::to_string(deficit) + " slots in " + stackToString(m_stack);
 				m_stackErrors.emplace_back(StackTooDeepError(
 					m_currentFunctionInfo ? m_currentFunctionInfo->function.name : YulString{},
@@ -297,7 +297,7 @@ void OptimizedQRVMCodeTransform::createStackLayout(std::shared_ptr<DebugData con
 					int deficit = static_cast<int>(*depth - 15);
 					YulString varName = slotVariableName(_slot);
 					std::string msg =
-						(varName.empty() ? "Slot " + stackSlotToString(_slot) : "Variable " + varName.str())
+						(varName.empty() ? "Slot " + stackSlotToString(_slot) : "Variable " + std::string(varName.str()))
 						+ " is " + std::to_string(*depth - 15) + " too deep in the stack " + stackToString(m_stack);
 					m_stackErrors.emplace_back(StackTooDeepError(
 						m_currentFunctionInfo ? m_currentFunctionInfo->function.name : YulString{},
@@ -460,7 +460,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 				YulString{},
 				static_cast<int>(stackLayout.size()) - 17,
 				"The function " +
-				_function.name.str() +
+				std::string(_function.name.str()) +
 				" has " +
 				std::to_string(stackLayout.size() - 17) +
 				" parameters or return variables too many to fit the stack size."
@@ -602,7 +602,7 @@ void CodeTransform::createFunctionEntryID(FunctionDefinition const& _function)
 			!nameAlreadySeen
 		) ?
 		m_assembly.namedLabel(
-			_function.name.str(),
+			std::string(_function.name.str()),
 			_function.parameters.size(),
 			_function.returnVariables.size(),
 			astID
@@ -783,7 +783,7 @@ size_t CodeTransform::variableHeightDiff(Scope::Variable const& _var, YulString
 			_varName,
 			heightDiff - limit,
 			"Variable " +
-			_varName.str() +
+			std::string(_varName.str()) +
 			" is " +
 			std::to_string(heightDiff - limit) +
 			" slot(s) too deep inside the stack. " +
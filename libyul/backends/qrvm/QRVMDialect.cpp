@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std::string_literals;
@@ -157,7 +158,7 @@ std::map<YulString, BuiltinFunctionForQRVM> createBuiltins(bool _objectAccess)
 		) {
 			yulAssert(_call.arguments.size() == 1, "");
 			Expression const& arg = _call.arguments.front();
-			_assembly.appendLinkerSymbol(std::get<Literal>(arg).value.str());
+			_assembly.appendLinkerSymbol(std::string(std::get<Literal>(arg).value.str()));
 		}));
 
 		builtins.emplace(createFunction(
@@ -195,7 +196,7 @@ std::map<YulString, BuiltinFunctionForQRVM> createBuiltins(bool _objectAccess)
 					_context.subIDs.count(dataName) == 0 ?
 						_context.currentObject->pathToSubObject(dataName) :
 						std::vector<size_t>{_context.subIDs.at(dataName)};
-				yulAssert(!subIdPath.empty(), "Could not find assembly object <" + dataName.str() + ">.");
+				yulAssert(!subIdPath.empty(), "Could not find assembly object <" + std::string(dataName.str()) + ">.");
 				_assembly.appendDataSize(subIdPath);
 			}
 		}));
@@ -216,7 +217,7 @@ std::map<YulString, BuiltinFunctionForQRVM> createBuiltins(bool _objectAccess)
 					_context.subIDs.count(dataName) == 0 ?
 						_context.currentObject->pathToSubObject(dataName) :
 						std::vector<size_t>{_context.subIDs.at(dataName)};
-				yulAssert(!subIdPath.empty(), "Could not find assembly object <" + dataName.str() + ">.");
+				yulAssert(!subIdPath.empty(), "Could not find assembly object <" + std::string(dataName.str()) + ">.");
 				_assembly.appendDataOffset(subIdPath);
 			}
 		}));
@@ -247,7 +248,7 @@ std::map<YulString, BuiltinFunctionForQRVM> createBuiltins(bool _objectAccess)
 			) {
 				yulAssert(_call.arguments.size() == 3, "");
 				YulString identifier = std::get<Literal>(_call.arguments[1]).value;
-				_assembly.appendImmutableAssignment(identifier.str());
+				_assembly.appendImmutableAssignment(std::string(identifier.str()));
 			}
 		));
 		builtins.emplace(createFunction(
@@ -262,7 +263,7 @@ std::map<YulString, BuiltinFunctionForQRVM> createBuiltins(bool _objectAccess)
 				BuiltinContext&
 			) {
 				yulAssert(_call.arguments.size() == 1, "");
-				_assembly.appendImmutable(std::get<Literal>(_call.arguments.front()).value.str());
+				_assembly.appendImmutable(std::string(std::get<Literal>(_call.arguments.front()).value.str()));
 			}
 		));
 	}
@@ -290,8 +291,9 @@ BuiltinFunctionForQRVM const* QRVMDialect::builtin(YulString _name) const
 {
 	if (m_objectAccess)
 	{
+		std::string const name(_name.str());
 		std::smatch match;
-		if (regex_match(_name.str(), match, verbatimPattern()))
+		if (regex_match(name, match, verbatimPattern()))
 			return verbatimFunction(stoul(match[1]), stoul(match[2]));
 	}
 	auto it = m_functions.find(_name);
@@ -311,8 +313,10 @@ bool QRVMDialect::reservedIdentifier(YulString _name) const
 
 QRVMDialect const& QRVMDialect::strictAssemblyForQRVM(langutil::QRVMVersion _version)
 {
+	static std::mutex mutex;
 	static std::map<langutil::QRVMVersion, std::unique_ptr<QRVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard lock(mutex); dialects.clear(); }};
+	std::lock_guard lock(mutex);
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<QRVMDialect>(_version, false);
 	return *dialects[_version];
@@ -320,8 +324,10 @@ QRVMDialect const& QRVMDialect::strictAssemblyForQRVM(langutil::QRVMVersion _ver
 
 QRVMDialect const& QRVMDialect::strictAssemblyForQRVMObjects(langutil::QRVMVersion _version)
 {
+	static std::mutex mutex;
 	static std::map<langutil::QRVMVersion, std::unique_ptr<QRVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard lock(mutex); dialects.clear(); }};
+	std::lock_guard lock(mutex);
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<QRVMDialect>(_version, true);
 	return *dialects[_version];
@@ -349,6 +355,7 @@ SideEffects QRVMDialect::sideEffectsOfInstruction(qrvmasm::Instruction _instruct
 BuiltinFunctionForQRVM const* QRVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	std::pair<size_t, size_t> key{_arguments, _returnVariables};
+	std::lock_guard lock(m_verbatimFunctionsMutex);
 	std::shared_ptr<BuiltinFunctionForQRVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -367,7 +374,7 @@ BuiltinFunctionForQRVM const* QRVMDialect::verbatimFunction(size_t _arguments, s
 				Expression const& bytecode = _call.arguments.front();
 
 				_assembly.appendVerbatim(
-					asBytes(std::get<Literal>(bytecode).value.str()),
+					asBytes(std::string(std::get<Literal>(bytecode).value.str())),
 					_arguments,
 					_returnVariables
 				);
@@ -475,8 +482,10 @@ BuiltinFunctionForQRVM const* QRVMDialectTyped::equalityFunction(YulString _type
 
 QRVMDialectTyped const& QRVMDialectTyped::instance(langutil::QRVMVersion _version)
 {
+	static std::mutex mutex;
 	static std::map<langutil::QRVMVersion, std::unique_ptr<QRVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static YulStringRepository::ResetCallback callback{[&] { std::lock_guard lock(mutex); dialects.clear(); }};
+	std::lock_guard lock(mutex);
 	if (!dialects[_version])
 		dialects[_version] = std::make_unique<QRVMDialectTyped>(_version, true);
 	return *dialects[_version];
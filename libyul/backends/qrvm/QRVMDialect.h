@@ -28,6 +28,7 @@
 #include <liblangutil/QRVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace hyperion::yul
@@ -100,6 +101,8 @@ protected:
 	langutil::QRVMVersion const m_qrvmVersion;
 	std::map<YulString, BuiltinFunctionForQRVM> m_functions;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForQRVM const>> mutable m_verbatimFunctions;
+	/// Guards m_verbatimFunctions, since dialects are shared between compilation threads.
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::set<YulString> m_reserved;
 };
 
@@ -55,7 +55,7 @@ void QRVMObjectCompiler::run(Object& _object, bool _optimize)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name.str());
+			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, std::string(subObject->name.str()));
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
 			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize);
@@ -31,13 +31,13 @@ using namespace hyperion::util;
 
 Statement ASTCopier::operator()(ExpressionStatement const& _statement)
 {
-	return ExpressionStatement{ _statement.debugData, translate(_statement.expression) };
+	return ExpressionStatement{ translateDebugData(_statement.debugData), translate(_statement.expression) };
 }
 
 Statement ASTCopier::operator()(VariableDeclaration const& _varDecl)
 {
 	return VariableDeclaration{
-		_varDecl.debugData,
+		translateDebugData(_varDecl.debugData),
 		translateVector(_varDecl.variables),
 		translate(_varDecl.value)
 	};
@@ -46,7 +46,7 @@ Statement ASTCopier::operator()(VariableDeclaration const& _varDecl)
 Statement ASTCopier::operator()(Assignment const& _assignment)
 {
 	return Assignment{
-		_assignment.debugData,
+		translateDebugData(_assignment.debugData),
 		translateVector(_assignment.variableNames),
 		translate(_assignment.value)
 	};
@@ -55,7 +55,7 @@ Statement ASTCopier::operator()(Assignment const& _assignment)
 Expression ASTCopier::operator()(FunctionCall const& _call)
 {
 	return FunctionCall{
-		_call.debugData,
+		translateDebugData(_call.debugData),
 		translate(_call.functionName),
 		translateVector(_call.arguments)
 	};
@@ -73,12 +73,12 @@ Expression ASTCopier::operator()(Literal const& _literal)
 
 Statement ASTCopier::operator()(If const& _if)
 {
-	return If{_if.debugData, translate(_if.condition), translate(_if.body)};
+	return If{translateDebugData(_if.debugData), translate(_if.condition), translate(_if.body)};
 }
 
 Statement ASTCopier::operator()(Switch const& _switch)
 {
-	return Switch{_switch.debugData, translate(_switch.expression), translateVector(_switch.cases)};
+	return Switch{translateDebugData(_switch.debugData), translate(_switch.expression), translateVector(_switch.cases)};
 }
 
 Statement ASTCopier::operator()(FunctionDefinition const& _function)
@@ -89,7 +89,7 @@ Statement ASTCopier::operator()(FunctionDefinition const& _function)
 	ScopeGuard g([&]() { this->leaveFunction(_function); });
 
 	return FunctionDefinition{
-		_function.debugData,
+		translateDebugData(_function.debugData),
 		translatedName,
 		translateVector(_function.parameters),
 		translateVector(_function.returnVariables),
@@ -103,7 +103,7 @@ Statement ASTCopier::operator()(ForLoop const& _forLoop)
 	ScopeGuard g([&]() { this->leaveScope(_forLoop.pre); });
 
 	return ForLoop{
-		_forLoop.debugData,
+		translateDebugData(_forLoop.debugData),
 		translate(_forLoop.pre),
 		translate(_forLoop.condition),
 		translate(_forLoop.post),
@@ -112,17 +112,17 @@ Statement ASTCopier::operator()(ForLoop const& _forLoop)
 }
 Statement ASTCopier::operator()(Break const& _break)
 {
-	return Break{ _break };
+	return Break{translateDebugData(_break.debugData)};
 }
 
 Statement ASTCopier::operator()(Continue const& _continue)
 {
-	return Continue{ _continue };
+	return Continue{translateDebugData(_continue.debugData)};
 }
 
 Statement ASTCopier::operator()(Leave const& _leaveStatement)
 {
-	return Leave{_leaveStatement};
+	return Leave{translateDebugData(_leaveStatement.debugData)};
 }
 
 Statement ASTCopier::operator ()(Block const& _block)
@@ -145,27 +145,27 @@ Block ASTCopier::translate(Block const& _block)
 	enterScope(_block);
 	ScopeGuard g([&]() { this->leaveScope(_block); });
 
-	return Block{_block.debugData, translateVector(_block.statements)};
+	return Block{translateDebugData(_block.debugData), translateVector(_block.statements)};
 }
 
 Case ASTCopier::translate(Case const& _case)
 {
-	return Case{_case.debugData, translate(_case.value), translate(_case.body)};
+	return Case{translateDebugData(_case.debugData), translate(_case.value), translate(_case.body)};
 }
 
 Identifier ASTCopier::translate(Identifier const& _identifier)
 {
-	return Identifier{_identifier.debugData, translateIdentifier(_identifier.name)};
+	return Identifier{translateDebugData(_identifier.debugData), translateIdentifier(_identifier.name)};
 }
 
 Literal ASTCopier::translate(Literal const& _literal)
 {
-	return _literal;
+	return Literal{translateDebugData(_literal.debugData), _literal.kind, _literal.value, _literal.type};
 }
 
 TypedName ASTCopier::translate(TypedName const& _typedName)
 {
-	return TypedName{_typedName.debugData, translateIdentifier(_typedName.name), _typedName.type};
+	return TypedName{translateDebugData(_typedName.debugData), translateIdentifier(_typedName.name), _typedName.type};
 }
 
 YulString FunctionCopier::translateIdentifier(YulString _name)
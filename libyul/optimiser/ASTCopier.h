@@ -107,6 +107,10 @@ protected:
 	virtual void enterFunction(FunctionDefinition const&) { }
 	virtual void leaveFunction(FunctionDefinition const&) { }
 	virtual YulString translateIdentifier(YulString _name) { return _name; }
+	virtual std::shared_ptr<DebugData const> translateDebugData(std::shared_ptr<DebugData const> const& _debugData)
+	{
+		return _debugData;
+	}
 };
 
 template <typename T>
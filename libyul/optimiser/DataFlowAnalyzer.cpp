@@ -32,7 +32,6 @@
 #include <libyul/Utilities.h>
 
 #include <libhyputil/CommonData.h>
-#include <libhyputil/cxx20.h>
 
 #include <variant>
 
@@ -72,23 +71,23 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
+			m_state.environment.storage.eraseIf([&](YulString _key, YulString _value) {
 				return
-					!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-					vars->second != value;
-			}));
-			m_state.environment.storage[vars->first] = vars->second;
+					!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+					vars->second != _value;
+			});
+			m_state.environment.storage.set(vars->first, vars->second);
 			return;
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
-				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-			}));
+			m_state.environment.memory.eraseIf([&](YulString _key, YulString /* _value */) {
+				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+			});
 			// TODO erase keccak knowledge, but in a more clever way
-			m_state.environment.keccak = {};
-			m_state.environment.memory[vars->first] = vars->second;
+			m_state.environment.keccak.clear();
+			m_state.environment.memory.set(vars->first, vars->second);
 			return;
 		}
 	}
@@ -126,10 +125,10 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	Environment preEnvironment = m_state.environment;
+	EnvironmentCheckpoint checkpoint = createCheckpoint();
 
 	ASTModifier::operator()(_if);
-	joinKnowledge(preEnvironment);
+	joinKnowledge(checkpoint);
 
 	clearValues(assignedVariableNames(_if.body));
 }
@@ -141,9 +140,9 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	std::set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		Environment preEnvironment = m_state.environment;
+		EnvironmentCheckpoint checkpoint = createCheckpoint();
 		(*this)(_case.body);
-		joinKnowledge(preEnvironment);
+		joinKnowledge(checkpoint);
 
 		std::set<YulString> variables = assignedVariableNames(_case.body);
 		assignedVariables += variables;
@@ -224,7 +223,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 std::optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.storage, _key))
+	if (YulString const* value = m_state.environment.storage.valueOrNullptr(_key))
 		return *value;
 	else
 		return std::nullopt;
@@ -232,7 +231,7 @@ std::optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 
 std::optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.memory, _key))
+	if (YulString const* value = m_state.environment.memory.valueOrNullptr(_key))
 		return *value;
 	else
 		return std::nullopt;
@@ -240,7 +239,7 @@ std::optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 
 std::optional<YulString> DataFlowAnalyzer::keccakValue(YulString _start, YulString _length) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.keccak, std::make_pair(_start, _length)))
+	if (YulString const* value = m_state.environment.keccak.valueOrNullptr(std::make_pair(_start, _length)))
 		return *value;
 	else
 		return std::nullopt;
@@ -270,20 +269,20 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulString> const& _variables, E
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_state.references[name] = referencedVariables;
+		setReferences(name, referencedVariables);
 		if (!_isDeclaration)
 		{
 			// assignment to slot denoted by "name"
 			m_state.environment.storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_state.environment.storage.eraseIf([&name](YulString /* _key */, YulString _value) { return _value == name; });
 			// assignment to slot denoted by "name"
 			m_state.environment.memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.keccak, [&name](auto&& _item) {
-				return _item.first.first == name || _item.first.second == name || _item.second == name;
+			m_state.environment.keccak.eraseIf([&name](std::pair<YulString, YulString> const& _key, YulString _value) {
+				return _key.first == name || _key.second == name || _value == name;
 			});
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_state.environment.memory.eraseIf([&name](YulString /* _key */, YulString _value) { return _value == name; });
 		}
 	}
 
@@ -296,11 +295,11 @@ void DataFlowAnalyzer::handleAssignment(std::set<YulString> const& _variables, E
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.environment.memory[*key] = variable;
+				m_state.environment.memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.environment.storage[*key] = variable;
+				m_state.environment.storage.set(*key, variable);
 			else if (auto arguments = isKeccak(*_value))
-				m_state.environment.keccak[*arguments] = variable;
+				m_state.environment.keccak.set(*arguments, variable);
 		}
 	}
 }
@@ -315,7 +314,7 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_state.value.erase(name);
-		m_state.references.erase(name);
+		clearReferences(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -338,30 +337,29 @@ void DataFlowAnalyzer::clearValues(std::set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_state.environment.storage, eraseCondition);
-	cxx20::erase_if(m_state.environment.memory, eraseCondition);
-	cxx20::erase_if(m_state.environment.keccak, [&_variables](auto&& _item) {
+	auto eraseCondition = [&_variables](YulString _key, YulString _value) {
+		return _variables.count(_key) || _variables.count(_value);
+	};
+	m_state.environment.storage.eraseIf(eraseCondition);
+	m_state.environment.memory.eraseIf(eraseCondition);
+	m_state.environment.keccak.eraseIf([&_variables](std::pair<YulString, YulString> const& _key, YulString _value) {
 		return
-			_variables.count(_item.first.first) ||
-			_variables.count(_item.first.second) ||
-			_variables.count(_item.second);
+			_variables.count(_key.first) ||
+			_variables.count(_key.second) ||
+			_variables.count(_value);
 	});
 
 	// Also clear variables that reference variables to be cleared.
 	std::set<YulString> referencingVariables;
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_state.references)
-			if (names.count(variableToClear))
-				referencingVariables.emplace(ref);
+		if (auto const* referencing = valueOrNullptr(m_state.referencedBy, variableToClear))
+			referencingVariables += *referencing;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables + referencingVariables)
 	{
 		m_state.value.erase(name);
-		m_state.references.erase(name);
+		clearReferences(name);
 	}
 }
 
@@ -453,29 +451,46 @@ std::optional<std::pair<YulString, YulString>> DataFlowAnalyzer::isKeccak(Expres
 	return std::nullopt;
 }
 
-void DataFlowAnalyzer::joinKnowledge(Environment const& _olderEnvironment)
+DataFlowAnalyzer::EnvironmentCheckpoint DataFlowAnalyzer::createCheckpoint()
 {
-	if (!m_analyzeStores)
-		return;
-	joinKnowledgeHelper(m_state.environment.storage, _olderEnvironment.storage);
-	joinKnowledgeHelper(m_state.environment.memory, _olderEnvironment.memory);
-	cxx20::erase_if(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
-		YulString const* oldValue = valueOrNullptr(_olderEnvironment.keccak, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	return {
+		m_state.environment.storage.checkpoint(),
+		m_state.environment.memory.checkpoint(),
+		m_state.environment.keccak.checkpoint()
+	};
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge(EnvironmentCheckpoint const& _checkpoint)
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
+	// We clear if the key did not exist at the checkpoint or if the value is different.
+	// This also works for memory because the knowledge at the checkpoint is an "older version"
 	// of m_state.environment.memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_state.environment.memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	// The maps are also joined if memory and storage analysis is disabled, to end the recording.
+	m_state.environment.storage.joinWithCheckpoint(_checkpoint.storage);
+	m_state.environment.memory.joinWithCheckpoint(_checkpoint.memory);
+	m_state.environment.keccak.joinWithCheckpoint(_checkpoint.keccak);
+}
+
+void DataFlowAnalyzer::setReferences(YulString _variable, std::set<YulString> _references)
+{
+	clearReferences(_variable);
+	for (YulString reference: _references)
+		m_state.referencedBy[reference].insert(_variable);
+	m_state.references[_variable] = std::move(_references);
+}
+
+void DataFlowAnalyzer::clearReferences(YulString _variable)
+{
+	auto it = m_state.references.find(_variable);
+	if (it == m_state.references.end())
+		return;
+	for (YulString reference: it->second)
+	{
+		auto referencing = m_state.referencedBy.find(reference);
+		referencing->second.erase(_variable);
+		if (referencing->second.empty())
+			m_state.referencedBy.erase(referencing);
+	}
+	m_state.references.erase(it);
 }
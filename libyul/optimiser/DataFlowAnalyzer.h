@@ -31,6 +31,7 @@
 
 #include <libhyputil/Numeric.h>
 #include <libhyputil/Common.h>
+#include <libhyputil/JournaledMap.h>
 
 #include <map>
 #include <set>
@@ -70,7 +71,8 @@ struct AssignedValue
  * If the keys or values are different or non-existent in one branch, the key is deleted.
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
- * at the point of assignment.
+ * at the point of assignment. Instead of copying the knowledge at the start of a branch,
+ * the changes made inside it are recorded, so that joining only has to look at those.
  *
  * The DataFlowAnalyzer currently does not deal with the ``leave`` statement. This is because
  * it only matters at the end of a function body, which is a point in the code a derived class
@@ -170,10 +172,17 @@ protected:
 private:
 	struct Environment
 	{
-		std::unordered_map<YulString, YulString> storage;
-		std::unordered_map<YulString, YulString> memory;
+		util::JournaledMap<std::unordered_map<YulString, YulString>> storage;
+		util::JournaledMap<std::unordered_map<YulString, YulString>> memory;
 		/// If keccak[s, l] = y then y := keccak256(s, l) occurs in the code.
-		std::map<std::pair<YulString, YulString>, YulString> keccak;
+		util::JournaledMap<std::map<std::pair<YulString, YulString>, YulString>> keccak;
+	};
+	/// Point in the control-flow the knowledge about storage and memory can be joined with.
+	struct EnvironmentCheckpoint
+	{
+		size_t storage;
+		size_t memory;
+		size_t keccak;
 	};
 	struct State
 	{
@@ -181,20 +190,25 @@ private:
 		std::map<YulString, AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
 		std::unordered_map<YulString, std::set<YulString>> references;
+		/// referencedBy[b].contains(a) <=> references[a].contains(b)
+		std::unordered_map<YulString, std::set<YulString>> referencedBy;
 
 		Environment environment;
 	};
 
+	/// Starts recording changes to the knowledge about storage and memory, to be joined later.
+	EnvironmentCheckpoint createCheckpoint();
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
-	/// Does nothing if memory and storage analysis is disabled / ignored.
-	void joinKnowledge(Environment const& _olderEnvironment);
-
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	/// i.e. the knowledge at @a _checkpoint cannot have additional changes.
+	/// Checkpoints have to be joined in reverse order of their creation.
+	void joinKnowledge(EnvironmentCheckpoint const& _checkpoint);
+
+	/// Sets the variables referenced by the current value of @a _variable.
+	void setReferences(YulString _variable, std::set<YulString> _references);
+	/// Removes the variables referenced by the value of @a _variable.
+	void clearReferences(YulString _variable);
 
 	State m_state;
 
@@ -51,7 +51,7 @@ YulString NameDispenser::newName(YulString _nameHint)
 	while (illegalName(name))
 	{
 		m_counter++;
-		name = YulString(_nameHint.str() + "_" + std::to_string(m_counter));
+		name = YulString(std::string(_nameHint.str()) + "_" + std::to_string(m_counter));
 	}
 	m_usedNames.emplace(name);
 	return name;
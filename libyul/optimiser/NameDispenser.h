@@ -53,6 +53,10 @@ public:
 
 	std::set<YulString> const& usedNames() { return m_usedNames; }
 
+	/// @returns the last numeric suffix tried for a new name. Only changes when new names are
+	/// dispensed or on reset.
+	size_t counter() const { return m_counter; }
+
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulString _name);
 
@@ -77,7 +77,7 @@ void NameSimplifier::findSimplification(YulString const& _name)
 	if (m_translations.count(_name))
 		return;
 
-	std::string name = _name.str();
+	std::string name(_name.str());
 
 	static auto replacements = std::vector<std::pair<std::regex, std::string>>{
 		{std::regex("_\\$|\\$_"), "_"}, // remove type mangling delimiters
@@ -46,7 +46,7 @@ void yul::removeEmptyBlocks(Block& _block)
 
 bool yul::isRestrictedIdentifier(Dialect const& _dialect, YulString const& _identifier)
 {
-	return _identifier.empty() || TokenTraits::isYulKeyword(_identifier.str()) || _dialect.reservedIdentifier(_identifier);
+	return _identifier.empty() || TokenTraits::isYulKeyword(std::string(_identifier.str())) || _dialect.reservedIdentifier(_identifier);
 }
 
 std::optional<qrvmasm::Instruction> yul::toQRVMInstruction(Dialect const& _dialect, YulString const& _name)
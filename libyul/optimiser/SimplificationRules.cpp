@@ -37,6 +37,54 @@ using namespace hyperion::qrvmasm;
 using namespace hyperion::langutil;
 using namespace hyperion::yul;
 
+namespace
+{
+
+/// Provides access to Yul expressions for the rule decision tree, following the same
+/// rules as Pattern::matches.
+struct ExpressionAdapter
+{
+	Expression const* resolve(Expression const* _expr) const
+	{
+		if (Identifier const* identifier = std::get_if<Identifier>(_expr))
+			if (AssignedValue const* value = ssaValues(identifier->name))
+				if (value->value)
+					return value->value;
+		return _expr;
+	}
+	bool isConstant(Expression const* _expr) const
+	{
+		Literal const* literal = std::get_if<Literal>(_expr);
+		return literal && literal->kind == LiteralKind::Number;
+	}
+	u256 constantValue(Expression const* _expr) const
+	{
+		return u256(std::get<Literal>(*_expr).value.str());
+	}
+	std::optional<qrvmasm::Instruction> pushOperationArguments(
+		Expression const* _expr,
+		std::vector<Expression const*>& _arguments
+	) const
+	{
+		auto instrAndArgs = SimplificationRules::instructionAndArguments(dialect, *_expr);
+		if (!instrAndArgs)
+			return std::nullopt;
+		std::vector<Expression> const& arguments = *instrAndArgs->second;
+		// Direct function calls as arguments prevent any match.
+		for (Expression const& argument: arguments)
+			if (std::holds_alternative<FunctionCall>(argument))
+				return std::nullopt;
+		for (auto it = arguments.rbegin(); it != arguments.rend(); ++it)
+			_arguments.push_back(&*it);
+		return instrAndArgs->first;
+	}
+
+	Dialect const& dialect;
+	std::function<AssignedValue const*(YulString)> const& ssaValues;
+};
+
+}
+
 SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
@@ -47,7 +95,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<QRVMVersion>, std::unique_ptr<SimplificationRules>> qrvmRules;
+	// The rules store their match groups, so each thread needs its own copy.
+	thread_local std::map<std::optional<QRVMVersion>, std::unique_ptr<SimplificationRules>> qrvmRules;
 
 	std::optional<QRVMVersion> version;
 	if (yul::QRVMDialect const* qrvmDialect = dynamic_cast<yul::QRVMDialect const*>(&_dialect))
@@ -59,8 +108,9 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *qrvmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	for (size_t ruleIndex: rules.m_decisionTree.candidates(&_expr, ExpressionAdapter{_dialect, _ssaValues}))
 	{
+		Rule const& rule = rules.m_rules[ruleIndex];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -71,7 +121,7 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(qrvmasm::Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 std::optional<std::pair<qrvmasm::Instruction, std::vector<Expression> const*>>
@@ -94,7 +144,10 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	std::vector<qrvmasm::RuleDecisionTree::PatternNode> patternNodes;
+	_rule.pattern.appendPatternNodes(patternNodes);
+	m_decisionTree.addRule(patternNodes);
+	m_rules.push_back(_rule);
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::QRVMVersion> _qrvmVersion)
@@ -128,8 +181,9 @@ yul::Pattern::Pattern(qrvmasm::Instruction _instruction, std::initializer_list<P
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, qrvmasm::MatchGroups<Expression>& _matchGroups)
 {
+	assertThrow(_group < _matchGroups.size(), OptimizerException, "Match group out of range.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -202,7 +256,7 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if ((*m_matchGroups)[m_matchGroup])
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
 			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
@@ -234,6 +288,31 @@ qrvmasm::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
+void Pattern::appendPatternNodes(std::vector<qrvmasm::RuleDecisionTree::PatternNode>& _nodes) const
+{
+	using Kind = qrvmasm::RuleDecisionTree::PatternNode::Kind;
+	qrvmasm::RuleDecisionTree::PatternNode node;
+	switch (m_kind)
+	{
+	case PatternKind::Operation:
+		node.kind = Kind::Operation;
+		node.instruction = m_instruction;
+		node.argumentCount = m_arguments.size();
+		break;
+	case PatternKind::Constant:
+		node.kind = Kind::Constant;
+		if (m_data)
+			node.value = *m_data;
+		break;
+	case PatternKind::Any:
+		node.kind = Kind::Any;
+		break;
+	}
+	_nodes.push_back(std::move(node));
+	for (Pattern const& argument: m_arguments)
+		argument.appendPatternNodes(_nodes);
+}
+
 Expression Pattern::toExpression(std::shared_ptr<DebugData const> const& _debugData, langutil::QRVMVersion _qrvmVersion) const
 {
 	if (matchGroup())
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <libqrvmasm/RuleDecisionTree.h>
 #include <libqrvmasm/SimplificationRule.h>
 
 #include <libyul/ASTForward.h>
@@ -76,10 +77,12 @@ private:
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<qrvmasm::SimplificationRule<Pattern>> m_rules[256];
+	qrvmasm::MatchGroups<Expression> m_matchGroups{};
+	std::vector<qrvmasm::SimplificationRule<Pattern>> m_rules;
+	/// Decision tree over the patterns of m_rules, used to select the rules to try.
+	qrvmasm::RuleDecisionTree m_decisionTree;
 };
 
 enum class PatternKind
@@ -114,7 +117,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, qrvmasm::MatchGroups<Expression>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -129,6 +132,9 @@ public:
 
 	qrvmasm::Instruction instruction() const;
 
+	/// Appends the nodes of this pattern to @a _nodes in pre-order.
+	void appendPatternNodes(std::vector<qrvmasm::RuleDecisionTree::PatternNode>& _nodes) const;
+
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(std::shared_ptr<DebugData const> const& _debugData, langutil::QRVMVersion _qrvmVersion) const;
@@ -141,7 +147,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	qrvmasm::MatchGroups<Expression>* m_matchGroups = nullptr;
 };
 
 }
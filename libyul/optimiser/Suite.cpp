@@ -72,6 +72,7 @@
 #include <libyul/backends/qrvm/NoOutputAssembly.h>
 
 #include <libhyputil/CommonData.h>
+#include <libhyputil/TimeReport.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -131,6 +132,15 @@ void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
 }
 
 
+struct OptimiserSuite::Snapshot
+{
+	/// Copies of the top-level statements of the AST. After the FunctionGrouper, these are
+	/// the main block and the function definitions.
+	std::vector<Statement> statements;
+	std::set<YulString> usedNames;
+	size_t dispenserCounter;
+};
+
 void OptimiserSuite::run(
 	Dialect const& _dialect,
 	GasMeter const* _meter,
@@ -161,6 +171,8 @@ void OptimiserSuite::run(
 	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
 
 	OptimiserSuite suite(context, Debug::None);
+	if (util::TimeReport::active())
+		suite.m_timeReportPrefix = "yulOptimizer/" + std::string(_object.name.str()) + "/";
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -242,41 +254,40 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance =
+		optimiserStepCollection<
+				BlockFlattener,
+				CircularReferencesPruner,
+				CommonSubexpressionEliminator,
+				ConditionalSimplifier,
+				ConditionalUnsimplifier,
+				ControlFlowSimplifier,
+				DeadCodeEliminator,
+				EqualStoreEliminator,
+				EquivalentFunctionCombiner,
+				ExpressionInliner,
+				ExpressionJoiner,
+				ExpressionSimplifier,
+				ExpressionSplitter,
+				ForLoopConditionIntoBody,
+				ForLoopConditionOutOfBody,
+				ForLoopInitRewriter,
+				FullInliner,
+				FunctionGrouper,
+				FunctionHoister,
+				FunctionSpecializer,
+				LiteralRematerialiser,
+				LoadResolver,
+				LoopInvariantCodeMotion,
+				UnusedAssignEliminator,
+				UnusedStoreEliminator,
+				Rematerialiser,
+				SSAReverser,
+				SSATransform,
+				StructuralSimplifier,
+				UnusedFunctionParameterPruner,
+				UnusedPruner,
+				VarDeclInitializer
 		>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
@@ -404,6 +415,11 @@ bool OptimiserSuite::isEmptyOptimizerSequence(std::string const& _sequence)
 void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
 {
 	validateSequence(_stepAbbreviations);
+	runValidatedSequence(_stepAbbreviations, _ast, _repeatUntilStable);
+}
+
+void OptimiserSuite::runValidatedSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
+{
 
 	// This splits 'aaa[bbb]ccc...' into 'aaa' and '[bbb]ccc...'.
 	auto extractNonNestedPrefix = [](std::string_view _tail) -> std::tuple<std::string_view, std::string_view>
@@ -471,20 +487,29 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 			subsequences.push_back({subsequence, true});
 	}
 
+	// Debug output has to list every step of every round, so rounds are only compared otherwise.
+	std::unique_ptr<Snapshot> snapshot;
+	if (_repeatUntilStable && m_debug == Debug::None)
+		snapshot = takeSnapshot(_ast);
+
 	size_t codeSize = 0;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
-				runSequence(subsequence, _ast, true);
+				runValidatedSequence(subsequence, _ast, true);
 			else
-				runSequence(abbreviationsToSteps(subsequence), _ast);
+				runSteps(abbreviationsToSteps(subsequence), _ast);
 		}
 
 		if (!_repeatUntilStable)
 			break;
 
+		// Another round would not change anything either.
+		if (snapshot && updateSnapshot(*snapshot, _ast))
+			break;
+
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
@@ -493,6 +518,73 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 }
 
 void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+{
+	runSteps(_steps, _ast);
+}
+
+std::unique_ptr<OptimiserSuite::Snapshot> OptimiserSuite::takeSnapshot(Block const& _ast) const
+{
+	return std::make_unique<Snapshot>(Snapshot{
+		ASTCopier{}.translate(_ast).statements,
+		m_context.dispenser.usedNames(),
+		m_context.dispenser.counter()
+	});
+}
+
+bool OptimiserSuite::updateSnapshot(Snapshot& _snapshot, Block const& _ast) const
+{
+	bool unchanged = true;
+	if (
+		_snapshot.dispenserCounter != m_context.dispenser.counter() ||
+		_snapshot.usedNames != m_context.dispenser.usedNames()
+	)
+	{
+		unchanged = false;
+		_snapshot.usedNames = m_context.dispenser.usedNames();
+		_snapshot.dispenserCounter = m_context.dispenser.counter();
+	}
+
+	// Functions are looked up by name, so that only the functions that were changed, added or
+	// moved are copied again.
+	std::map<YulString, Statement*> functions;
+	for (Statement& statement: _snapshot.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+			functions[function->name] = &statement;
+
+	std::vector<Statement> statements;
+	statements.reserve(_ast.statements.size());
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		Statement const& statement = _ast.statements[i];
+		Statement* previous = nullptr;
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+		{
+			if (auto it = functions.find(function->name); it != functions.end())
+				previous = it->second;
+		}
+		else if (i < _snapshot.statements.size())
+			previous = &_snapshot.statements[i];
+
+		if (previous && ExactlyEqual{}(statement, *previous))
+		{
+			if (i >= _snapshot.statements.size() || previous != &_snapshot.statements[i])
+				unchanged = false;
+			statements.emplace_back(std::move(*previous));
+		}
+		else
+		{
+			unchanged = false;
+			statements.emplace_back(ASTCopier{}.translate(statement));
+		}
+	}
+	if (statements.size() != _snapshot.statements.size())
+		unchanged = false;
+	_snapshot.statements = std::move(statements);
+
+	return unchanged;
+}
+
+void OptimiserSuite::runSteps(std::vector<std::string> const& _steps, Block& _ast)
 {
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
@@ -504,7 +596,10 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 #ifdef PROFILE_OPTIMIZER_STEPS
 		steady_clock::time_point startTime = steady_clock::now();
 #endif
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			util::TimeReport::ScopedPhase phase(m_timeReportPrefix, step);
+			allSteps().at(step)->run(m_context, _ast);
+		}
 #ifdef PROFILE_OPTIMIZER_STEPS
 		steady_clock::time_point endTime = steady_clock::now();
 		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
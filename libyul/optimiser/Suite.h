@@ -27,6 +27,9 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/QRVMVersion.h>
 
+#include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -89,8 +92,22 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Copy of the AST and of the names used by the name dispenser.
+	struct Snapshot;
+
+	void runValidatedSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable);
+	void runSteps(std::vector<std::string> const& _steps, Block& _ast);
+	/// @returns a copy of the AST and of the state of the name dispenser.
+	std::unique_ptr<Snapshot> takeSnapshot(Block const& _ast) const;
+	/// Compares the AST and the name dispenser to @a _snapshot and updates it. Only the top-level
+	/// statements that changed are copied.
+	/// @returns true if nothing changed since the snapshot was taken or last updated.
+	bool updateSnapshot(Snapshot& _snapshot, Block const& _ast) const;
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	/// Prefix of the names under which the steps are recorded in the time report.
+	std::string m_timeReportPrefix = "yulOptimizer/";
 #ifdef PROFILE_OPTIMIZER_STEPS
 	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
 #endif
@@ -165,6 +165,151 @@ bool SyntacticallyEqual::visitDeclaration(TypedName const& _lhs, TypedName const
 	return true;
 }
 
+bool ExactlyEqual::operator()(Expression const& _lhs, Expression const& _rhs)
+{
+	return std::visit([this](auto&& _lhsExpr, auto&& _rhsExpr) -> bool {
+		return this->expressionEqual(_lhsExpr, _rhsExpr);
+	}, _lhs, _rhs);
+}
+
+bool ExactlyEqual::operator()(Statement const& _lhs, Statement const& _rhs)
+{
+	return std::visit([this](auto&& _lhsStmt, auto&& _rhsStmt) -> bool {
+		return this->statementEqual(_lhsStmt, _rhsStmt);
+	}, _lhs, _rhs);
+}
+
+bool ExactlyEqual::expressionEqual(FunctionCall const& _lhs, FunctionCall const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		expressionEqual(_lhs.functionName, _rhs.functionName) &&
+		util::containerEqual(_lhs.arguments, _rhs.arguments, [this](Expression const& _lhsExpr, Expression const& _rhsExpr) -> bool {
+			return (*this)(_lhsExpr, _rhsExpr);
+		});
+}
+
+bool ExactlyEqual::expressionEqual(Identifier const& _lhs, Identifier const& _rhs)
+{
+	return _lhs.debugData == _rhs.debugData && _lhs.name == _rhs.name;
+}
+
+bool ExactlyEqual::expressionEqual(Literal const& _lhs, Literal const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		_lhs.kind == _rhs.kind &&
+		_lhs.value == _rhs.value &&
+		_lhs.type == _rhs.type;
+}
+
+bool ExactlyEqual::statementEqual(ExpressionStatement const& _lhs, ExpressionStatement const& _rhs)
+{
+	return _lhs.debugData == _rhs.debugData && (*this)(_lhs.expression, _rhs.expression);
+}
+
+bool ExactlyEqual::statementEqual(Assignment const& _lhs, Assignment const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		util::containerEqual(
+			_lhs.variableNames,
+			_rhs.variableNames,
+			[this](Identifier const& _lhsVarName, Identifier const& _rhsVarName) -> bool {
+				return this->expressionEqual(_lhsVarName, _rhsVarName);
+			}
+		) &&
+		compareUniquePtr<Expression, &ExactlyEqual::operator()>(_lhs.value, _rhs.value);
+}
+
+bool ExactlyEqual::statementEqual(VariableDeclaration const& _lhs, VariableDeclaration const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		typedNamesEqual(_lhs.variables, _rhs.variables) &&
+		compareUniquePtr<Expression, &ExactlyEqual::operator()>(_lhs.value, _rhs.value);
+}
+
+bool ExactlyEqual::statementEqual(FunctionDefinition const& _lhs, FunctionDefinition const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		_lhs.name == _rhs.name &&
+		typedNamesEqual(_lhs.parameters, _rhs.parameters) &&
+		typedNamesEqual(_lhs.returnVariables, _rhs.returnVariables) &&
+		statementEqual(_lhs.body, _rhs.body);
+}
+
+bool ExactlyEqual::statementEqual(If const& _lhs, If const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		compareUniquePtr<Expression, &ExactlyEqual::operator()>(_lhs.condition, _rhs.condition) &&
+		statementEqual(_lhs.body, _rhs.body);
+}
+
+bool ExactlyEqual::statementEqual(Switch const& _lhs, Switch const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		compareUniquePtr<Expression, &ExactlyEqual::operator()>(_lhs.expression, _rhs.expression) &&
+		util::containerEqual(_lhs.cases, _rhs.cases, [this](Case const& _lhsCase, Case const& _rhsCase) -> bool {
+			return this->switchCaseEqual(_lhsCase, _rhsCase);
+		});
+}
+
+bool ExactlyEqual::switchCaseEqual(Case const& _lhs, Case const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		compareUniquePtr<Literal, &ExactlyEqual::expressionEqual>(_lhs.value, _rhs.value) &&
+		statementEqual(_lhs.body, _rhs.body);
+}
+
+bool ExactlyEqual::statementEqual(ForLoop const& _lhs, ForLoop const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		statementEqual(_lhs.pre, _rhs.pre) &&
+		compareUniquePtr<Expression, &ExactlyEqual::operator()>(_lhs.condition, _rhs.condition) &&
+		statementEqual(_lhs.body, _rhs.body) &&
+		statementEqual(_lhs.post, _rhs.post);
+}
+
+bool ExactlyEqual::statementEqual(Break const& _lhs, Break const& _rhs)
+{
+	return _lhs.debugData == _rhs.debugData;
+}
+
+bool ExactlyEqual::statementEqual(Continue const& _lhs, Continue const& _rhs)
+{
+	return _lhs.debugData == _rhs.debugData;
+}
+
+bool ExactlyEqual::statementEqual(Leave const& _lhs, Leave const& _rhs)
+{
+	return _lhs.debugData == _rhs.debugData;
+}
+
+bool ExactlyEqual::statementEqual(Block const& _lhs, Block const& _rhs)
+{
+	return
+		_lhs.debugData == _rhs.debugData &&
+		util::containerEqual(_lhs.statements, _rhs.statements, [this](Statement const& _lhsStmt, Statement const& _rhsStmt) -> bool {
+			return (*this)(_lhsStmt, _rhsStmt);
+		});
+}
+
+bool ExactlyEqual::typedNamesEqual(std::vector<TypedName> const& _lhs, std::vector<TypedName> const& _rhs)
+{
+	return util::containerEqual(_lhs, _rhs, [](TypedName const& _lhsName, TypedName const& _rhsName) -> bool {
+		return
+			_lhsName.debugData == _rhsName.debugData &&
+			_lhsName.name == _rhsName.name &&
+			_lhsName.type == _rhsName.type;
+	});
+}
+
 bool SyntacticallyEqualExpression::operator()(Expression const& _lhs, Expression const& _rhs) const
 {
 	return SyntacticallyEqual{}(_lhs, _rhs);
@@ -25,7 +25,9 @@
 #include <libyul/YulString.h>
 
 #include <map>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace hyperion::yul
 {
@@ -85,6 +87,55 @@ private:
 	std::map<YulString, std::size_t> m_identifiersRHS;
 };
 
+/**
+ * Component that checks whether two ASTs are identical, including names, the spelling of
+ * literals and debug data. Debug data is compared by identity, i.e. two nodes that
+ * carry equal but separately allocated debug data are considered different.
+ */
+class ExactlyEqual
+{
+public:
+	bool operator()(Expression const& _lhs, Expression const& _rhs);
+	bool operator()(Statement const& _lhs, Statement const& _rhs);
+
+	bool expressionEqual(FunctionCall const& _lhs, FunctionCall const& _rhs);
+	bool expressionEqual(Identifier const& _lhs, Identifier const& _rhs);
+	bool expressionEqual(Literal const& _lhs, Literal const& _rhs);
+
+	bool statementEqual(ExpressionStatement const& _lhs, ExpressionStatement const& _rhs);
+	bool statementEqual(Assignment const& _lhs, Assignment const& _rhs);
+	bool statementEqual(VariableDeclaration const& _lhs, VariableDeclaration const& _rhs);
+	bool statementEqual(FunctionDefinition const& _lhs, FunctionDefinition const& _rhs);
+	bool statementEqual(If const& _lhs, If const& _rhs);
+	bool statementEqual(Switch const& _lhs, Switch const& _rhs);
+	bool switchCaseEqual(Case const& _lhs, Case const& _rhs);
+	bool statementEqual(ForLoop const& _lhs, ForLoop const& _rhs);
+	bool statementEqual(Break const& _lhs, Break const& _rhs);
+	bool statementEqual(Continue const& _lhs, Continue const& _rhs);
+	bool statementEqual(Leave const& _lhs, Leave const& _rhs);
+	bool statementEqual(Block const& _lhs, Block const& _rhs);
+private:
+	bool typedNamesEqual(std::vector<TypedName> const& _lhs, std::vector<TypedName> const& _rhs);
+
+	template<typename U, typename V>
+	bool expressionEqual(U const&, V const&, std::enable_if_t<!std::is_same<U, V>::value>* = nullptr)
+	{
+		return false;
+	}
+
+	template<typename U, typename V>
+	bool statementEqual(U const&, V const&, std::enable_if_t<!std::is_same<U, V>::value>* = nullptr)
+	{
+		return false;
+	}
+
+	template<typename T, bool (ExactlyEqual::*CompareMember)(T const&, T const&)>
+	bool compareUniquePtr(std::unique_ptr<T> const& _lhs, std::unique_ptr<T> const& _rhs)
+	{
+		return (_lhs == _rhs) || (_lhs && _rhs && (this->*CompareMember)(*_lhs, *_rhs));
+	}
+};
+
 /**
  * Does the same as SyntacticallyEqual just that the operator() function is const.
  */
@@ -102,7 +102,7 @@ YulString VarNameCleaner::findCleanName(YulString const& _name) const
 	// create new name with suffix (by finding a free identifier)
 	for (size_t i = 1; i < std::numeric_limits<decltype(i)>::max(); ++i)
 	{
-		YulString newNameSuffixed = YulString{newName.str() + "_" + std::to_string(i)};
+		YulString newNameSuffixed = YulString{std::string(newName.str()) + "_" + std::to_string(i)};
 		if (!isUsedName(newNameSuffixed))
 			return newNameSuffixed;
 	}
@@ -118,8 +118,9 @@ YulString VarNameCleaner::stripSuffix(YulString const& _name) const
 {
 	static std::regex const suffixRegex("(_+[0-9]+)+$");
 
+	std::string const name(_name.str());
 	std::smatch suffixMatch;
-	if (regex_search(_name.str(), suffixMatch, suffixRegex))
+	if (regex_search(name, suffixMatch, suffixRegex))
 		return {YulString{suffixMatch.prefix().str()}};
 	return _name;
 }
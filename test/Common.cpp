@@ -108,6 +108,7 @@ void CommonOptions::addOptions()
 		("vm", po::value<std::vector<fs::path>>(&vmPaths), "path to qrvmc library, can be supplied multiple times.")
 		("batches", po::value<size_t>(&this->batches)->default_value(1), "set number of batches to split the tests into")
 		("selected-batch", po::value<size_t>(&this->selectedBatch)->default_value(0), "zero-based number of batch to execute")
+		("jobs,j", po::value<size_t>(&this->jobs)->default_value(1), "number of threads to run the test cases of the interactive test suites (syntax, semantic, Yul optimizer, ...) on")
 		("no-semantic-tests", po::bool_switch(&disableSemanticTests)->default_value(disableSemanticTests), "disable semantic tests")
 		("no-smt", po::bool_switch(&disableSMT)->default_value(disableSMT), "disable SMT checker")
 		("optimize", po::bool_switch(&optimize)->default_value(optimize), "enables optimization")
@@ -140,6 +141,11 @@ void CommonOptions::validate() const
 		ConfigException,
 		"Selected batch has to be less than number of batches."
 	);
+	assertThrow(
+		jobs > 0,
+		ConfigException,
+		"Jobs needs to be at least 1."
+	);
 
 	if (enforceGasTest)
 	{
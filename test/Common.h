@@ -62,6 +62,7 @@ struct CommonOptions
 	bool showMetadata = false;
 	size_t batches = 1;
 	size_t selectedBatch = 0;
+	size_t jobs = 1;
 
 	langutil::QRVMVersion qrvmVersion() const;
 
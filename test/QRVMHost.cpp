@@ -40,7 +40,7 @@ using namespace qrvmc::literals;
 qrvmc::VM& QRVMHost::getVM(string const& _path)
 {
 	static qrvmc::VM NullVM{nullptr};
-	static map<string, unique_ptr<qrvmc::VM>> vms;
+	static thread_local map<string, unique_ptr<qrvmc::VM>> vms;
 	if (vms.count(_path) == 0)
 	{
 		qrvmc_loader_error_code errorCode = {};
@@ -365,7 +365,7 @@ qrvmc::Result QRVMHost::precompileDepositRoot(qrvmc_message const& /*_message*/)
 qrvmc::Result QRVMHost::precompileSha256(qrvmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
-	bytes static hash;
+	bytes static thread_local hash;
 	hash = picosha2::hash256(bytes(
 		_message.input_data,
 		_message.input_data + _message.input_size
@@ -380,7 +380,7 @@ qrvmc::Result QRVMHost::precompileSha256(qrvmc_message const& _message) noexcept
 qrvmc::Result QRVMHost::precompileIdentity(qrvmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
-	bytes static data;
+	bytes static thread_local data;
 	data = bytes(_message.input_data, _message.input_data + _message.input_size);
 
 	// Base 15 gas + 3 gas / word.
@@ -65,6 +65,7 @@ public:
 	// Hyperion testing specific features.
 
 	/// Tries to dynamically load a qrvmc vm supporting qrvm1 and caches the loaded VM.
+	/// Every thread gets its own VM instance, so that tests can be run concurrently.
 	/// @returns vmc::VM(nullptr) on failure.
 	static qrvmc::VM& getVM(std::string const& _path = {});
 
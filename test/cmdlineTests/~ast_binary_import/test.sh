@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+# An AST written by --ast-binary has to be imported exactly like the same AST in JSON.
+HYPTMPDIR=$(mktemp -d -t "cmdline-test-ast-binary-import-XXXXXX")
+cd "$HYPTMPDIR"
+
+cat > input.hyp <<'HYP'
+// SPDX-License-Identifier: GPL-3.0
+pragma hyperion >=0.0;
+
+/// @title A
+contract A {
+    event E(string s);
+    function f(uint x) public pure returns (uint) { return x * 2; }
+    function g() public { emit E("e"); }
+}
+HYP
+
+msg_on_error --no-stderr "$HYPC" --stop-after parsing --combined-json ast input.hyp > ast.json
+msg_on_error --no-stderr "$HYPC" --stop-after parsing --ast-binary -o . input.hyp
+[[ -f input.hyp_binary.ast ]] || fail "--ast-binary did not write input.hyp_binary.ast."
+
+msg_on_error --no-stderr "$HYPC" --import-ast --combined-json ast,bin ast.json > json_import.json
+msg_on_error --no-stderr "$HYPC" --import-ast --combined-json ast,bin input.hyp_binary.ast > binary_import.json
+diff_values "$(cat json_import.json)" "$(cat binary_import.json)"
+
+# A truncated file has to be rejected instead of being read as a partial AST.
+head -c 20 input.hyp_binary.ast > truncated.ast
+"$HYPC" --import-ast truncated.ast &> /dev/null && fail "hypc --import-ast accepted a truncated binary AST."
+
+cd - > /dev/null
+rm -r "$HYPTMPDIR"
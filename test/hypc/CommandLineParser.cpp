@@ -121,6 +121,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--qrvm-version=shanghai",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--cache-dir=/tmp/cache",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -130,7 +132,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--libraries="
 				"dir1/file1.hyp:L=Q1234567890123456789012345678901234567890,"
 				"dir2/file2.hyp:L=Q1111122222333334444455555666667777788888",
-			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
+			"--ast-compact-json", "--ast-binary", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
 			"--gas",
 			"--combined-json="
@@ -180,6 +182,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.qrvmVersion= QRVMVersion::shanghai();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.jobs = 4;
+		expectedOptions.output.cacheDir = "/tmp/cache";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -193,7 +197,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true,
+			true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -267,6 +271,83 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"hypc", viaIrOption, "contract.hyp"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(jobs_option)
+{
+	BOOST_TEST(parseCommandLine({"hypc", "contract.hyp"}).output.jobs == 1);
+	BOOST_TEST(parseCommandLine({"hypc", "--jobs=8", "contract.hyp"}).output.jobs == 8);
+	BOOST_TEST(parseCommandLine({"hypc", "-j", "2", "contract.hyp"}).output.jobs == 2);
+	BOOST_TEST(parseCommandLine({"hypc", "--strict-assembly", "--jobs=4", "input.yul"}).output.jobs == 4);
+
+	string expectedMessage = "--jobs must be at least 1.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"hypc", "--jobs=0", "contract.hyp"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(cache_dir_option)
+{
+	BOOST_TEST(parseCommandLine({"hypc", "contract.hyp"}).output.cacheDir.empty());
+	BOOST_TEST(parseCommandLine({"hypc", "--cache-dir=/tmp/cache", "contract.hyp"}).output.cacheDir == "/tmp/cache");
+	BOOST_TEST(parseCommandLine({"hypc", "--standard-json", "--cache-dir", "cache"}).output.cacheDir == "cache");
+
+	string expectedMessage = "--cache-dir must not be empty.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"hypc", "--cache-dir", "", "contract.hyp"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(cache_size_limit_and_statistics_options)
+{
+	CommandLineOptions defaultOptions = parseCommandLine({"hypc", "--cache-dir=cache", "contract.hyp"});
+	BOOST_TEST(!defaultOptions.output.cacheSizeLimit.has_value());
+	BOOST_TEST(!defaultOptions.output.cacheStatistics);
+
+	CommandLineOptions options = parseCommandLine({
+		"hypc",
+		"--standard-json",
+		"--cache-dir=cache",
+		"--cache-size-limit=16",
+		"--cache-statistics",
+	});
+	BOOST_REQUIRE(options.output.cacheSizeLimit.has_value());
+	BOOST_TEST(*options.output.cacheSizeLimit == 16u * 1024 * 1024);
+	BOOST_TEST(options.output.cacheStatistics);
+
+	for (string const& option: vector<string>{"--cache-size-limit=16", "--cache-statistics"})
+	{
+		string expectedMessage = option.substr(0, option.find('=')) + " requires --cache-dir.";
+		auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+		BOOST_CHECK_EXCEPTION(parseCommandLine({"hypc", option, "contract.hyp"}), CommandLineValidationError, hasCorrectMessage);
+	}
+
+	string expectedMessage = "--cache-size-limit must be at least 1.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"hypc", "--cache-dir=cache", "--cache-size-limit=0", "contract.hyp"}),
+		CommandLineValidationError,
+		hasCorrectMessage
+	);
+}
+
+BOOST_AUTO_TEST_CASE(time_report_option)
+{
+	BOOST_TEST(!parseCommandLine({"hypc", "contract.hyp"}).output.timeReport);
+	BOOST_TEST(parseCommandLine({"hypc", "--time-report", "contract.hyp"}).output.timeReport);
+	BOOST_CHECK_THROW(parseCommandLine({"hypc", "--standard-json", "--time-report"}), CommandLineValidationError);
+}
+
+BOOST_AUTO_TEST_CASE(server_mode_options)
+{
+	CommandLineOptions options = parseCommandLine({"hypc", "--server", "/tmp/hypc.sock", "--cache-dir=/tmp/cache"});
+	BOOST_CHECK(options.input.mode == InputMode::Server);
+	BOOST_TEST(options.input.serverSocket == "/tmp/hypc.sock");
+	BOOST_TEST(options.output.cacheDir == "/tmp/cache");
+
+	string expectedMessage = "--server must not be empty.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"hypc", "--server", ""}), CommandLineValidationError, hasCorrectMessage);
+	BOOST_CHECK_THROW(parseCommandLine({"hypc", "--server=/tmp/hypc.sock", "--lsp"}), CommandLineValidationError);
+	BOOST_CHECK_THROW(parseCommandLine({"hypc", "--server=/tmp/hypc.sock", "--via-ir"}), CommandLineValidationError);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static vector<tuple<vector<string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -424,6 +505,8 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=2", {"--standard-json", "--link"}},
+		{"--cache-dir=cache", {"--assemble", "--yul", "--strict-assembly", "--link"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
@@ -41,10 +41,17 @@
 #include <test/Common.h>
 #include <test/QRVMHost.h>
 
+#include <libhyputil/ThreadPool.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 
 using namespace boost::unit_test;
 using namespace hyperion::frontend::test;
@@ -96,7 +103,9 @@ private:
 };
 
 
-void runTestCase(TestCase::Config const& _config, TestCase::TestCaseCreator const& _testCaseCreator)
+/// Runs the test case and @returns a description of the failure if it did not succeed.
+/// Does not use Boost.Test, so that it can be called on any thread.
+optional<string> runTestCase(TestCase::Config const& _config, TestCase::TestCaseCreator const& _testCaseCreator)
 {
 	try
 	{
@@ -108,27 +117,124 @@ void runTestCase(TestCase::Config const& _config, TestCase::TestCaseCreator cons
 				case TestCase::TestResult::Success:
 					break;
 				case TestCase::TestResult::Failure:
-					BOOST_ERROR("Test expectation mismatch.\n" + errorStream.str());
-					break;
+					return "Test expectation mismatch.\n" + errorStream.str();
 				case TestCase::TestResult::FatalError:
-					BOOST_ERROR("Fatal error during test.\n" + errorStream.str());
-					break;
+					return "Fatal error during test.\n" + errorStream.str();
 			}
 	}
 	catch (boost::exception const& _e)
 	{
-		BOOST_ERROR("Exception during extracted test: " << boost::diagnostic_information(_e));
+		return "Exception during extracted test: " + boost::diagnostic_information(_e);
 	}
 	catch (std::exception const& _e)
 	{
-		BOOST_ERROR("Exception during extracted test: " << boost::diagnostic_information(_e));
+		return "Exception during extracted test: " + boost::diagnostic_information(_e);
 	}
 	catch (...)
 	{
-		BOOST_ERROR("Unknown exception during extracted test: " << boost::current_exception_diagnostic_information());
+		return "Unknown exception during extracted test: " + boost::current_exception_diagnostic_information();
 	}
+	return nullopt;
 }
 
+void reportFailure(optional<string> const& _failure)
+{
+	if (_failure)
+		BOOST_ERROR(*_failure);
+}
+
+/**
+ * Runs the test cases of the interactive test suites on a pool of threads.
+ *
+ * The Boost test cases registered for them only wait for the outcome and report it, because
+ * Boost.Test itself is not thread-safe. The pool starts when the first of them is executed, i.e.
+ * after the other Boost tests, and then works through all enabled test cases in the order in
+ * which they were registered, so that the outcomes usually are ready when they are reported.
+ */
+class TestCaseScheduler
+{
+public:
+	explicit TestCaseScheduler(size_t _jobs): m_jobs(_jobs) {}
+	~TestCaseScheduler()
+	{
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+	/// @returns the index the next test case added will get.
+	size_t size() const { return m_tests.size(); }
+	void add(test_unit_id _id, TestCase::Config _config, TestCase::TestCaseCreator _testCaseCreator)
+	{
+		m_tests.push_back({_id, std::move(_config), std::move(_testCaseCreator), false, false, nullopt});
+	}
+
+	/// Waits for the test case with the given index to finish and reports its outcome.
+	void report(size_t _index)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_thread.joinable())
+			start();
+		Test& test = m_tests.at(_index);
+		if (!test.scheduled)
+		{
+			lock.unlock();
+			reportFailure(runTestCase(test.config, test.testCaseCreator));
+			return;
+		}
+		m_finished.wait(lock, [&] { return test.done; });
+		reportFailure(test.failure);
+	}
+
+private:
+	struct Test
+	{
+		test_unit_id id;
+		TestCase::Config config;
+		TestCase::TestCaseCreator testCaseCreator;
+		bool scheduled = false;
+		bool done = false;
+		optional<string> failure;
+	};
+
+	/// Starts running the test cases that were not disabled on the command line.
+	/// Requires m_mutex to be locked.
+	void start()
+	{
+		vector<Test*> scheduled;
+		for (Test& test: m_tests)
+			if (framework::get(test.id, TUT_CASE).is_enabled())
+			{
+				test.scheduled = true;
+				scheduled.push_back(&test);
+			}
+
+		m_thread = std::thread([this, scheduled = std::move(scheduled)] {
+			// The thread running parallelFor works on the tests as well.
+			hyperion::util::ThreadPool pool(m_jobs - 1);
+			pool.parallelFor(scheduled.size(), [&](size_t _index) {
+				Test& test = *scheduled[_index];
+				optional<string> failure = runTestCase(test.config, test.testCaseCreator);
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					test.failure = std::move(failure);
+					test.done = true;
+				}
+				m_finished.notify_all();
+			});
+		});
+	}
+
+	size_t const m_jobs;
+	vector<Test> m_tests;
+	std::mutex m_mutex;
+	/// Signalled whenever a test case finished.
+	std::condition_variable m_finished;
+	std::thread m_thread;
+};
+
+/// Scheduler for the test cases of the interactive test suites if they run on several threads.
+unique_ptr<TestCaseScheduler> g_testCaseScheduler;
+
 int registerTests(
 	boost::unit_test::test_suite& _suite,
 	boost::filesystem::path const& _basepath,
@@ -178,17 +284,30 @@ int registerTests(
 			static vector<unique_ptr<string const>> filenames;
 
 			filenames.emplace_back(make_unique<string>(_path.string()));
-			auto test_case = make_test_case(
-				[config, _testCaseCreator]
-				{
-					BOOST_REQUIRE_NO_THROW({
-						runTestCase(config, _testCaseCreator);
-					});
-				},
-				_path.stem().string(),
-				*filenames.back(),
-				0
-			);
+			test_case* test_case;
+			if (g_testCaseScheduler)
+			{
+				size_t index = g_testCaseScheduler->size();
+				test_case = make_test_case(
+					[index] { g_testCaseScheduler->report(index); },
+					_path.stem().string(),
+					*filenames.back(),
+					0
+				);
+				g_testCaseScheduler->add(test_case->p_id, config, _testCaseCreator);
+			}
+			else
+				test_case = make_test_case(
+					[config, _testCaseCreator]
+					{
+						BOOST_REQUIRE_NO_THROW({
+							reportFailure(runTestCase(config, _testCaseCreator));
+						});
+					},
+					_path.stem().string(),
+					*filenames.back(),
+					0
+				);
 			for (auto const& _label: _labels)
 				test_case->add_label(_label);
 			_suite.add(test_case);
@@ -248,6 +367,9 @@ test_suite* init_unit_test_suite(int /*argc*/, char* /*argv*/[])
 		BoostBatcher boostBatcher(batcher);
 		traverse_test_tree(master, boostBatcher, true);
 
+		if (CommonOptions::get().jobs > 1)
+			g_testCaseScheduler = make_unique<TestCaseScheduler>(CommonOptions::get().jobs);
+
 		// Include the interactive tests in the automatic tests as well
 		for (auto const& ts: g_interactiveTestsuites)
 		{
@@ -0,0 +1,166 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the on-disk compilation cache.
+ */
+
+#include <libhyperion/interface/CompilationCache.h>
+#include <libhyperion/interface/CompilerStack.h>
+
+#include <test/Common.h>
+
+#include <libhyputil/Keccak256.h>
+#include <libhyputil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+namespace hyperion::frontend::test
+{
+
+namespace
+{
+
+std::string const c_sourceCode = R"(
+	pragma hyperion >=0.0;
+	contract C {
+		uint immutable x = 7;
+		function f() public view returns (uint) { return x; }
+	}
+	contract D {
+		function g() public returns (address) { return address(new C()); }
+	}
+)";
+
+void compileWithCache(CompilerStack& _compilerStack, std::shared_ptr<CompilationCache> _cache, bool _viaIR)
+{
+	_compilerStack.setSources({{"A.hyp", c_sourceCode}});
+	_compilerStack.setQRVMVersion(hyperion::test::CommonOptions::get().qrvmVersion());
+	_compilerStack.setViaIR(_viaIR);
+	_compilerStack.enableIRGeneration(_viaIR);
+	_compilerStack.setCompilationCache(std::move(_cache));
+	BOOST_REQUIRE_MESSAGE(_compilerStack.compile(), "Compiling contract failed");
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilationCacheTest)
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	util::TemporaryDirectory tempDir("compilation-cache-test");
+	CompilationCache cache(tempDir.path() / "cache");
+	util::h256 const key = util::keccak256("key");
+
+	BOOST_TEST(!cache.load(key).has_value());
+
+	Json::Value entry;
+	entry["bytecode"] = "6001";
+	cache.store(key, entry);
+	std::optional<Json::Value> loadedEntry = cache.load(key);
+	BOOST_REQUIRE(loadedEntry.has_value());
+	BOOST_TEST(*loadedEntry == entry);
+
+	BOOST_TEST(cache.statistics().hits == 1);
+	BOOST_TEST(cache.statistics().misses == 1);
+	BOOST_TEST(cache.statistics().stores == 1);
+}
+
+BOOST_AUTO_TEST_CASE(unreadable_entry_is_a_miss)
+{
+	util::TemporaryDirectory tempDir("compilation-cache-test");
+	CompilationCache cache(tempDir.path());
+	util::h256 const key = util::keccak256("key");
+
+	cache.store(key, Json::Value{Json::objectValue});
+	for (auto const& file: boost::filesystem::directory_iterator(cache.directory()))
+		std::ofstream(file.path().string(), std::ios::trunc) << "{\"truncated";
+
+	BOOST_TEST(!cache.load(key).has_value());
+	BOOST_TEST(cache.statistics().misses == 1);
+}
+
+BOOST_AUTO_TEST_CASE(evicts_entries_above_size_limit)
+{
+	util::TemporaryDirectory tempDir("compilation-cache-test");
+	CompilationCache cache(tempDir.path(), 200);
+
+	Json::Value entry;
+	entry["data"] = std::string(60, 'x');
+	for (size_t i = 0; i < 5; ++i)
+		cache.store(util::keccak256(std::to_string(i)), entry);
+
+	BOOST_TEST(cache.statistics().evictions > 0);
+	BOOST_TEST(cache.load(util::keccak256("4")).has_value());
+	BOOST_TEST(!cache.load(util::keccak256("0")).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(scans_directory_only_occasionally)
+{
+	util::TemporaryDirectory tempDir("compilation-cache-test");
+	CompilationCache cache(tempDir.path());
+
+	size_t const storeCount = 2 * CompilationCache::RescanInterval;
+	for (size_t i = 0; i < storeCount; ++i)
+		cache.store(util::keccak256(std::to_string(i)), Json::Value{Json::objectValue});
+
+	BOOST_TEST(cache.statistics().stores == storeCount);
+	// One scan to determine the initial size and one per interval.
+	BOOST_TEST(cache.statistics().scans <= 1 + storeCount / CompilationCache::RescanInterval);
+	BOOST_TEST(cache.statistics().evictions == 0);
+	for (auto const& file: boost::filesystem::directory_iterator(cache.directory()))
+		BOOST_TEST(file.path().extension() == ".json");
+}
+
+BOOST_AUTO_TEST_CASE(restored_contracts_match_compiled_contracts)
+{
+	for (bool viaIR: {false, true})
+	{
+		util::TemporaryDirectory tempDir("compilation-cache-test");
+		auto cache = std::make_shared<CompilationCache>(tempDir.path());
+
+		CompilerStack compiled;
+		compileWithCache(compiled, cache, viaIR);
+		BOOST_TEST(cache->statistics().misses == 2);
+		BOOST_TEST(cache->statistics().stores == 2);
+
+		CompilerStack restored;
+		compileWithCache(restored, cache, viaIR);
+		BOOST_TEST(cache->statistics().hits == 2);
+
+		for (std::string const contractName: {"C", "D"})
+		{
+			BOOST_TEST(restored.object(contractName).toHex() == compiled.object(contractName).toHex());
+			BOOST_TEST(restored.runtimeObject(contractName).toHex() == compiled.runtimeObject(contractName).toHex());
+			BOOST_TEST(
+				restored.runtimeObject(contractName).immutableReferences ==
+				compiled.runtimeObject(contractName).immutableReferences
+			);
+			BOOST_TEST(*restored.sourceMapping(contractName) == *compiled.sourceMapping(contractName));
+			BOOST_TEST(*restored.runtimeSourceMapping(contractName) == *compiled.runtimeSourceMapping(contractName));
+			BOOST_TEST(restored.yulIROptimized(contractName) == compiled.yulIROptimized(contractName));
+			BOOST_TEST(restored.assemblyItems(contractName) == nullptr);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,195 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the compiler server.
+ */
+
+#include <libhyperion/interface/CompilationServer.h>
+#include <libhyperion/lsp/Transport.h>
+
+#include <libhyputil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace hyperion::lsp;
+
+namespace hyperion::frontend::test
+{
+
+namespace
+{
+
+Json::Value compileRequest(int _id)
+{
+	Json::Value request;
+	request["id"] = _id;
+	request["method"] = "compile";
+	request["params"]["language"] = "Hyperion";
+	request["params"]["sources"]["A.hyp"]["content"] = "pragma hyperion >=0.0; contract C { function f() public {} }";
+	request["params"]["settings"]["outputSelection"]["*"]["*"] = Json::Value{Json::arrayValue};
+	request["params"]["settings"]["outputSelection"]["*"]["*"].append("qrvm.bytecode.object");
+	return request;
+}
+
+Json::Value request(int _id, std::string const& _method)
+{
+	Json::Value request;
+	request["id"] = _id;
+	request["method"] = _method;
+	return request;
+}
+
+/// Sends @a _requests to a fresh connection of @a _server and returns the replies.
+std::vector<Json::Value> exchange(CompilationServer& _server, std::vector<Json::Value> const& _requests)
+{
+	std::stringstream requests;
+	for (Json::Value const& request: _requests)
+	{
+		std::string const body = util::jsonCompactPrint(request);
+		requests << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+	}
+
+	std::stringstream replies;
+	IOStreamTransport transport(requests, replies);
+	_server.serve(transport);
+
+	std::stringstream unused;
+	IOStreamTransport replyReader(replies, unused);
+	std::vector<Json::Value> result;
+	while (result.size() < _requests.size())
+	{
+		std::optional<Json::Value> reply = replyReader.receive();
+		BOOST_REQUIRE(reply.has_value());
+		result.emplace_back(std::move(*reply));
+	}
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilationServerTest)
+
+BOOST_AUTO_TEST_CASE(compile_and_retain_outputs)
+{
+	CompilationServer server;
+	std::vector<Json::Value> replies = exchange(server, {compileRequest(1), compileRequest(2), request(3, "statistics")});
+
+	BOOST_TEST(replies[0]["id"] == 1);
+	Json::Value const& bytecode = replies[0]["result"]["contracts"]["A.hyp"]["C"]["qrvm"]["bytecode"]["object"];
+	BOOST_REQUIRE(bytecode.isString());
+	BOOST_TEST(!bytecode.asString().empty());
+	BOOST_TEST(replies[1]["id"] == 2);
+	BOOST_TEST(replies[1]["result"] == replies[0]["result"]);
+
+	Json::Value const& statistics = replies[2]["result"];
+	BOOST_TEST(statistics["compileRequests"] == 2);
+	BOOST_TEST(statistics["retainedOutputs"]["count"] == 1);
+	BOOST_TEST(statistics["retainedOutputs"]["hits"] == 1);
+	BOOST_TEST(statistics["latency"]["maxMilliseconds"].isDouble());
+	BOOST_TEST(!statistics.isMember("compilationCache"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compilations)
+{
+	size_t constexpr requestCount = 4;
+	std::vector<Json::Value> inputs;
+	for (size_t i = 0; i < requestCount; ++i)
+	{
+		Json::Value input = compileRequest(0)["params"];
+		input["sources"]["A.hyp"]["content"] =
+			"pragma hyperion >=0.0; contract C { function f() public pure returns (uint) { return " +
+			std::to_string(i) +
+			"; } }";
+		inputs.emplace_back(std::move(input));
+	}
+
+	std::vector<Json::Value> expectedOutputs;
+	{
+		CompilationServer sequentialServer;
+		for (Json::Value const& input: inputs)
+			expectedOutputs.emplace_back(sequentialServer.compile(input));
+	}
+
+	CompilationServer server;
+	std::vector<Json::Value> outputs(requestCount);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < requestCount; ++i)
+		threads.emplace_back([&, i]() { outputs[i] = server.compile(inputs[i]); });
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t i = 0; i < requestCount; ++i)
+	{
+		BOOST_TEST(!outputs[i].isMember("errors"));
+		BOOST_TEST(outputs[i] == expectedOutputs[i]);
+	}
+	BOOST_TEST(server.statistics()["compileRequests"] == requestCount);
+}
+
+BOOST_AUTO_TEST_CASE(reset_yul_strings_between_requests)
+{
+	std::vector<Json::Value> requests;
+	for (int i = 1; i <= 3; ++i)
+	{
+		Json::Value request = compileRequest(i);
+		request["params"]["sources"]["A.hyp"]["content"] =
+			"pragma hyperion >=0.0; contract C { function f() public pure returns (uint r) { assembly { r := " +
+			std::to_string(i) +
+			" } } }";
+		requests.emplace_back(std::move(request));
+	}
+	requests.emplace_back(request(4, "statistics"));
+
+	// A limit of zero resets the repository after every request.
+	for (size_t yulStringLimit: {CompilationServer::DefaultYulStringLimit, size_t(0)})
+	{
+		CompilationServer server({}, {}, yulStringLimit);
+		std::vector<Json::Value> replies = exchange(server, std::as_const(requests));
+		for (size_t i = 0; i < 3; ++i)
+			BOOST_TEST(
+				util::jsonCompactPrint(replies[i]["result"]) ==
+				util::jsonCompactPrint(CompilationServer().compile(requests[i]["params"]))
+			);
+		Json::Value const& statistics = replies[3]["result"]["yulStrings"];
+		BOOST_TEST(statistics["resets"].asUInt64() == (yulStringLimit == 0 ? 3u : 0u));
+		BOOST_TEST(statistics["arenaBytes"].isUInt64());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(invalid_requests)
+{
+	CompilationServer server;
+	Json::Value invalidParams = request(2, "compile");
+	invalidParams["params"] = "contract C {}";
+	std::vector<Json::Value> replies = exchange(server, {request(1, "unknown"), invalidParams, request(3, "shutdown")});
+
+	BOOST_TEST(replies[0]["error"]["code"] == static_cast<int>(ErrorCode::MethodNotFound));
+	BOOST_TEST(replies[1]["error"]["code"] == static_cast<int>(ErrorCode::InvalidParams));
+	BOOST_TEST(replies[2]["result"].isNull());
+	BOOST_TEST(server.shutdownRequested());
+	BOOST_TEST(server.statistics()["compileRequests"] == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,122 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the dirty tracking of the language server's file repository.
+ */
+
+#include <libhyperion/lsp/FileRepository.h>
+
+#include <test/FilesystemUtils.h>
+
+#include <libhyputil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+
+using namespace hyperion::frontend;
+
+namespace hyperion::lsp::test
+{
+
+namespace
+{
+
+std::string fileUri(boost::filesystem::path const& _path)
+{
+	return "file://" + _path.generic_string();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(LSPFileRepositoryTest)
+
+BOOST_AUTO_TEST_CASE(open_files)
+{
+	util::TemporaryDirectory tempDir("lsp-file-repository-test");
+	std::string const uriA = fileUri(tempDir.path() / "a.hyp");
+	std::string const uriB = fileUri(tempDir.path() / "b.hyp");
+
+	FileRepository previous(tempDir.path(), {});
+	previous.setSourceByUri(uriA, "contract A {}");
+	previous.setSourceByUri(uriB, "contract B {}");
+
+	FileRepository unchanged(tempDir.path(), {});
+	unchanged.setSourceByUri(uriA, "contract A {}");
+	unchanged.setSourceByUri(uriB, "contract B {}");
+	unchanged.markDirtySince(previous);
+	BOOST_TEST(unchanged.dirtySourceUnits().empty());
+
+	FileRepository modified(tempDir.path(), {});
+	modified.setSourceByUri(uriA, "contract A { uint x; }");
+	modified.setSourceByUri(uriB, "contract B {}");
+	modified.markDirtySince(previous);
+	BOOST_CHECK(modified.dirtySourceUnits() == std::set<std::string>{modified.uriToSourceUnitName(uriA)});
+
+	FileRepository removed(tempDir.path(), {});
+	removed.setSourceByUri(uriA, "contract A {}");
+	removed.markDirtySince(previous);
+	BOOST_CHECK(removed.dirtySourceUnits() == std::set<std::string>{removed.uriToSourceUnitName(uriB)});
+}
+
+BOOST_AUTO_TEST_CASE(imported_files)
+{
+	util::TemporaryDirectory tempDir("lsp-file-repository-test");
+	std::string const readFileKind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+	hyperion::test::createFileWithContent(tempDir.path() / "lib.hyp", "contract L {}");
+
+	FileRepository previous(tempDir.path(), {});
+	BOOST_REQUIRE(previous.readFile(readFileKind, "lib.hyp").success);
+	BOOST_REQUIRE(!previous.readFile(readFileKind, "missing.hyp").success);
+
+	// Files loaded on import are not part of a fresh repository, but unchanged on disk.
+	FileRepository unchanged(tempDir.path(), {});
+	unchanged.markDirtySince(previous);
+	BOOST_TEST(unchanged.dirtySourceUnits().empty());
+
+	boost::filesystem::remove(tempDir.path() / "lib.hyp");
+	hyperion::test::createFileWithContent(tempDir.path() / "lib.hyp", "contract L { uint x; }");
+	hyperion::test::createFileWithContent(tempDir.path() / "missing.hyp", "contract M {}");
+	FileRepository modified(tempDir.path(), {});
+	modified.markDirtySince(previous);
+	BOOST_CHECK(modified.dirtySourceUnits() == (std::set<std::string>{"lib.hyp", "missing.hyp"}));
+}
+
+BOOST_AUTO_TEST_CASE(file_cache)
+{
+	util::TemporaryDirectory tempDir("lsp-file-repository-test");
+	boost::filesystem::path const path = tempDir.path() / "lib.hyp";
+	hyperion::test::createFileWithContent(path, "contract L {}");
+
+	FileRepository previous(tempDir.path(), {});
+	BOOST_TEST(previous.readFromDisk(path) == "contract L {}");
+
+	// The cache is handed over, but a modification is still noticed.
+	FileRepository next(tempDir.path(), {});
+	next.takeFileCacheFrom(previous);
+	BOOST_TEST(next.readFromDisk(path) == "contract L {}");
+	boost::filesystem::remove(path);
+	hyperion::test::createFileWithContent(path, "contract L { uint x; }");
+	BOOST_TEST(next.readFromDisk(path) == "contract L { uint x; }");
+	BOOST_CHECK_THROW(next.readFromDisk(tempDir.path() / "missing.hyp"), boost::filesystem::filesystem_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,170 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the reuse of parsed sources across compilations.
+ */
+
+#include <libhyperion/interface/CompilerStack.h>
+#include <libhyperion/ast/AST.h>
+#include <libhyperion/ast/ASTVisitor.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+
+using namespace hyperion::langutil;
+using namespace hyperion::util;
+
+namespace hyperion::frontend::test
+{
+
+namespace
+{
+
+std::string const c_library = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma hyperion >=0.0;
+	library L {
+		function twice(uint _x) internal pure returns (uint) { return 2 * _x; }
+	}
+	contract Base {
+		uint[] values;
+		function add(uint _x) public virtual { values.push(L.twice(_x)); }
+	}
+)";
+
+std::string const c_contract = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma hyperion >=0.0;
+	import "B.hyp";
+	contract A is Base {
+		function add(uint _x) public override { uint y = _x + 1; super.add(y); }
+	}
+)";
+
+std::string const c_modifiedContract = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma hyperion >=0.0;
+	import "B.hyp";
+	contract A is Base {
+		function add(uint _x) public override { uint y = _x + 2; super.add(y); }
+		function get(uint _i) public view returns (uint) { return values[_i]; }
+	}
+)";
+
+void requireSuccess(CompilerStack const& _compilerStack)
+{
+	BOOST_REQUIRE(_compilerStack.state() >= CompilerStack::AnalysisSuccessful);
+	BOOST_REQUIRE(!Error::containsErrors(_compilerStack.errors()));
+}
+
+/// @returns whether no two nodes of all sources have the same ID.
+bool uniqueNodeIDs(CompilerStack const& _compilerStack)
+{
+	std::set<int64_t> ids;
+	bool unique = true;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) { unique = ids.insert(_node.id()).second && unique; return true; },
+		[](ASTNode const&) {}
+	);
+	for (std::string const& sourceName: _compilerStack.sourceNames())
+		_compilerStack.ast(sourceName).accept(visitor);
+	return unique;
+}
+
+/// Compiles the modified sources from scratch and @returns the ABI of contract A.
+Json::Value freshABI(size_t _parallelism)
+{
+	CompilerStack compilerStack;
+	compilerStack.setParallelism(_parallelism);
+	compilerStack.setSources({{"A.hyp", c_modifiedContract}, {"B.hyp", c_library}});
+	compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	requireSuccess(compilerStack);
+	return compilerStack.contractABI("A");
+}
+
+void testReuse(size_t _parallelism)
+{
+	Json::Value abi;
+	{
+		CompilerStack compilerStack;
+		compilerStack.setParallelism(_parallelism);
+		compilerStack.setSources({{"A.hyp", c_contract}, {"B.hyp", c_library}});
+		compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+		requireSuccess(compilerStack);
+		SourceUnit const* libraryAST = &compilerStack.ast("B.hyp");
+		BOOST_REQUIRE(compilerStack.ast("A.hyp").id() < libraryAST->id());
+
+		compilerStack.resetKeepingParsedSources(true);
+		compilerStack.setSources({{"A.hyp", c_modifiedContract}, {"B.hyp", c_library}});
+		compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+		requireSuccess(compilerStack);
+		BOOST_CHECK(&compilerStack.ast("B.hyp") == libraryAST);
+		// The modified source is parsed after the kept one is taken over.
+		BOOST_CHECK(compilerStack.ast("A.hyp").id() > libraryAST->id());
+		BOOST_CHECK(uniqueNodeIDs(compilerStack));
+		abi = compilerStack.contractABI("A");
+	}
+	BOOST_CHECK(abi == freshABI(_parallelism));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParsedSourceReuse)
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_analysed_again)
+{
+	testReuse(1);
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_analysed_again_in_parallel)
+{
+	testReuse(2);
+}
+
+BOOST_AUTO_TEST_CASE(sources_with_warnings_are_parsed_again)
+{
+	// The missing license identifier causes a parser warning, which has to be reported again.
+	std::string const source = "pragma hyperion >=0.0;\ncontract C {}\n";
+	auto const countWarnings = [](CompilerStack const& _compilerStack) {
+		size_t count = 0;
+		for (auto const& error: _compilerStack.errors())
+			if (error->errorId() == 1878_error)
+				++count;
+		return count;
+	};
+
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"C.hyp", source}});
+	compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	requireSuccess(compilerStack);
+	BOOST_CHECK_EQUAL(countWarnings(compilerStack), 1u);
+
+	compilerStack.resetKeepingParsedSources(true);
+	compilerStack.setSources({{"C.hyp", source}});
+	compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	requireSuccess(compilerStack);
+	BOOST_CHECK_EQUAL(countWarnings(compilerStack), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <boost/test/unit_test.hpp>
+#include <libhyperion/ast/ASTBinaryFormat.h>
 #include <libhyperion/interface/OptimiserSettings.h>
 #include <libhyperion/interface/StandardCompiler.h>
 #include <libhyperion/interface/Version.h>
@@ -31,6 +32,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace hyperion::qrvmasm;
 using namespace std::string_literals;
@@ -1634,6 +1636,353 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.hyp"]["ast"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(ast_binary_import)
+{
+	char const* input = R"(
+	{
+		"language": "Hyperion",
+		"sources": {
+			"a.hyp": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\n/// @title A\ncontract A { function f(uint x) public pure returns (uint) { return x * 2; } }"
+			},
+			"b.hyp": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\nimport \"a.hyp\";\ncontract B is A { event E(string s); function g() public { emit E(\"\\u00e4\"); } }"
+			}
+		},
+		"settings": {
+			"stopAfter": "parsing",
+			"outputSelection": { "*": { "": [ "ast", "astBinary" ] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+
+	Json::Value jsonSources;
+	Json::Value binarySources;
+	for (std::string const sourceName: {"a.hyp", "b.hyp"})
+	{
+		Json::Value const& source = result["sources"][sourceName];
+		BOOST_REQUIRE(source["astBinary"].isString());
+		std::optional<std::string> data = util::fromBase64(source["astBinary"].asString());
+		BOOST_REQUIRE(data);
+		BOOST_CHECK(util::jsonCompactPrint(ASTBinaryFormat::decode(*data)) == util::jsonCompactPrint(source["ast"]));
+		jsonSources[sourceName]["ast"] = source["ast"];
+		binarySources[sourceName]["astBinary"] = source["astBinary"];
+	}
+
+	auto importInput = [](Json::Value const& _sources) {
+		Json::Value importInput;
+		importInput["language"] = "HyperionAST";
+		importInput["sources"] = _sources;
+		importInput["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+		importInput["settings"]["outputSelection"]["*"]["*"].append("metadata");
+		importInput["settings"]["outputSelection"]["*"]["*"].append("qrvm.bytecode.object");
+		return util::jsonCompactPrint(importInput);
+	};
+	Json::Value jsonImport = compile(importInput(jsonSources));
+	BOOST_REQUIRE(containsAtMostWarnings(jsonImport));
+	BOOST_REQUIRE(jsonImport["contracts"]["b.hyp"]["B"]["qrvm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(compile(importInput(binarySources)) == jsonImport);
+}
+
+BOOST_AUTO_TEST_CASE(ast_binary_import_invalid)
+{
+	for (std::string astBinary: {"", "AA==", "pUhZUEFTVA==", "pUhZUEFTVAI=", "pUhZUEFTVAIA", "not base64"})
+	{
+		Json::Value input;
+		input["language"] = "HyperionAST";
+		input["sources"]["a.hyp"]["astBinary"] = astBinary;
+		Json::Value result = compile(util::jsonCompactPrint(input));
+		BOOST_REQUIRE(result["errors"].isArray());
+		BOOST_REQUIRE(result["errors"].size() == 1);
+		BOOST_CHECK_EQUAL(result["errors"][0]["type"].asString(), "Exception");
+		BOOST_CHECK(result["errors"][0]["message"].asString().find("Failed to import AST") != std::string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(ast_binary_not_matched_by_wildcard)
+{
+	char const* input = R"(
+	{
+		"language": "Hyperion",
+		"sources": {
+			"a.hyp": { "content": "// SPDX-License-Identifier: GPL-3.0\ncontract A {}" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "": [ "*" ] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["a.hyp"]["ast"].isObject());
+	BOOST_CHECK(!result["sources"]["a.hyp"].isMember("astBinary"));
+}
+
+BOOST_AUTO_TEST_CASE(ast_binary_nesting_limit)
+{
+	auto nestedArrays = [](size_t _depth) {
+		Json::Value document(Json::arrayValue);
+		for (size_t i = 1; i < _depth; ++i)
+		{
+			Json::Value outer(Json::arrayValue);
+			outer.append(std::move(document));
+			document = std::move(outer);
+		}
+		return document;
+	};
+	Json::Value const deepest = nestedArrays(1000);
+	BOOST_CHECK(ASTBinaryFormat::decode(ASTBinaryFormat::encode(deepest)) == deepest);
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(ASTBinaryFormat::encode(nestedArrays(1001))), langutil::InvalidAstError);
+
+	// A document that is far too deep for the stack has to be rejected as well.
+	std::string data = ASTBinaryFormat::encode(Json::nullValue);
+	data.pop_back();
+	for (size_t i = 0; i < 1000000; ++i)
+		data += std::string{"\x07\x01", 2};
+	BOOST_CHECK_THROW(ASTBinaryFormat::decode(data), langutil::InvalidAstError);
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	char const* input = R"(
+	{
+		"language": "Hyperion",
+		"sources": {
+			"a.hyp": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\ncontract A { uint immutable x = 7; function f(uint y) public view returns (uint) { return x * y; } }"
+			},
+			"b.hyp": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\nimport \"a.hyp\";\ncontract B is A { event E(string s); function g() public { emit E(\"\\u00e4\"); new A(); } }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "*": { "": [ "ast" ], "*": [ "abi", "qrvm.legacyAssembly", "qrvm.bytecode.object" ] } }
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	for (util::JsonFormat format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		// The AST and the assembly are written directly to the serialized output.
+		frontend::StandardCompiler compiler({}, format);
+		std::string output = compiler.compile(std::string(input));
+		Json::Value result = compiler.compile(parsedInput);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["sources"]["b.hyp"]["ast"].isObject());
+		BOOST_REQUIRE(result["contracts"]["b.hyp"]["B"]["qrvm"]["legacyAssembly"].isObject());
+		BOOST_CHECK_EQUAL(output, util::jsonPrint(result, format));
+
+		std::ostringstream stream;
+		BOOST_CHECK(compiler.compile(std::string(input), stream));
+		BOOST_CHECK_EQUAL(stream.str(), output);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_to_stream)
+{
+	char const* input = R"(
+	{
+		"language": "Hyperion",
+		"sources": {
+			"a.hyp": { "content": "// SPDX-License-Identifier: GPL-3.0\ncontract A { function f() public {} }" },
+			"b.hyp": { "content": "// SPDX-License-Identifier: GPL-3.0\nimport \"a.hyp\";\ncontract B is A {}" }
+		},
+		"settings": {
+			"stopAfter": "parsing",
+			"outputSelection": { "*": { "": [ "ast" ] } }
+		}
+	}
+	)";
+	for (util::JsonFormat format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		frontend::StandardCompiler compiler({}, format);
+		std::string output = compiler.compile(std::string(input));
+		std::ostringstream stream;
+		BOOST_CHECK(compiler.compile(std::string(input), stream));
+		BOOST_CHECK_EQUAL(stream.str(), output);
+
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(stream.str(), result));
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_CHECK(result["sources"]["a.hyp"]["ast"].isObject());
+		BOOST_CHECK(result["sources"]["b.hyp"]["ast"].isObject());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_invalid)
+{
+	for (std::string parallelism: {"0", "-1", "\"4\"", "true"})
+	{
+		std::string input = R"(
+		{
+			"language": "Hyperion",
+			"sources":
+			{ "": { "content": "pragma hyperion >=0.0; contract C { function f() public pure {} }" } },
+			"settings":
+			{
+				"parallelism": )" + parallelism + R"(
+			}
+		}
+		)";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_output)
+{
+	auto input = [](unsigned _parallelism) {
+		return R"(
+		{
+			"language": "Hyperion",
+			"sources": {
+				"a.hyp": {
+					"content": "pragma abicoder v1; contract A { function f() public pure returns (uint) { return 1; } }"
+				},
+				"b.hyp": {
+					"content": "import \"a.hyp\"; contract B { A a = new A(); uint[] x; function g() public { x.push(a.f()); } }"
+				},
+				"c.hyp": {
+					"content": "import \"b.hyp\"; contract C { function h() public returns (B) { return new B(); } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"parallelism": )" + std::to_string(_parallelism) + R"(,
+				"outputSelection": { "*": { "*": ["irOptimized", "qrvm.bytecode", "qrvm.deployedBytecode"] } }
+			}
+		}
+		)";
+	};
+
+	Json::Value serialResult = compile(input(1));
+	BOOST_REQUIRE(serialResult["contracts"]["c.hyp"]["C"]["qrvm"]["bytecode"]["object"].isString());
+	for (unsigned parallelism: {2u, 8u})
+		BOOST_CHECK(compile(input(parallelism)) == serialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_yul_output)
+{
+	auto input = [](unsigned _parallelism) {
+		std::string const subObject = R"(object \"S\" { code { let x := calldataload(0) if lt(x, 5) { sstore(x, add(x, 1)) } } })";
+		return R"(
+		{
+			"language": "Yul",
+			"sources": {
+				"A": {
+					"content": "object \"A\" { code { datacopy(0, dataoffset(\"B\"), datasize(\"B\")) datacopy(0, dataoffset(\"C\"), datasize(\"C\")) return(0, add(datasize(\"B\"), datasize(\"C\"))) } object \"B\" { code { datacopy(0, dataoffset(\"S\"), datasize(\"S\")) return(0, datasize(\"S\")) } )" + subObject + R"( } object \"C\" { code { mstore(0, calldataload(4)) return(0, 32) } )" + subObject + R"( } }"
+				}
+			},
+			"settings": {
+				"optimizer": { "enabled": true },
+				"parallelism": )" + std::to_string(_parallelism) + R"(,
+				"outputSelection": { "*": { "*": ["irOptimized", "qrvm.bytecode"] } }
+			}
+		}
+		)";
+	};
+
+	Json::Value serialResult = compile(input(1));
+	BOOST_REQUIRE(serialResult["contracts"]["A"]["A"]["qrvm"]["bytecode"]["object"].isString());
+	for (unsigned parallelism: {2u, 8u})
+		BOOST_CHECK(compile(input(parallelism)) == serialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_does_not_affect_ast_ids)
+{
+	auto input = [](unsigned _parallelism, std::string const& _brokenSource) {
+		return R"(
+		{
+			"language": "Hyperion",
+			"sources": {
+				"a.hyp": {
+					"content": "/// @title A\ncontract A { function f() public pure returns (uint r) { assembly { r := 1 } } }"
+				},
+				"b.hyp": {
+					"content": "import {A as X} from \"a.hyp\"; contract B is X { event E(uint); }"
+				},
+				"c.hyp": {
+					"content": "import \"b.hyp\"; import \"a.hyp\" as M; contract C { M.A a; function h() public returns (B) { return new B(); } }"
+				},
+				"d.hyp": {
+					"content": ")" + _brokenSource + R"("
+				}
+			},
+			"settings": {
+				"parallelism": )" + std::to_string(_parallelism) + R"(,
+				"outputSelection": { "*": { "": ["ast"], "*": ["metadata"] } }
+			}
+		}
+		)";
+	};
+
+	for (std::string brokenSource: {"contract D {}", "contract D { function }", "contract D { uint x = ; }"})
+	{
+		Json::Value serialResult = compile(input(1, brokenSource));
+		for (unsigned parallelism: {2u, 8u})
+			BOOST_CHECK(compile(input(parallelism, brokenSource)) == serialResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(time_report)
+{
+	auto input = [](bool _timeReport) {
+		return R"(
+		{
+			"language": "Hyperion",
+			"sources": {
+				"a.hyp": {
+					"content": "contract A { function f() public pure returns (uint) { return 1; } } contract B { function g() public returns (A) { return new A(); } }"
+				}
+			},
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"timeReport": )" + std::string(_timeReport ? "true" : "false") + R"(,
+				"outputSelection": { "*": { "*": ["qrvm.bytecode"] } }
+			}
+		}
+		)";
+	};
+	Json::Value result = compile(input(true));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+
+	auto phaseNames = [](Json::Value const& _phases) {
+		std::set<std::string> names;
+		for (Json::Value const& phase: _phases)
+		{
+			BOOST_CHECK(phase["count"].asUInt() > 0);
+			BOOST_CHECK(phase["wallTimeMilliseconds"].isDouble());
+			names.insert(phase["name"].asString());
+		}
+		return names;
+	};
+	Json::Value const& report = result["timeReport"];
+	std::set<std::string> compilationPhases = phaseNames(report["compilation"]);
+	for (std::string phase: {"parsing", "importResolution", "analysis/TypeChecker", "analysis/ViewPureChecker"})
+		BOOST_CHECK_MESSAGE(compilationPhases.count(phase), phase);
+
+	BOOST_REQUIRE(report["contracts"].isObject());
+	for (std::string contract: {"a.hyp:A", "a.hyp:B"})
+	{
+		std::set<std::string> contractPhases = phaseNames(report["contracts"][contract]);
+		for (std::string phase: {"irGeneration", "yulOptimizer", "qrvmCodeTransform", "assemblyOptimization", "assembling"})
+			BOOST_CHECK_MESSAGE(contractPhases.count(phase), contract + ": " + phase);
+		// Optimizer steps are reported per Yul object.
+		BOOST_CHECK(util::contains_if(contractPhases, [](std::string const& _phase) {
+			return _phase.find("yulOptimizer/") == 0 && _phase.find("_deployed/ExpressionSimplifier") != std::string::npos;
+		}));
+	}
+
+	Json::Value const withoutReport = compile(input(false));
+	BOOST_CHECK(!withoutReport.isMember("timeReport"));
+	BOOST_CHECK(withoutReport["contracts"] == result["contracts"]);
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
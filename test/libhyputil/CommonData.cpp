@@ -96,6 +96,27 @@ BOOST_AUTO_TEST_CASE(tohex_bytes)
 	BOOST_CHECK_EQUAL(toHex(fromHex("00112233445566778899aAbBcCdDeEfF"), HexPrefix::Add, static_cast<HexCase>(42)), "0x00112233445566778899aabbccddeeff");
 }
 
+BOOST_AUTO_TEST_CASE(base64)
+{
+	// Test vectors of RFC 4648.
+	std::vector<std::pair<std::string, std::string>> const vectors{
+		{"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+		{"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}
+	};
+	for (auto const& [data, encoded]: vectors)
+	{
+		BOOST_CHECK_EQUAL(toBase64(data), encoded);
+		BOOST_CHECK(fromBase64(encoded) == data);
+	}
+
+	std::string const binary{"\x00\xff\xfe\x80\x7f", 5};
+	BOOST_CHECK_EQUAL(toBase64(binary), "AP/+gH8=");
+	BOOST_CHECK(fromBase64(toBase64(binary)) == binary);
+
+	for (std::string invalid: std::vector<std::string>{"Zg", "Zg=", "Z===", "Zh==", "Zm9=", "=Zm9", "Zg==Zm9v", "Zm9v!A==", std::string{"Zm\0v", 4}})
+		BOOST_CHECK_MESSAGE(!fromBase64(invalid), invalid);
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number)
 {
 	BOOST_CHECK_EQUAL(formatNumber(u256(0x8000000)), "0x08000000");
@@ -26,6 +26,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <functional>
+#include <sstream>
+#include <tuple>
+#include <vector>
 
 namespace hyperion::util::test
 {
@@ -117,6 +121,159 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_print_escaping)
+{
+	auto check = [](std::string const& _string, std::string const& _expectation) {
+		BOOST_CHECK_EQUAL(jsonCompactPrint(Json::Value(_string)), "\"" + _expectation + "\"");
+	};
+
+	check("a/b\x7f", "a/b\x7f");
+	check("\"\\\b\f\n\r\t", "\\\"\\\\\\b\\f\\n\\r\\t");
+	check(std::string("\x00\x01\x1f", 3), "\\u0000\\u0001\\u001f");
+	check("\xc3\xa4\xe2\x80\xae", "\\u00e4\\u202e");
+	check("\xf0\x9f\x98\x80", "\\ud83d\\ude00");
+	// Invalid sequences: overlong encodings, surrogates, truncated and stray bytes.
+	check("\xc0\x80", "\\ufffd");
+	check("\xed\xa0\x80", "\\ufffd");
+	check("x\xe2\x80", "x\\ufffd\\ufffd");
+	check("\xff", "\\ufffd");
+}
+
+BOOST_AUTO_TEST_CASE(json_writer)
+{
+	Json::Value json;
+	std::string errors;
+	BOOST_REQUIRE(jsonParseStrict(
+		R"({"a": [1, [], {}, [2, {"x": null}], {"y": "z"}], "b": {}, "c": [], "d": {"e": -1.5, "f": true}})",
+		json,
+		&errors
+	));
+
+	// Writes the value using the incremental interface as far as possible.
+	std::function<void(JsonWriter&, Json::Value const&)> writeIncrementally = [&](JsonWriter& _writer, Json::Value const& _value) {
+		if (_value.isObject())
+		{
+			_writer.beginObject();
+			for (std::string const& name: _value.getMemberNames())
+			{
+				_writer.key(name);
+				writeIncrementally(_writer, _value[name]);
+			}
+			_writer.endObject();
+		}
+		else if (_value.isArray())
+		{
+			_writer.beginArray();
+			for (Json::Value const& element: _value)
+				writeIncrementally(_writer, element);
+			_writer.endArray();
+		}
+		else
+			_writer.write(_value);
+	};
+
+	// The expectations are the output of the jsoncpp writer that was used before.
+	std::vector<std::tuple<JsonFormat, Json::Value, std::string>> const cases{
+		{
+			JsonFormat{JsonFormat::Compact},
+			json,
+			"{\"a\":[1,[],{},[2,{\"x\":null}],{\"y\":\"z\"}],\"b\":{},\"c\":[],\"d\":{\"e\":-1.5,\"f\":true}}"
+		},
+		{
+			JsonFormat{JsonFormat::Pretty},
+			json,
+			"{\n"
+			"  \"a\":\n"
+			"  [\n"
+			"    1,\n"
+			"    [],\n"
+			"    {},\n"
+			"    [\n"
+			"      2,\n"
+			"      {\n"
+			"        \"x\": null\n"
+			"      }\n"
+			"    ],\n"
+			"    {\n"
+			"      \"y\": \"z\"\n"
+			"    }\n"
+			"  ],\n"
+			"  \"b\": {},\n"
+			"  \"c\": [],\n"
+			"  \"d\":\n"
+			"  {\n"
+			"    \"e\": -1.5,\n"
+			"    \"f\": true\n"
+			"  }\n"
+			"}"
+		},
+		{
+			JsonFormat{JsonFormat::Pretty, 0},
+			json,
+			"{\"a\": [1,[],{},[2,{\"x\": null}],{\"y\": \"z\"}],\"b\": {},\"c\": [],\"d\": {\"e\": -1.5,\"f\": true}}"
+		},
+		{
+			JsonFormat{JsonFormat::Pretty, 4},
+			json["a"],
+			"[\n"
+			"    1,\n"
+			"    [],\n"
+			"    {},\n"
+			"    [\n"
+			"        2,\n"
+			"        {\n"
+			"            \"x\": null\n"
+			"        }\n"
+			"    ],\n"
+			"    {\n"
+			"        \"y\": \"z\"\n"
+			"    }\n"
+			"]"
+		},
+		{JsonFormat{JsonFormat::Compact}, json["b"], "{}"},
+		{JsonFormat{JsonFormat::Pretty}, json["b"], "{}"},
+		{JsonFormat{JsonFormat::Pretty}, json["c"], "[]"},
+		{JsonFormat{JsonFormat::Pretty}, json["d"]["e"], "-1.5"},
+	};
+	for (auto const& [format, value, expectation]: cases)
+	{
+		std::ostringstream whole;
+		JsonWriter(whole, format).write(value);
+		BOOST_CHECK_EQUAL(whole.str(), expectation);
+		BOOST_CHECK_EQUAL(jsonPrint(value, format), expectation);
+
+		std::ostringstream incremental;
+		JsonWriter incrementalWriter(incremental, format);
+		writeIncrementally(incrementalWriter, value);
+		BOOST_CHECK_EQUAL(incremental.str(), expectation);
+
+		// Members written to a separate buffer continue the indentation of the enclosing writer.
+		std::ostringstream buffered;
+		JsonWriter bufferedWriter(buffered, format);
+		if (value.isObject())
+		{
+			bufferedWriter.beginObject();
+			for (std::string const& name: value.getMemberNames())
+			{
+				bufferedWriter.key(name);
+				bufferedWriter.writeBuffered([&](JsonWriter& _writer) { writeIncrementally(_writer, value[name]); });
+			}
+			bufferedWriter.endObject();
+		}
+		else
+			bufferedWriter.writeBuffered([&](JsonWriter& _writer) { writeIncrementally(_writer, value); });
+		BOOST_CHECK_EQUAL(buffered.str(), expectation);
+	}
+
+	std::ostringstream stream;
+	JsonWriter writer(stream, {});
+	writer.beginObject();
+	writer.key("b");
+	writer.write(1);
+	BOOST_CHECK_THROW(writer.key("a"), Exception);
+	BOOST_CHECK_THROW(writer.endArray(), Exception);
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
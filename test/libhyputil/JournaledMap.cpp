@@ -0,0 +1,114 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyputil/JournaledMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace hyperion::util::test
+{
+
+using Map = std::map<std::string, int>;
+
+BOOST_AUTO_TEST_SUITE(JournaledMapTest)
+
+BOOST_AUTO_TEST_CASE(modifications)
+{
+	JournaledMap<Map> map;
+	map.set("a", 1);
+	map.set("b", 2);
+	map.set("a", 3);
+	map.erase("b");
+	map.set("c", 4);
+	map.eraseIf([](std::string const&, int _value) { return _value == 4; });
+	BOOST_CHECK(map.data() == (Map{{"a", 3}}));
+	BOOST_CHECK(map.valueOrNullptr("a") && *map.valueOrNullptr("a") == 3);
+	BOOST_CHECK(!map.valueOrNullptr("b"));
+	map.clear();
+	BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE(join_removes_changed_entries)
+{
+	JournaledMap<std::unordered_map<std::string, int>> map;
+	map.set("unchanged", 1);
+	map.set("modified", 2);
+	map.set("erased", 3);
+	map.set("restored", 4);
+
+	size_t checkpoint = map.checkpoint();
+	map.set("modified", 5);
+	map.erase("erased");
+	map.set("added", 6);
+	map.set("restored", 7);
+	map.set("restored", 4);
+	map.joinWithCheckpoint(checkpoint);
+
+	BOOST_CHECK((Map{map.data().begin(), map.data().end()}) == (Map{{"unchanged", 1}, {"restored", 4}}));
+}
+
+BOOST_AUTO_TEST_CASE(nested_checkpoints)
+{
+	JournaledMap<Map> map;
+	map.set("a", 1);
+	map.set("b", 2);
+	map.set("c", 3);
+
+	size_t outer = map.checkpoint();
+	map.set("a", 10);
+	size_t inner = map.checkpoint();
+	map.set("b", 20);
+	map.clear();
+	map.set("c", 3);
+	map.joinWithCheckpoint(inner);
+	// Only the change inside the outer checkpoint remains visible to it.
+	BOOST_CHECK(map.data() == (Map{{"c", 3}}));
+	map.set("d", 4);
+	map.joinWithCheckpoint(outer);
+	BOOST_CHECK(map.data() == (Map{{"c", 3}}));
+
+	// Joining again without an active checkpoint is an error.
+	BOOST_CHECK_THROW(map.joinWithCheckpoint(outer), BadJournaledMapCheckpoint);
+}
+
+BOOST_AUTO_TEST_CASE(branches)
+{
+	// Two consecutive branches joined with the same state, as done for the cases of a switch.
+	JournaledMap<Map> map;
+	map.set("a", 1);
+	map.set("b", 2);
+
+	size_t checkpoint = map.checkpoint();
+	map.set("a", 3);
+	map.joinWithCheckpoint(checkpoint);
+	BOOST_CHECK(map.data() == (Map{{"b", 2}}));
+
+	checkpoint = map.checkpoint();
+	map.set("a", 1);
+	map.set("b", 2);
+	map.joinWithCheckpoint(checkpoint);
+	BOOST_CHECK(map.data() == (Map{{"b", 2}}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,97 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyputil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+namespace hyperion::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(runs_every_index_exactly_once)
+{
+	for (size_t threads: {0u, 1u, 4u})
+	{
+		ThreadPool pool(threads);
+		std::vector<std::atomic<unsigned>> calls(100);
+		std::vector<std::exception_ptr> failures = pool.parallelFor(calls.size(), [&](size_t _index) {
+			++calls[_index];
+		});
+
+		BOOST_TEST(failures.size() == calls.size());
+		for (size_t i = 0; i < calls.size(); ++i)
+		{
+			BOOST_TEST(calls[i] == 1);
+			BOOST_TEST(!failures[i]);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(empty_batch)
+{
+	ThreadPool pool(2);
+	BOOST_TEST(pool.parallelFor(0, [](size_t) { BOOST_FAIL("Unexpected task."); }).empty());
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_are_reported_per_index)
+{
+	ThreadPool pool(3);
+	std::atomic<unsigned> finished = 0;
+	std::vector<std::exception_ptr> failures = pool.parallelFor(10, [&](size_t _index) {
+		if (_index % 3 == 0)
+			throw std::runtime_error(std::to_string(_index));
+		++finished;
+	});
+
+	BOOST_TEST(finished == 6);
+	for (size_t i = 0; i < failures.size(); ++i)
+	{
+		BOOST_TEST(!!failures[i] == (i % 3 == 0));
+		if (failures[i])
+			BOOST_CHECK_EXCEPTION(
+				std::rethrow_exception(failures[i]),
+				std::runtime_error,
+				[&](std::runtime_error const& _error) { return _error.what() == std::to_string(i); }
+			);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_batches)
+{
+	// More nested batches than threads must not dead-lock, since waiting threads help out.
+	ThreadPool pool(2);
+	std::vector<size_t> sums(8);
+	pool.parallelFor(sums.size(), [&](size_t _outer) {
+		std::vector<size_t> values(_outer + 1);
+		pool.parallelFor(values.size(), [&](size_t _inner) { values[_inner] = _inner; });
+		sums[_outer] = std::accumulate(values.begin(), values.end(), size_t(0));
+	});
+
+	for (size_t i = 0; i < sums.size(); ++i)
+		BOOST_TEST(sums[i] == i * (i + 1) / 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
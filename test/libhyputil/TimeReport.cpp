@@ -0,0 +1,107 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libhyputil/TimeReport.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+namespace hyperion::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(TimeReportTest)
+
+BOOST_AUTO_TEST_CASE(phases_are_recorded_per_unit)
+{
+	TimeReport report;
+	{
+		TimeReport::ScopedPhase unrecorded("unrecorded");
+		BOOST_TEST(!TimeReport::active());
+	}
+	{
+		TimeReport::ScopedUnit unit(&report, "");
+		BOOST_TEST(TimeReport::active());
+		TimeReport::ScopedPhase outer("outer");
+		for (size_t i = 0; i < 3; ++i)
+		{
+			TimeReport::ScopedUnit contractUnit(&report, "C");
+			TimeReport::ScopedPhase inner("inner/", std::to_string(i % 2));
+		}
+	}
+	BOOST_TEST(!TimeReport::active());
+
+	auto phases = report.phases();
+	BOOST_REQUIRE(phases.size() == 2);
+	BOOST_REQUIRE(phases[""].size() == 1);
+	BOOST_TEST(phases[""][0].name == "outer");
+	BOOST_TEST(phases[""][0].count == 1);
+	BOOST_REQUIRE(phases["C"].size() == 2);
+	BOOST_TEST(phases["C"][0].name == "inner/0");
+	BOOST_TEST(phases["C"][0].count == 2);
+	BOOST_TEST(phases["C"][1].name == "inner/1");
+	BOOST_TEST(phases["C"][1].count == 1);
+	BOOST_CHECK(phases[""][0].wallTime >= phases["C"][0].wallTime + phases["C"][1].wallTime);
+
+	report.clear();
+	BOOST_TEST(report.phases().empty());
+}
+
+BOOST_AUTO_TEST_CASE(phase_sequence)
+{
+	TimeReport report;
+	{
+		TimeReport::ScopedUnit unit(&report, "");
+		TimeReport::PhaseSequence phases;
+		phases.next("first");
+		phases.next("second");
+		phases.next("first");
+		phases.end();
+		TimeReport::ScopedPhase last("last");
+	}
+
+	auto phases = report.phases()[""];
+	BOOST_REQUIRE(phases.size() == 3);
+	BOOST_TEST(phases[0].name == "first");
+	BOOST_TEST(phases[0].count == 2);
+	BOOST_TEST(phases[1].name == "second");
+	BOOST_TEST(phases[2].name == "last");
+}
+
+BOOST_AUTO_TEST_CASE(units_are_per_thread)
+{
+	TimeReport report;
+	TimeReport::ScopedUnit unit(&report, "main");
+	bool activeOnOtherThread = true;
+	std::thread([&]() {
+		activeOnOtherThread = TimeReport::active();
+		TimeReport::ScopedPhase unrecorded("other thread");
+		TimeReport::ScopedUnit workerUnit(&report, "worker");
+		TimeReport::ScopedPhase recorded("worker thread");
+	}).join();
+
+	BOOST_TEST(!activeOnOtherThread);
+	auto phases = report.phases();
+	BOOST_TEST(phases.count("main") == 0);
+	BOOST_REQUIRE(phases["worker"].size() == 1);
+	BOOST_TEST(phases["worker"][0].name == "worker thread");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
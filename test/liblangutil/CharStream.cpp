@@ -128,6 +128,46 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 0, "ABC\nDEF\nGHI\n"), 8);
 	BOOST_CHECK_EQUAL(toPosition(2, 1, "ABC\nDEF\nGHI\n"), 9);
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
+
+	BOOST_CHECK_EQUAL(toPosition(1, -1, "ABC\nDEF"), std::nullopt);
+	BOOST_CHECK_EQUAL(toPosition(1, 0, "\n\n"), 1);
+	BOOST_CHECK_EQUAL(toPosition(1, 1, "\n\n"), std::nullopt);
+}
+
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	auto toLineColumn = [](int _position, std::string const& _text) {
+		LineColumn const lineColumn = CharStream{_text, "source"}.translatePositionToLineColumn(_position);
+		return std::make_pair(lineColumn.line, lineColumn.column);
+	};
+	using LC = std::pair<int, int>;
+
+	BOOST_CHECK(toLineColumn(0, "") == LC(0, 0));
+	BOOST_CHECK(toLineColumn(5, "") == LC(0, 0));
+
+	BOOST_CHECK(toLineColumn(0, "ABC\nDEF\n") == LC(0, 0));
+	BOOST_CHECK(toLineColumn(2, "ABC\nDEF\n") == LC(0, 2));
+	BOOST_CHECK(toLineColumn(3, "ABC\nDEF\n") == LC(0, 3));
+	BOOST_CHECK(toLineColumn(4, "ABC\nDEF\n") == LC(1, 0));
+	BOOST_CHECK(toLineColumn(7, "ABC\nDEF\n") == LC(1, 3));
+	BOOST_CHECK(toLineColumn(8, "ABC\nDEF\n") == LC(2, 0));
+	// Positions past the end are clamped.
+	BOOST_CHECK(toLineColumn(100, "ABC\nDEF") == LC(1, 3));
+
+	BOOST_CHECK(toLineColumn(1, "\n\n\n") == LC(1, 0));
+	BOOST_CHECK(toLineColumn(3, "\n\n\n") == LC(3, 0));
+}
+
+BOOST_AUTO_TEST_CASE(translation_round_trip)
+{
+	std::string const text = "contract C {\r\n\tfunction f() {}\n\n}\n// end";
+	CharStream const stream{text, "source"};
+	for (int position = 0; position <= static_cast<int>(text.size()); ++position)
+	{
+		LineColumn const lineColumn = stream.translatePositionToLineColumn(position);
+		BOOST_CHECK_EQUAL(stream.translateLineColumnToPosition(lineColumn), position);
+		BOOST_CHECK_EQUAL(CharStream::translateLineColumnToPosition(text, lineColumn), position);
+	}
 }
 
 BOOST_AUTO_TEST_SUITE_END()
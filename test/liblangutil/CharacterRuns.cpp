@@ -0,0 +1,123 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the block-wise character run search used by the scanner.
+ */
+
+#include <liblangutil/CharacterRuns.h>
+#include <liblangutil/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+#include <string>
+
+namespace hyperion::langutil::test
+{
+
+namespace
+{
+
+/// Checks @a _runLength against the length of the prefix accepted by @a _accepts for every byte
+/// at every position of runs that are longer than any block size.
+void checkAgainstScalar(
+	std::function<size_t(std::string_view)> const& _runLength,
+	std::function<bool(char)> const& _accepts,
+	char _filler
+)
+{
+	BOOST_REQUIRE(_accepts(_filler));
+	BOOST_CHECK_EQUAL(_runLength(""), 0);
+	for (size_t length: {1u, 15u, 16u, 17u, 31u, 32u, 33u, 64u, 100u})
+	{
+		std::string const run(length, _filler);
+		BOOST_CHECK_EQUAL(_runLength(run), length);
+		for (size_t position: {size_t(0), length / 2, length - 1})
+			for (unsigned byte = 0; byte < 0x100; ++byte)
+			{
+				std::string text = run + "\n";
+				text[position] = static_cast<char>(byte);
+				size_t const expectation = _accepts(static_cast<char>(byte)) ? length + (_accepts('\n') ? 1 : 0) : position;
+				BOOST_CHECK_MESSAGE(
+					_runLength(text) == expectation,
+					"byte " << byte << " at position " << position << " of " << length
+				);
+			}
+	}
+}
+
+bool isLineBreakLead(char _c)
+{
+	uint8_t const byte = static_cast<uint8_t>(_c);
+	return (0x0a <= byte && byte <= 0x0d) || byte == 0xc2 || byte == 0xe2;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CharacterRunsTest)
+
+BOOST_AUTO_TEST_CASE(white_space)
+{
+	checkAgainstScalar(whiteSpaceRunLength, isWhiteSpace, ' ');
+	checkAgainstScalar(whiteSpaceRunLength, isWhiteSpace, '\t');
+}
+
+BOOST_AUTO_TEST_CASE(identifier_part)
+{
+	for (bool allowDot: {false, true})
+		checkAgainstScalar(
+			[&](std::string_view _text) { return identifierPartRunLength(_text, allowDot); },
+			[&](char _c) { return isIdentifierPart(_c) || (allowDot && _c == '.'); },
+			'a'
+		);
+}
+
+BOOST_AUTO_TEST_CASE(non_line_break)
+{
+	checkAgainstScalar(nonLineBreakRunLength, [](char _c) { return !isLineBreakLead(_c); }, 'x');
+}
+
+BOOST_AUTO_TEST_CASE(multi_line_comment)
+{
+	checkAgainstScalar(
+		multiLineCommentRunLength,
+		[](char _c) { return _c != '*' && _c != '\n' && _c != '\r'; },
+		'/'
+	);
+}
+
+BOOST_AUTO_TEST_CASE(string_body)
+{
+	for (char quote: {'"', '\''})
+	{
+		checkAgainstScalar(
+			[&](std::string_view _text) { return stringRunLength(_text, quote, false); },
+			[&](char _c) { return _c != quote && _c != '\\' && 0x20 <= _c && _c <= 0x7e; },
+			'x'
+		);
+		checkAgainstScalar(
+			[&](std::string_view _text) { return stringRunLength(_text, quote, true); },
+			[&](char _c) { return _c != quote && _c != '\\' && !isLineBreakLead(_c); },
+			'x'
+		);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
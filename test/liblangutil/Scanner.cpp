@@ -1025,6 +1025,38 @@ BOOST_AUTO_TEST_CASE(yul_function_with_whitespace)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(long_runs)
+{
+	// Longer than the blocks the scanner classifies at once.
+	std::string const word(100, 'a');
+	std::string const spaces(70, ' ');
+	TestScanner scanner(
+		spaces + word + "_$1" + spaces + "\"" + word + "\\n" + word + "\"" + spaces +
+		"/** " + word + "\n * " + word + " */" + spaces + "x /* " + word + "\xE2\x80\xAE */"
+	);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), word + "_$1");
+	BOOST_CHECK_EQUAL(scanner.currentLocation().start, 70);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), word + "\n" + word);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), word + "\n " + word + " ");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::DirectionalOverrideMismatch);
+
+	scanner.reset("\"" + word + "\x01" + word + "\"");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::UnicodeCharacterInNonUnicodeString);
+	BOOST_CHECK_EQUAL(scanner.currentLocation().end, 102);
+
+	scanner.reset("unicode\"" + word + "\xC3\xA9" + word + "\n\"");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalStringEndQuote);
+
+	scanner.reset("// " + word + "\xE2\x80\xA8 x");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
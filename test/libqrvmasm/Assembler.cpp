@@ -25,12 +25,14 @@
 #include <libqrvmasm/Assembly.h>
 #include <libhyputil/JSON.h>
 #include <libqrvmasm/Disassemble.h>
+#include <libhyputil/ThreadPool.h>
 #include <libyul/Exceptions.h>
 
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <tuple>
 
@@ -49,6 +51,38 @@ namespace
 		BOOST_CHECK(output.bytecode.size() > 0);
 		BOOST_CHECK(output.toHex().length() > 0);
 	}
+
+	/// Creates an assembly with @a _subCount sub-assemblies that each contain some
+	/// redundant code and jumps, referencing the tags of each other sub.
+	std::shared_ptr<Assembly> createAssemblyWithSubs(QRVMVersion _qrvmVersion, size_t _subCount)
+	{
+		auto assembly = std::make_shared<Assembly>(_qrvmVersion, true, std::string{});
+		std::vector<AssemblyItem> subTags;
+		for (size_t i = 0; i < _subCount; ++i)
+		{
+			auto sub = std::make_shared<Assembly>(_qrvmVersion, false, std::string{});
+			AssemblyItem loop = sub->newTag();
+			AssemblyItem exit = sub->newTag();
+			sub->append(loop);
+			sub->append(u256(i));
+			sub->append(u256(0));
+			sub->append(Instruction::ADD);
+			sub->append(Instruction::DUP1);
+			sub->append(Instruction::POP);
+			sub->appendJumpI(exit);
+			sub->appendJump(loop);
+			sub->append(exit);
+			sub->append(Instruction::STOP);
+			sub->append(sub->newTag());
+			sub->append(Instruction::INVALID);
+			assembly->appendSubroutine(sub);
+			subTags.push_back(loop.toSubAssemblyTag(i));
+		}
+		for (AssemblyItem const& tag: subTags)
+			assembly->append(tag.pushTag());
+		assembly->append(Instruction::STOP);
+		return assembly;
+	}
 }
 
 BOOST_AUTO_TEST_SUITE(Assembler)
@@ -213,6 +247,13 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 	Json::Value jsonValue;
 	BOOST_CHECK(util::jsonParseStrict(json, jsonValue));
 	BOOST_CHECK_EQUAL(util::jsonCompactPrint(_assembly.assemblyJSON(indices)), util::jsonCompactPrint(jsonValue));
+	for (util::JsonFormat format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		std::ostringstream streamed;
+		util::JsonWriter writer(streamed, format);
+		_assembly.assemblyJSON(writer, indices);
+		BOOST_CHECK_EQUAL(streamed.str(), util::jsonPrint(jsonValue, format));
+	}
 }
 
 BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
@@ -420,6 +461,25 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_sub_assembly_optimisation)
+{
+	QRVMVersion qrvmVersion = hyperion::test::CommonOptions::get().qrvmVersion();
+	Assembly::OptimiserSettings settings = Assembly::OptimiserSettings::translateSettings(
+		frontend::OptimiserSettings::full(),
+		qrvmVersion
+	);
+
+	std::shared_ptr<Assembly> sequential = createAssemblyWithSubs(qrvmVersion, 4);
+	sequential->optimise(settings);
+
+	util::ThreadPool pool(4);
+	std::shared_ptr<Assembly> parallel = createAssemblyWithSubs(qrvmVersion, 4);
+	parallel->optimise(settings, &pool);
+
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK_EQUAL(parallel->assemble().toHex(), sequential->assemble().toHex());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
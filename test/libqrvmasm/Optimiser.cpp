@@ -24,6 +24,7 @@
 #include <test/Common.h>
 
 #include <libqrvmasm/CommonSubexpressionEliminator.h>
+#include <libqrvmasm/ConstantOptimiser.h>
 #include <libqrvmasm/PeepholeOptimiser.h>
 #include <libqrvmasm/Inliner.h>
 #include <libqrvmasm/JumpdestRemover.h>
@@ -31,6 +32,8 @@
 #include <libqrvmasm/BlockDeduplicator.h>
 #include <libqrvmasm/Assembly.h>
 
+#include <libhyputil/TimeReport.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -1421,7 +1424,7 @@ BOOST_AUTO_TEST_CASE(verbatim_knownstate)
 			Instruction::DUP3,
 			Instruction::DUP4
 		});
-	std::map<int, unsigned> const& stackElements = state.stackElements();
+	auto const& stackElements = state.stackElements();
 
 	BOOST_CHECK(state.stackHeight() == 4);
 	// One more than stack height because of the initial unknown element.
@@ -1453,6 +1456,54 @@ BOOST_AUTO_TEST_CASE(verbatim_knownstate)
 				BOOST_CHECK(stackElements.at(height1) != stackElements.at(height2));
 }
 
+BOOST_AUTO_TEST_CASE(knownstate_copy_on_write)
+{
+	// Hashes of memory content are shared between copies of a state until one of them
+	// learns a new hash.
+	KnownState state = createInitialState(AssemblyItems{
+		Instruction::CALLER,
+		u256(0),
+		Instruction::MSTORE,
+		u256(32),
+		u256(0),
+		Instruction::KECCAK256
+	});
+	KnownState::Id const callerHash = state.stackElements().at(state.stackHeight());
+
+	std::shared_ptr<KnownState> copy = state.copy();
+	for (AssemblyItem const& item: addDummyLocations({
+		Instruction::POP,
+		Instruction::ADDRESS,
+		u256(0),
+		Instruction::MSTORE,
+		u256(32),
+		u256(0),
+		Instruction::KECCAK256
+	}))
+		copy->feedItem(item, true);
+	KnownState::Id const addressHashInCopy = copy->stackElements().at(copy->stackHeight());
+	BOOST_CHECK(addressHashInCopy != callerHash);
+
+	// The original does not know the hash computed by the copy. The storage write moves the
+	// original to a new sequence number, so that hashing the same content leads to a new class.
+	for (AssemblyItem const& item: addDummyLocations({
+		Instruction::POP,
+		Instruction::CALLER,
+		Instruction::CALLER,
+		Instruction::SSTORE,
+		Instruction::ADDRESS,
+		u256(0),
+		Instruction::MSTORE,
+		u256(32),
+		u256(0),
+		Instruction::KECCAK256
+	}))
+		state.feedItem(item, true);
+	KnownState::Id const addressHash = state.stackElements().at(state.stackHeight());
+	BOOST_CHECK(addressHash != addressHashInCopy);
+	BOOST_CHECK(addressHash != callerHash);
+}
+
 BOOST_AUTO_TEST_CASE(cse_remove_redundant_shift_masking)
 {
 	for (unsigned i = 1; i < 256; i++)
@@ -1637,6 +1688,34 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_representation_cache)
+{
+	// Value that is not used by any other test, since the cache is shared by the whole process.
+	u256 const value = (u256(0xc0ffee) << 224) + 0x1234567;
+	QRVMVersion const qrvmVersion = hyperion::test::CommonOptions::get().qrvmVersion();
+	auto optimiseConstants = [&]()
+	{
+		Assembly assembly{qrvmVersion, false, {}};
+		assembly.append(value);
+		assembly.append(value);
+		ConstantOptimisationMethod::optimiseConstants(false, 200, qrvmVersion, assembly);
+		return assembly.items();
+	};
+
+	util::TimeReport report;
+	util::TimeReport::ScopedUnit unit(&report, "");
+	AssemblyItems const searched = optimiseConstants();
+	AssemblyItems const cached = optimiseConstants();
+	BOOST_CHECK(searched == cached);
+
+	std::map<std::string, size_t> counts;
+	auto phases = report.phases()[""];
+	for (util::TimeReport::Phase const& phase: phases)
+		counts[phase.name] = phase.count;
+	BOOST_CHECK_EQUAL(counts["constantRepresentationSearch"], 1u);
+	BOOST_CHECK_EQUAL(counts["constantRepresentationCacheHit"], 1u);
+}
+
 BOOST_AUTO_TEST_CASE(inliner)
 {
 	AssemblyItem jumpInto{Instruction::JUMP};
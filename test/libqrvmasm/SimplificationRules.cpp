@@ -0,0 +1,196 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the selection of simplification rules on expression classes.
+ */
+
+#include <libqrvmasm/ExpressionClasses.h>
+#include <libqrvmasm/RuleList.h>
+#include <libqrvmasm/SimplificationRules.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace hyperion::langutil;
+using namespace hyperion::qrvmasm;
+
+namespace hyperion::frontend::test
+{
+
+namespace
+{
+
+/// Rule matching as done before the decision tree: all rules of the expression's
+/// instruction are tried in order.
+class LinearRuleMatcher
+{
+public:
+	using Expression = ExpressionClasses::Expression;
+
+	LinearRuleMatcher()
+	{
+		Pattern A(Push);
+		Pattern B(Push);
+		Pattern C(Push);
+		Pattern W;
+		Pattern X;
+		Pattern Y;
+		Pattern Z;
+		A.setMatchGroup(1, m_matchGroups);
+		B.setMatchGroup(2, m_matchGroups);
+		C.setMatchGroup(3, m_matchGroups);
+		W.setMatchGroup(4, m_matchGroups);
+		X.setMatchGroup(5, m_matchGroups);
+		Y.setMatchGroup(6, m_matchGroups);
+		Z.setMatchGroup(7, m_matchGroups);
+		for (auto const& rule: simplificationRuleList(std::nullopt, A, B, C, W, X, Y, Z))
+			m_rules[uint8_t(rule.pattern.instruction())].push_back(rule);
+	}
+	/// The rules refer to the match groups of this object.
+	LinearRuleMatcher(LinearRuleMatcher const&) = delete;
+	LinearRuleMatcher& operator=(LinearRuleMatcher const&) = delete;
+
+	SimplificationRule<Pattern> const* findFirstMatch(Expression const& _expr, ExpressionClasses const& _classes)
+	{
+		for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+		{
+			m_matchGroups.fill(nullptr);
+			if (rule.pattern.matches(_expr, _classes))
+				if (!rule.feasible || rule.feasible())
+					return &rule;
+		}
+		return nullptr;
+	}
+
+private:
+	MatchGroups<Expression> m_matchGroups{};
+	std::vector<SimplificationRule<Pattern>> m_rules[256];
+};
+
+/// @returns the pattern and the replacement of @a _rule, which has to be called directly after
+/// the rule was matched, or an empty string if no rule matched.
+std::string describe(SimplificationRule<Pattern> const* _rule)
+{
+	if (!_rule)
+		return {};
+	return _rule->pattern.toString() + " -> " + ExpressionTemplate(_rule->action(), SourceLocation{}).toString();
+}
+
+/// Generates random expressions over the operations and constants that occur in the rules.
+/// The arguments are expression classes built from earlier expressions, so that nested
+/// patterns can match.
+class RandomExpressions
+{
+public:
+	RandomExpressions(unsigned _seed, ExpressionClasses& _classes): m_random(_seed), m_classes(_classes)
+	{
+		for (u256 const& constant: m_constants)
+			m_pool.push_back(m_classes.find(AssemblyItem(constant)));
+		for (size_t i = 0; i < 4; ++i)
+			m_pool.push_back(m_classes.find(Instruction::CALLDATALOAD, {m_pool[pick(m_pool.size())]}));
+		m_pool.push_back(m_classes.find(Instruction::ADDRESS));
+	}
+
+	/// @returns the next operation together with its arguments. The expression is also added
+	/// to the classes, so that it can be used as an argument of the following expressions.
+	std::pair<AssemblyItem const*, ExpressionClasses::Ids> next()
+	{
+		auto const& [instruction, arity] = m_operations[pick(m_operations.size())];
+		ExpressionClasses::Ids arguments;
+		for (size_t i = 0; i < arity; ++i)
+			arguments.push_back(m_pool[pick(m_pool.size())]);
+		AssemblyItem const* item = m_classes.storeItem(AssemblyItem(instruction));
+		m_pool.push_back(m_classes.find(*item, arguments));
+		return {item, arguments};
+	}
+
+private:
+	size_t pick(size_t _count) { return std::uniform_int_distribution<size_t>(0, _count - 1)(m_random); }
+
+	std::mt19937 m_random;
+	ExpressionClasses& m_classes;
+	std::vector<ExpressionClasses::Id> m_pool;
+	std::vector<std::pair<Instruction, size_t>> const m_operations{
+		{Instruction::ADD, 2}, {Instruction::SUB, 2}, {Instruction::MUL, 2}, {Instruction::DIV, 2},
+		{Instruction::SDIV, 2}, {Instruction::MOD, 2}, {Instruction::SMOD, 2}, {Instruction::EXP, 2},
+		{Instruction::NOT, 1}, {Instruction::LT, 2}, {Instruction::GT, 2}, {Instruction::SLT, 2},
+		{Instruction::SGT, 2}, {Instruction::EQ, 2}, {Instruction::ISZERO, 1}, {Instruction::AND, 2},
+		{Instruction::OR, 2}, {Instruction::XOR, 2}, {Instruction::BYTE, 2}, {Instruction::SHL, 2},
+		{Instruction::SHR, 2}, {Instruction::SAR, 2}, {Instruction::ADDMOD, 3}, {Instruction::MULMOD, 3},
+		{Instruction::SIGNEXTEND, 2}, {Instruction::BALANCE, 1}
+	};
+	std::vector<u256> const m_constants{
+		0, 1, 2, 8, 31, 32, 255, 256,
+		u256("0xffffffffffffffffffffffffffffffffffffffff"),
+		u256("0x8000000000000000000000000000000000000000000000000000000000000000"),
+		u256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"),
+		u256("0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe")
+	};
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(QRVMAsmSimplificationRules)
+
+BOOST_AUTO_TEST_CASE(decision_tree_selects_same_rules_as_linear_scan)
+{
+	Rules rules;
+	LinearRuleMatcher linearMatcher;
+
+	size_t expressions = 0;
+	size_t matches = 0;
+	for (unsigned seed = 0; seed < 20; ++seed)
+	{
+		ExpressionClasses classes;
+		RandomExpressions randomExpressions(seed, classes);
+		for (size_t i = 0; i < 200; ++i)
+		{
+			auto [item, arguments] = randomExpressions.next();
+			ExpressionClasses::Expression expression;
+			expression.item = item;
+			expression.arguments = arguments;
+
+			std::string const treeResult = describe(rules.findFirstMatch(expression, classes));
+			std::string const linearResult = describe(linearMatcher.findFirstMatch(expression, classes));
+			if (treeResult != linearResult)
+			{
+				std::stringstream dag;
+				dag << *item << "(";
+				for (ExpressionClasses::Id argument: arguments)
+					dag << classes.fullDAGToString(argument) << ",";
+				BOOST_ERROR("Different rules selected for " + dag.str() + "): " + treeResult + " vs. " + linearResult);
+			}
+			if (!treeResult.empty())
+				++matches;
+			++expressions;
+		}
+	}
+
+	// Make sure that the generated expressions actually exercise the rules.
+	BOOST_TEST_MESSAGE(std::to_string(matches) + " of " + std::to_string(expressions) + " expressions matched a rule.");
+	BOOST_CHECK(matches > expressions / 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
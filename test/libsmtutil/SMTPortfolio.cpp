@@ -0,0 +1,248 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SMTPortfolio.h>
+#ifdef HAVE_Z3
+#include <libsmtutil/Z3Interface.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace hyperion::smtutil::test
+{
+
+namespace
+{
+
+/// Lets a fixed number of threads wait for each other.
+class Barrier
+{
+public:
+	explicit Barrier(size_t _count): m_count(_count) {}
+
+	void arriveAndWait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (--m_count == 0)
+			m_allArrived.notify_all();
+		else
+			m_allArrived.wait(lock, [&] { return m_count == 0; });
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_allArrived;
+	size_t m_count;
+};
+
+/// Solver that gives a fixed answer to every query.
+class MockSolver: public SolverInterface
+{
+public:
+	enum class Behaviour { Answer, Throw, WaitForInterrupt };
+
+	explicit MockSolver(
+		CheckResult _result,
+		Behaviour _behaviour = Behaviour::Answer,
+		Barrier* _barrier = nullptr,
+		std::vector<std::string> _values = {}
+	):
+		m_result(_result), m_behaviour(_behaviour), m_barrier(_barrier), m_values(std::move(_values)) {}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const&) override
+	{
+		if (m_barrier)
+			m_barrier->arriveAndWait();
+		switch (m_behaviour)
+		{
+		case Behaviour::Answer:
+			return {m_result, m_values};
+		case Behaviour::Throw:
+			BOOST_THROW_EXCEPTION(SolverError());
+		case Behaviour::WaitForInterrupt:
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_interruptedChanged.wait(lock, [&] { return m_interrupted; });
+			return {CheckResult::UNKNOWN, {}};
+		}
+		}
+		return {CheckResult::ERROR, {}};
+	}
+
+	void interrupt() override
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_interrupted = true;
+		m_interruptedChanged.notify_all();
+	}
+
+private:
+	CheckResult m_result;
+	Behaviour m_behaviour;
+	Barrier* m_barrier;
+	std::vector<std::string> m_values;
+	std::mutex m_mutex;
+	std::condition_variable m_interruptedChanged;
+	bool m_interrupted = false;
+};
+
+template <typename... Solvers>
+SMTPortfolio makePortfolio(Solvers... _solvers)
+{
+	std::vector<std::unique_ptr<SolverInterface>> solvers;
+	(solvers.emplace_back(std::move(_solvers)), ...);
+	return SMTPortfolio(std::move(solvers));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(first_answer_interrupts_other_solvers)
+{
+	SMTPortfolio portfolio = makePortfolio(
+		std::make_unique<MockSolver>(CheckResult::SATISFIABLE),
+		std::make_unique<MockSolver>(CheckResult::UNSATISFIABLE, MockSolver::Behaviour::WaitForInterrupt)
+	);
+
+	BOOST_TEST((portfolio.check({}).first == CheckResult::SATISFIABLE));
+	BOOST_REQUIRE(portfolio.queryStatistics().size() == 1);
+	auto const& runs = portfolio.queryStatistics().front();
+	BOOST_REQUIRE(runs.size() == 2);
+	BOOST_TEST((runs[0].result == CheckResult::SATISFIABLE));
+	BOOST_TEST(!runs[0].cancelled);
+	BOOST_TEST(runs[1].cancelled);
+	BOOST_TEST((runs[1].result != CheckResult::UNSATISFIABLE));
+}
+
+BOOST_AUTO_TEST_CASE(conflicting_answers)
+{
+	// The barrier makes sure that both solvers finish, independently of scheduling.
+	Barrier barrier(2);
+	SMTPortfolio portfolio = makePortfolio(
+		std::make_unique<MockSolver>(CheckResult::SATISFIABLE, MockSolver::Behaviour::Answer, &barrier),
+		std::make_unique<MockSolver>(CheckResult::UNSATISFIABLE, MockSolver::Behaviour::Answer, &barrier)
+	);
+
+	BOOST_TEST((portfolio.check({}).first == CheckResult::CONFLICTING));
+}
+
+BOOST_AUTO_TEST_CASE(answer_is_preferred_over_unknown_and_errors)
+{
+	SMTPortfolio portfolio = makePortfolio(
+		std::make_unique<MockSolver>(CheckResult::UNKNOWN),
+		std::make_unique<MockSolver>(CheckResult::ERROR, MockSolver::Behaviour::Throw),
+		std::make_unique<MockSolver>(CheckResult::UNSATISFIABLE)
+	);
+
+	BOOST_TEST((portfolio.check({}).first == CheckResult::UNSATISFIABLE));
+}
+
+BOOST_AUTO_TEST_CASE(solver_error_without_answer)
+{
+	SMTPortfolio portfolio = makePortfolio(
+		std::make_unique<MockSolver>(CheckResult::UNKNOWN),
+		std::make_unique<MockSolver>(CheckResult::ERROR, MockSolver::Behaviour::Throw)
+	);
+
+	BOOST_CHECK_THROW(portfolio.check({}), SolverError);
+	BOOST_TEST(portfolio.queryStatistics().size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(unknown_is_preferred_over_error)
+{
+	SMTPortfolio portfolio = makePortfolio(
+		std::make_unique<MockSolver>(CheckResult::ERROR),
+		std::make_unique<MockSolver>(CheckResult::UNKNOWN)
+	);
+
+	BOOST_TEST((portfolio.check({}).first == CheckResult::UNKNOWN));
+	BOOST_TEST((portfolio.check({}).first == CheckResult::UNKNOWN));
+	BOOST_TEST(portfolio.queryStatistics().size() == 2);
+}
+
+#ifdef HAVE_Z3
+BOOST_AUTO_TEST_CASE(interrupting_an_idle_z3_solver)
+{
+	if (!Z3Interface::available())
+		return;
+	Z3Interface solver;
+	Expression x = solver.newVariable("x", SortProvider::sintSort);
+	solver.addAssertion(x > 0);
+	BOOST_TEST((solver.check({}).first == CheckResult::SATISFIABLE));
+
+	// Z3 leaves an idle context that is interrupted cancelled, so that the next push fails.
+	solver.interrupt();
+	BOOST_CHECK_NO_THROW(solver.push());
+	solver.addAssertion(x < 5);
+	BOOST_TEST((solver.check({x}).first == CheckResult::SATISFIABLE));
+	solver.pop();
+}
+
+BOOST_AUTO_TEST_CASE(z3_finishes_while_being_interrupted)
+{
+	if (!Z3Interface::available())
+		return;
+	// The mock solver answers about as fast as Z3, so that Z3 is interrupted while its check
+	// is running, just after it returned, or not at all, depending on scheduling.
+	for (size_t i = 0; i < 100; ++i)
+	{
+		std::vector<std::unique_ptr<SolverInterface>> solvers;
+		solvers.emplace_back(std::make_unique<MockSolver>(CheckResult::SATISFIABLE));
+		solvers.emplace_back(std::make_unique<Z3Interface>());
+		Z3Interface& z3 = dynamic_cast<Z3Interface&>(*solvers.back());
+		SMTPortfolio portfolio(std::move(solvers));
+		Expression x = portfolio.newVariable("x", SortProvider::sintSort);
+		portfolio.addAssertion(x > 0);
+		BOOST_TEST((portfolio.check({}).first == CheckResult::SATISFIABLE));
+
+		// Z3 has to answer later queries on its own.
+		BOOST_CHECK_NO_THROW(z3.push());
+		z3.addAssertion(x < 5);
+		BOOST_TEST((z3.check({}).first == CheckResult::SATISFIABLE));
+		z3.pop();
+	}
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(model_of_the_first_answering_solver_is_used)
+{
+	// Both solvers answer independently of scheduling, so the choice must not depend on which finishes first.
+	Barrier barrier(2);
+	SMTPortfolio portfolio = makePortfolio(
+		std::make_unique<MockSolver>(CheckResult::SATISFIABLE, MockSolver::Behaviour::Answer, &barrier, std::vector<std::string>{"1"}),
+		std::make_unique<MockSolver>(CheckResult::SATISFIABLE, MockSolver::Behaviour::Answer, &barrier, std::vector<std::string>{"2"})
+	);
+
+	auto const [result, values] = portfolio.check({Expression(size_t(0))});
+	BOOST_TEST((result == CheckResult::SATISFIABLE));
+	BOOST_TEST(values == std::vector<std::string>{"1"});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
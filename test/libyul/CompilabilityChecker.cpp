@@ -42,7 +42,7 @@ string check(string const& _input)
 	auto functions = CompilabilityChecker(QRVMDialect::strictAssemblyForQRVM(hyperion::test::CommonOptions::get().qrvmVersion()), obj, true).stackDeficit;
 	string out;
 	for (auto const& function: functions)
-		out += function.first.str() + ": " + to_string(function.second) + " ";
+		out += std::string(function.first.str()) + ": " + to_string(function.second) + " ";
 	return out;
 }
 }
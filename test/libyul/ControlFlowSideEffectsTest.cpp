@@ -69,7 +69,7 @@ TestCase::TestResult ControlFlowSideEffectsTest::run(ostream& _stream, string co
 	m_obtainedResult.clear();
 	forEach<FunctionDefinition const>(*obj.code, [&](FunctionDefinition const& _fun) {
 		string effectStr = toString(sideEffects.functionSideEffects().at(&_fun));
-		m_obtainedResult += _fun.name.str() + (effectStr.empty() ? ":" : ": " + effectStr) + "\n";
+		m_obtainedResult += std::string(_fun.name.str()) + (effectStr.empty() ? ":" : ": " + effectStr) + "\n";
 	});
 
 	return checkResult(_stream, _linePrefix, _formatted);
@@ -95,7 +95,7 @@ TestCase::TestResult FunctionSideEffects::run(ostream& _stream, string const& _l
 
 	std::map<std::string, std::string> functionSideEffectsStr;
 	for (auto const& fun: functionSideEffects)
-		functionSideEffectsStr[fun.first.str()] = toString(fun.second);
+		functionSideEffectsStr[std::string(fun.first.str())] = toString(fun.second);
 
 	m_obtainedResult.clear();
 	for (auto const& fun: functionSideEffectsStr)
@@ -0,0 +1,67 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <test/libyul/LinearRuleMatcher.h>
+
+#include <libyul/AST.h>
+
+#include <libqrvmasm/RuleList.h>
+
+using namespace hyperion;
+using namespace hyperion::langutil;
+using namespace hyperion::yul;
+using namespace hyperion::yul::test;
+
+LinearRuleMatcher::LinearRuleMatcher(QRVMVersion _qrvmVersion)
+{
+	Pattern A(PatternKind::Constant);
+	Pattern B(PatternKind::Constant);
+	Pattern C(PatternKind::Constant);
+	Pattern W;
+	Pattern X;
+	Pattern Y;
+	Pattern Z;
+	A.setMatchGroup(1, m_matchGroups);
+	B.setMatchGroup(2, m_matchGroups);
+	C.setMatchGroup(3, m_matchGroups);
+	W.setMatchGroup(4, m_matchGroups);
+	X.setMatchGroup(5, m_matchGroups);
+	Y.setMatchGroup(6, m_matchGroups);
+	Z.setMatchGroup(7, m_matchGroups);
+	for (auto const& rule: qrvmasm::simplificationRuleList(std::optional<QRVMVersion>{_qrvmVersion}, A, B, C, W, X, Y, Z))
+		m_rules[uint8_t(rule.pattern.instruction())].push_back(rule);
+}
+
+SimplificationRules::Rule const* LinearRuleMatcher::findFirstMatch(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	std::function<AssignedValue const*(YulString)> const& _ssaValues
+)
+{
+	auto instruction = SimplificationRules::instructionAndArguments(_dialect, _expr);
+	if (!instruction)
+		return nullptr;
+	for (auto const& rule: m_rules[uint8_t(instruction->first)])
+	{
+		m_matchGroups.fill(nullptr);
+		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
+			if (!rule.feasible || rule.feasible())
+				return &rule;
+	}
+	return nullptr;
+}
@@ -0,0 +1,55 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Reference implementation of the selection of simplification rules.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/SimplificationRules.h>
+
+#include <liblangutil/QRVMVersion.h>
+
+#include <functional>
+#include <vector>
+
+namespace hyperion::yul::test
+{
+
+/**
+ * Rule matching as done before the decision tree: all rules of the expression's
+ * instruction are tried in order. Used to check and benchmark the decision tree
+ * of SimplificationRules.
+ */
+class LinearRuleMatcher
+{
+public:
+	explicit LinearRuleMatcher(langutil::QRVMVersion _qrvmVersion);
+
+	SimplificationRules::Rule const* findFirstMatch(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::function<AssignedValue const*(YulString)> const& _ssaValues
+	);
+
+private:
+	qrvmasm::MatchGroups<Expression> m_matchGroups{};
+	std::vector<SimplificationRules::Rule> m_rules[256];
+};
+
+}
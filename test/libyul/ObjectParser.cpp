@@ -26,11 +26,14 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/Scanner.h>
 
+#include <libyul/AST.h>
 #include <libyul/YulStack.h>
 #include <libyul/backends/qrvm/QRVMDialect.h>
 
 #include <libhyperion/interface/OptimiserSettings.h>
 
+#include <libhyputil/JSON.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -189,6 +192,53 @@ BOOST_AUTO_TEST_CASE(to_string)
 	BOOST_CHECK_EQUAL(asmStack.print(), expectation);
 }
 
+BOOST_AUTO_TEST_CASE(optimize_reuses_optimized_sub_objects)
+{
+	string subObject = R"(
+		object "C" {
+			code { let x := add(1, 2) sstore(0, x) datacopy(0, dataoffset("C_deployed"), datasize("C_deployed")) }
+			object "C_deployed" { code { sstore(1, mul(calldataload(0), 3)) } }
+		}
+	)";
+	// The creator contains the sub-object with different indentation, so that the native
+	// locations of the reused object have to be translated.
+	string code = "object \"O\" {\n\tcode { sstore(2, datasize(\"C\")) }\n" + boost::replace_all_copy(subObject, "\t", "  ") + "}\n";
+	auto makeStack = []() {
+		return make_shared<YulStack>(
+			hyperion::test::CommonOptions::get().qrvmVersion(),
+			YulStack::Language::StrictAssembly,
+			hyperion::frontend::OptimiserSettings::full(),
+			DebugInfoSelection::All()
+		);
+	};
+
+	auto subObjectStack = makeStack();
+	BOOST_REQUIRE(subObjectStack->parseAndAnalyze("C", subObject));
+	subObjectStack->optimize();
+
+	auto expectedStack = makeStack();
+	BOOST_REQUIRE(expectedStack->parseAndAnalyze("O", code));
+	expectedStack->optimize();
+
+	auto reusingStack = makeStack();
+	BOOST_REQUIRE(reusingStack->parseAndAnalyze("O", code));
+	reusingStack->optimize({{"C", subObjectStack}});
+
+	BOOST_CHECK_EQUAL(reusingStack->print(), expectedStack->print());
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(reusingStack->astJson()), util::jsonCompactPrint(expectedStack->astJson()));
+	auto const* reusedObject = dynamic_cast<Object const*>(reusingStack->parserResult()->subObjects.at(0).get());
+	BOOST_REQUIRE(reusedObject);
+	BOOST_CHECK(reusedObject->code != subObjectStack->parserResult()->code);
+	BOOST_CHECK(reusedObject->analysisInfo != subObjectStack->parserResult()->analysisInfo);
+	// The optimized sub-object itself is left unchanged.
+	BOOST_CHECK(nativeLocationOf(*subObjectStack->parserResult()->code) != nativeLocationOf(*reusedObject->code));
+
+	MachineAssemblyObject reusingAssembly = reusingStack->assemble(YulStack::Machine::QRVM);
+	MachineAssemblyObject expectedAssembly = expectedStack->assemble(YulStack::Machine::QRVM);
+	BOOST_REQUIRE(reusingAssembly.sourceMappings && expectedAssembly.sourceMappings);
+	BOOST_CHECK_EQUAL(*reusingAssembly.sourceMappings, *expectedAssembly.sourceMappings);
+}
+
 BOOST_AUTO_TEST_CASE(use_src_empty)
 {
 	auto const [mapping, _] = tryGetSourceLocationMapping("");
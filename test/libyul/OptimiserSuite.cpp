@@ -0,0 +1,191 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the Yul optimiser suite.
+ */
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/backends/qrvm/QRVMDialect.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmParser.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <libhyperion/interface/OptimiserSettings.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
+
+#include <libhyputil/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hyperion;
+using namespace hyperion::langutil;
+using namespace hyperion::yul;
+
+namespace
+{
+
+Dialect const& testDialect()
+{
+	return QRVMDialect::strictAssemblyForQRVMObjects(QRVMVersion{});
+}
+
+map<unsigned, shared_ptr<string const>> sourceNames()
+{
+	return {
+		{0, make_shared<string const>("source0")},
+		{1, make_shared<string const>("source1")}
+	};
+}
+
+shared_ptr<Block> parseAndAnalyze(string const& _source, AsmAnalysisInfo& _analysisInfo)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream stream(_source, "");
+	shared_ptr<Block> ast = yul::Parser(errorReporter, testDialect(), sourceNames()).parse(stream);
+	BOOST_REQUIRE(ast && errors.empty());
+	BOOST_REQUIRE(AsmAnalyzer(_analysisInfo, errorReporter, testDialect()).analyze(*ast));
+	return ast;
+}
+
+/// Runs the given sequences on @a _source the way the compiler does and
+/// @returns the resulting code including all debug data.
+string optimise(string const& _source, vector<string> const& _sequences, OptimiserSuite::Debug _debug)
+{
+	AsmAnalysisInfo analysisInfo;
+	shared_ptr<Block> parsed = parseAndAnalyze(_source, analysisInfo);
+	set<YulString> reservedIdentifiers = testDialect().fixedFunctionNames();
+	Block ast = get<Block>(Disambiguator(testDialect(), analysisInfo, reservedIdentifiers)(*parsed));
+	NameDispenser dispenser{testDialect(), ast, reservedIdentifiers};
+	OptimiserStepContext context{testDialect(), dispenser, reservedIdentifiers, 200};
+
+	// Only used to list the steps in debug mode.
+	ostringstream printedSteps;
+	streambuf* coutBuffer = cout.rdbuf(printedSteps.rdbuf());
+	ScopeGuard restoreCout([&]() { cout.rdbuf(coutBuffer); });
+
+	OptimiserSuite suite{context, _debug};
+	suite.runSequence("hgfo", ast);
+	for (string const& sequence: _sequences)
+		suite.runSequence(sequence, ast);
+	return AsmPrinter{testDialect(), sourceNames(), DebugInfoSelection::All()}(ast);
+}
+
+vector<string> const testSources{
+	"{ sstore(0, add(calldataload(0), 1)) }",
+	"/// @src 0:0:100\n"
+	"{\n"
+	"	/// @src 0:10:20\n"
+	"	function f(a, b) -> r {\n"
+	"		/// @src 0:20:30\n"
+	"		for { let i := 0 } lt(i, b) { i := add(i, 1) } {\n"
+	"			r := add(r, mload(add(a, mul(i, 0x20))))\n"
+	"		}\n"
+	"	}\n"
+	"	/// @src 1:5:10\n"
+	"	function g(x) -> y {\n"
+	"		y := f(x, 3)\n"
+	"		if gt(y, 10) { y := sub(y, 10) }\n"
+	"	}\n"
+	"	let x := calldataload(0)\n"
+	"	/// @src 0:40:50\n"
+	"	switch g(x)\n"
+	"	case 0 { sstore(0, f(x, 0)) }\n"
+	"	default { sstore(1, g(add(x, 1))) }\n"
+	"	mstore(0x40, g(x))\n"
+	"}\n",
+	"/// @src 1:0:50\n"
+	"{\n"
+	"	function h(a) -> b { b := a if iszero(a) { leave } b := h(sub(a, 1)) }\n"
+	"	let s := 0\n"
+	"	for { let i := 0 } 1 { i := add(i, 1) } {\n"
+	"		if gt(i, calldataload(0)) { break }\n"
+	"		/// @src 1:20:30\n"
+	"		if eq(i, 7) { continue }\n"
+	"		s := add(s, h(i))\n"
+	"	}\n"
+	"	sstore(s, s)\n"
+	"}\n"
+};
+
+}
+
+namespace hyperion::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(stopping_after_unchanged_round_preserves_output)
+{
+	// Debug mode repeats rounds until the code size is stable, so it provides the reference output.
+	vector<vector<string>> const sequences{
+		{frontend::OptimiserSettings::DefaultYulOptimiserSteps, frontend::OptimiserSettings::DefaultYulOptimiserCleanupSteps},
+		{"xarrscLM cCTUtTOntnfDIul xarrscLM cCTUtTOntnfDIul", "[xarrscLM]", "fDnTOcmu fDnTOcmu"}
+	};
+	for (string const& source: testSources)
+		for (vector<string> const& sequence: sequences)
+			BOOST_CHECK_EQUAL(
+				optimise(source, sequence, OptimiserSuite::Debug::None),
+				optimise(source, sequence, OptimiserSuite::Debug::PrintStep)
+			);
+}
+
+BOOST_AUTO_TEST_CASE(exactly_equal)
+{
+	AsmAnalysisInfo analysisInfo;
+	shared_ptr<Block> ast = parseAndAnalyze(testSources.at(1), analysisInfo);
+	Block copy = get<Block>(ASTCopier{}(*ast));
+	BOOST_CHECK(ExactlyEqual{}.statementEqual(*ast, copy));
+
+	// Equal but separately created debug data counts as a change.
+	AsmAnalysisInfo otherAnalysisInfo;
+	shared_ptr<Block> reparsed = parseAndAnalyze(testSources.at(1), otherAnalysisInfo);
+	BOOST_CHECK(!ExactlyEqual{}.statementEqual(*ast, *reparsed));
+	BOOST_CHECK(SyntacticallyEqual{}.statementEqual(*ast, *reparsed));
+
+	// The spelling of literals matters.
+	AsmAnalysisInfo spellingAnalysisInfo;
+	shared_ptr<Block> hex = parseAndAnalyze("{ sstore(0, 0x20) }", spellingAnalysisInfo);
+	Block decimal = get<Block>(ASTCopier{}(*hex));
+	FunctionCall& call = get<FunctionCall>(get<ExpressionStatement>(decimal.statements.at(0)).expression);
+	get<Literal>(call.arguments.at(1)).value = "32"_yulstring;
+	BOOST_CHECK(!ExactlyEqual{}.statementEqual(*hex, decimal));
+	BOOST_CHECK(SyntacticallyEqual{}.statementEqual(*hex, decimal));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -951,6 +951,91 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(shared_debug_data)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	auto const sourceText = "{ let x := add(1, 2) mstore(x, 3) }";
+	SourceLocation const locationOverride{10, 20, make_shared<string const>("source0")};
+	auto stream = CharStream(sourceText, "");
+	shared_ptr<Block> result = yul::Parser(
+		reporter,
+		QRVMDialect::strictAssemblyForQRVM(QRVMVersion{}),
+		locationOverride
+	).parse(stream);
+	BOOST_REQUIRE(!!result && errorList.size() == 0);
+	BOOST_REQUIRE_EQUAL(result->statements.size(), 2);
+
+	// All nodes have the same location and thus share their debug data.
+	VariableDeclaration const& varX = get<VariableDeclaration>(result->statements.at(0));
+	FunctionCall const& mstoreCall = get<FunctionCall>(get<ExpressionStatement>(result->statements.at(1)).expression);
+	BOOST_CHECK(result->debugData == varX.debugData);
+	BOOST_CHECK(varX.debugData == debugDataOf(*varX.value));
+	BOOST_CHECK(varX.debugData == mstoreCall.debugData);
+	BOOST_CHECK(varX.debugData == debugDataOf(mstoreCall.arguments.at(1)));
+	CHECK_LOCATION(varX.debugData->nativeLocation, "source0", 10, 20);
+	CHECK_LOCATION(varX.debugData->originLocation, "source0", 10, 20);
+
+	// The shared object belongs to the parser.
+	auto otherStream = CharStream(sourceText, "");
+	shared_ptr<Block> otherResult = yul::Parser(
+		reporter,
+		QRVMDialect::strictAssemblyForQRVM(QRVMVersion{}),
+		locationOverride
+	).parse(otherStream);
+	BOOST_REQUIRE(!!otherResult && errorList.size() == 0);
+	BOOST_CHECK(otherResult->debugData != result->debugData);
+	CHECK_LOCATION(otherResult->debugData->nativeLocation, "source0", 10, 20);
+
+	BOOST_CHECK(DebugData::create() == DebugData::create());
+	BOOST_CHECK(DebugData::create() != DebugData::create(locationOverride));
+}
+
+BOOST_AUTO_TEST_CASE(debug_data_not_shared_without_location_override)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	auto const sourceText = "{ let x := add(1, 2) mstore(x, 3) }";
+	auto stream = CharStream(sourceText, "source0");
+	shared_ptr<Block> result = yul::Parser(
+		reporter,
+		QRVMDialect::strictAssemblyForQRVM(QRVMVersion{})
+	).parse(stream);
+	BOOST_REQUIRE(!!result && errorList.size() == 0);
+	BOOST_REQUIRE_EQUAL(result->statements.size(), 2);
+
+	// Every node has its own location taken from the scanner.
+	VariableDeclaration const& varX = get<VariableDeclaration>(result->statements.at(0));
+	FunctionCall const& addCall = get<FunctionCall>(*varX.value);
+	FunctionCall const& mstoreCall = get<FunctionCall>(get<ExpressionStatement>(result->statements.at(1)).expression);
+	BOOST_CHECK(varX.debugData != addCall.debugData);
+	BOOST_CHECK(varX.debugData != mstoreCall.debugData);
+	CHECK_LOCATION(result->debugData->nativeLocation, "source0", 0, 35);
+	CHECK_LOCATION(varX.debugData->nativeLocation, "source0", 2, 20);
+	CHECK_LOCATION(varX.debugData->originLocation, "source0", 2, 20);
+	CHECK_LOCATION(addCall.debugData->nativeLocation, "source0", 11, 20);
+	CHECK_LOCATION(debugDataOf(addCall.arguments.at(0))->nativeLocation, "source0", 15, 16);
+	CHECK_LOCATION(mstoreCall.debugData->nativeLocation, "source0", 21, 33);
+
+	// With locations from comments, nodes only share the origin location.
+	ErrorList commentErrorList;
+	ErrorReporter commentReporter(commentErrorList);
+	shared_ptr<Block> commentResult = parse(
+		"/// @src 0:10:20\n"
+		"{ let x := add(1, 2) }\n",
+		QRVMDialect::strictAssemblyForQRVM(QRVMVersion{}),
+		commentReporter
+	);
+	BOOST_REQUIRE(!!commentResult && commentErrorList.size() == 0);
+	BOOST_REQUIRE_EQUAL(commentResult->statements.size(), 1);
+	VariableDeclaration const& commentVarX = get<VariableDeclaration>(commentResult->statements.at(0));
+	BOOST_CHECK(commentVarX.debugData != debugDataOf(*commentVarX.value));
+	CHECK_LOCATION(commentVarX.debugData->originLocation, "source0", 10, 20);
+	CHECK_LOCATION(debugDataOf(*commentVarX.value)->originLocation, "source0", 10, 20);
+	CHECK_LOCATION(commentVarX.debugData->nativeLocation, "", 19, 37);
+	CHECK_LOCATION(debugDataOf(*commentVarX.value)->nativeLocation, "", 28, 37);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,188 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the selection of simplification rules through the decision tree.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/libyul/LinearRuleMatcher.h>
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/backends/qrvm/QRVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hyperion;
+using namespace hyperion::langutil;
+using namespace hyperion::yul;
+
+namespace hyperion::yul::test
+{
+
+namespace
+{
+
+/// Matches the rules against every expression, once through the decision tree and once
+/// through the linear scan, and records the expressions for which the selected rules differ.
+class RuleComparison: public DataFlowAnalyzer
+{
+public:
+	RuleComparison(Dialect const& _dialect, QRVMVersion _qrvmVersion, LinearRuleMatcher& _linearMatcher):
+		DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore),
+		m_qrvmVersion(_qrvmVersion),
+		m_linearMatcher(_linearMatcher)
+	{}
+
+	using ASTModifier::operator();
+
+	void visit(Expression& _expression) override
+	{
+		DataFlowAnalyzer::visit(_expression);
+
+		auto ssaValues = [this](YulString _var) { return variableValue(_var); };
+		string treeResult = replacement(SimplificationRules::findFirstMatch(_expression, m_dialect, ssaValues));
+		string linearResult = replacement(m_linearMatcher.findFirstMatch(_expression, m_dialect, ssaValues));
+		if (treeResult != linearResult)
+			mismatches.emplace_back(std::visit(AsmPrinter{}, _expression) + ": " + treeResult + " vs. " + linearResult);
+		if (!treeResult.empty())
+			++matches;
+		++expressions;
+	}
+
+	size_t expressions = 0;
+	size_t matches = 0;
+	vector<string> mismatches;
+
+private:
+	string replacement(SimplificationRules::Rule const* _rule) const
+	{
+		if (!_rule)
+			return {};
+		return std::visit(AsmPrinter{}, _rule->action().toExpression({}, m_qrvmVersion));
+	}
+
+	QRVMVersion m_qrvmVersion;
+	LinearRuleMatcher& m_linearMatcher;
+};
+
+/// Generates random code in SSA form from the operations and constants that occur in the rules.
+class RandomCode
+{
+public:
+	explicit RandomCode(unsigned _seed): m_random(_seed) {}
+
+	/// @returns a block of @a _variables declarations with values nested up to @a _depth calls deep.
+	string block(size_t _variables, size_t _depth)
+	{
+		string code = "{\n";
+		for (size_t i = 0; i < _variables; ++i)
+			code += "let v" + to_string(i) + " := " + expression(i, _depth) + "\n";
+		return code + "}\n";
+	}
+
+private:
+	string expression(size_t _variables, size_t _depth)
+	{
+		size_t const choice = pick(_depth == 0 ? 3 : 8);
+		if (choice == 0 || (choice == 1 && _variables == 0))
+			return constant();
+		else if (choice == 1)
+			return "v" + to_string(pick(_variables));
+		else if (choice == 2)
+			return pick(2) ? "calldataload(" + constant() + ")" : "address()";
+
+		auto const& [name, arity] = m_operations[pick(m_operations.size())];
+		string call = name + "(";
+		for (size_t i = 0; i < arity; ++i)
+			call += (i > 0 ? ", " : "") + expression(_variables, _depth - 1);
+		return call + ")";
+	}
+
+	string constant()
+	{
+		if (pick(4) == 0)
+			return to_string(pick(300));
+		return m_constants[pick(m_constants.size())];
+	}
+
+	size_t pick(size_t _count) { return uniform_int_distribution<size_t>(0, _count - 1)(m_random); }
+
+	mt19937 m_random;
+	vector<pair<string, size_t>> const m_operations{
+		{"add", 2}, {"sub", 2}, {"mul", 2}, {"div", 2}, {"sdiv", 2}, {"mod", 2}, {"smod", 2},
+		{"exp", 2}, {"not", 1}, {"lt", 2}, {"gt", 2}, {"slt", 2}, {"sgt", 2}, {"eq", 2},
+		{"iszero", 1}, {"and", 2}, {"or", 2}, {"xor", 2}, {"byte", 2}, {"shl", 2}, {"shr", 2},
+		{"sar", 2}, {"addmod", 3}, {"mulmod", 3}, {"signextend", 2}, {"balance", 1}
+	};
+	vector<string> const m_constants{
+		"0", "1", "2", "8", "31", "32", "255", "256",
+		"0xff",
+		"0xffffffffffffffffffffffffffffffffffffffff",
+		"0x8000000000000000000000000000000000000000000000000000000000000000",
+		"0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+		"0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe"
+	};
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulSimplificationRules)
+
+BOOST_AUTO_TEST_CASE(decision_tree_selects_same_rules_as_linear_scan)
+{
+	QRVMVersion const qrvmVersion;
+	Dialect const& dialect = QRVMDialect::strictAssemblyForQRVMObjects(qrvmVersion);
+	LinearRuleMatcher linearMatcher(qrvmVersion);
+	RandomCode randomCode(0x5eed);
+
+	size_t expressions = 0;
+	size_t matches = 0;
+	for (size_t i = 0; i < 200; ++i)
+	{
+		// Depth one corresponds to the code produced by the ExpressionSplitter.
+		string const source = randomCode.block(20, 1 + i % 3);
+		langutil::ErrorList errors;
+		auto [object, analysisInfo] = parse(source, dialect, errors);
+		BOOST_REQUIRE_MESSAGE(object && errors.empty(), "Invalid generated code:\n" + source);
+
+		RuleComparison comparison(dialect, qrvmVersion, linearMatcher);
+		comparison(*object->code);
+		for (string const& mismatch: comparison.mismatches)
+			BOOST_ERROR("Different rules selected for " + mismatch);
+		expressions += comparison.expressions;
+		matches += comparison.matches;
+	}
+
+	// Make sure that the generated code actually exercises the rules.
+	BOOST_TEST_MESSAGE(to_string(matches) + " of " + to_string(expressions) + " expressions matched a rule.");
+	BOOST_CHECK(matches > expressions / 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -58,7 +58,7 @@ namespace
 {
 static std::string variableSlotToString(VariableSlot const& _slot)
 {
-	return _slot.variable.get().name.str();
+	return std::string(_slot.variable.get().name.str());
 }
 }
 
@@ -0,0 +1,124 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hyperion::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a("abc");
+	YulString b(std::string("ab") + "c");
+	BOOST_CHECK(a == b);
+	BOOST_TEST(a.str() == "abc");
+	BOOST_TEST(a.str().data() == b.str().data());
+	BOOST_CHECK(a != YulString("abd"));
+	BOOST_TEST(YulString().empty());
+	BOOST_CHECK(YulString("") == YulString());
+	BOOST_TEST(!a.empty());
+}
+
+BOOST_AUTO_TEST_CASE(arena_storage)
+{
+	// Long strings, including one larger than an arena chunk, keep their contents and addresses
+	// while further strings are added.
+	std::vector<std::string> strings{std::string(200000, 'x')};
+	for (size_t i = 0; i < 5000; ++i)
+		strings.emplace_back("a_name_that_does_not_fit_the_small_string_buffer_" + std::to_string(i));
+	size_t const capacity = YulStringRepository::instance().arenaCapacity();
+	std::vector<YulString> names;
+	std::vector<char const*> addresses;
+	for (std::string const& string: strings)
+	{
+		names.emplace_back(string);
+		addresses.emplace_back(names.back().str().data());
+	}
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_REQUIRE(names[i].str() == strings[i]);
+		BOOST_REQUIRE(names[i].str().data() == addresses[i]);
+		BOOST_REQUIRE(YulString(strings[i]) == names[i]);
+	}
+
+	// The small strings are packed into shared chunks instead of being allocated one by one.
+	size_t totalLength = 0;
+	for (std::string const& string: strings)
+		totalLength += sizeof(size_t) + string.size() + alignof(size_t);
+	BOOST_TEST(YulStringRepository::instance().arenaCapacity() - capacity <= totalLength + 16 * 64 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t constexpr threadCount = 4;
+	size_t constexpr nameCount = 2000;
+	std::vector<std::vector<YulString>> names(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		threads.emplace_back([&, thread]() {
+			// Every thread interns the same names, but in a different order.
+			for (size_t i = 0; i < nameCount; ++i)
+				names[thread].emplace_back("name_" + std::to_string((i * (thread + 1)) % nameCount));
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		for (size_t i = 0; i < nameCount; ++i)
+		{
+			YulString const& name = names[thread][i];
+			BOOST_REQUIRE(name.str() == "name_" + std::to_string((i * (thread + 1)) % nameCount));
+			BOOST_REQUIRE(name == YulString(name.str()));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_reset_callback_registration)
+{
+	// The callbacks stay registered for the rest of the test run, so they only touch a static counter.
+	static std::atomic<size_t> calls{0};
+	size_t constexpr threadCount = 4;
+	size_t constexpr callbacksPerThread = 100;
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+		threads.emplace_back([]() {
+			for (size_t i = 0; i < callbacksPerThread; ++i)
+				YulStringRepository::ResetCallback{[] { ++calls; }};
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	calls = 0;
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(calls.load(), threadCount * callbacksPerThread);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,292 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for matching the simplification rules against Yul expressions.
+ * Compares the decision tree used by the ExpressionSimplifier against trying every
+ * rule of the expression's instruction in order, on the IR of the given contracts.
+ */
+
+#include <test/libyul/LinearRuleMatcher.h>
+
+#include <libhyperion/interface/CompilerStack.h>
+
+#include <libyul/AST.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+#include <libyul/backends/qrvm/QRVMDialect.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/SSATransform.h>
+#include <libyul/optimiser/SimplificationRules.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libhyputil/CommonIO.h>
+#include <libhyputil/Exceptions.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hyperion;
+using namespace hyperion::langutil;
+using namespace hyperion::yul;
+using namespace hyperion::yul::test;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+enum class Mode { Traverse, DecisionTree, Linear, Compare };
+
+/// Visits all expressions like the ExpressionSimplifier does and matches the rules against them,
+/// without modifying the code.
+class RuleMatcher: public DataFlowAnalyzer
+{
+public:
+	RuleMatcher(Dialect const& _dialect, QRVMVersion _qrvmVersion, LinearRuleMatcher& _linearMatcher, Mode _mode):
+		DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore),
+		m_qrvmVersion(_qrvmVersion),
+		m_linearMatcher(_linearMatcher),
+		m_mode(_mode)
+	{}
+
+	using ASTModifier::operator();
+
+	void visit(Expression& _expression) override
+	{
+		DataFlowAnalyzer::visit(_expression);
+
+		auto ssaValues = [this](YulString _var) { return variableValue(_var); };
+		switch (m_mode)
+		{
+		case Mode::Traverse:
+			break;
+		case Mode::DecisionTree:
+			if (SimplificationRules::findFirstMatch(_expression, m_dialect, ssaValues))
+				++m_matches;
+			break;
+		case Mode::Linear:
+			if (m_linearMatcher.findFirstMatch(_expression, m_dialect, ssaValues))
+				++m_matches;
+			break;
+		case Mode::Compare:
+		{
+			string treeResult = replacement(SimplificationRules::findFirstMatch(_expression, m_dialect, ssaValues));
+			string linearResult = replacement(m_linearMatcher.findFirstMatch(_expression, m_dialect, ssaValues));
+			if (treeResult != linearResult)
+			{
+				cerr << "Mismatch for " << std::visit(AsmPrinter{}, _expression) << ": " << treeResult << " vs. " << linearResult << endl;
+				++m_mismatches;
+			}
+			if (!treeResult.empty())
+				++m_matches;
+			break;
+		}
+		}
+		++m_expressions;
+	}
+
+	size_t expressions() const { return m_expressions; }
+	size_t matches() const { return m_matches; }
+	size_t mismatches() const { return m_mismatches; }
+
+private:
+	string replacement(SimplificationRules::Rule const* _rule) const
+	{
+		if (!_rule)
+			return {};
+		return std::visit(AsmPrinter{}, _rule->action().toExpression({}, m_qrvmVersion));
+	}
+
+	QRVMVersion m_qrvmVersion;
+	LinearRuleMatcher& m_linearMatcher;
+	Mode m_mode;
+	size_t m_expressions = 0;
+	size_t m_matches = 0;
+	size_t m_mismatches = 0;
+};
+
+/// Brings the code of all Yul objects in @a _ir into the shape the ExpressionSimplifier usually sees.
+void prepareCode(string const& _name, string const& _ir, QRVMVersion _qrvmVersion, vector<shared_ptr<Block>>& _code)
+{
+	YulStack stack(_qrvmVersion, YulStack::Language::StrictAssembly, frontend::OptimiserSettings::none(), DebugInfoSelection::None());
+	if (!stack.parseAndAnalyze(_name, _ir))
+	{
+		SourceReferenceFormatter{cerr, stack, true, false}.printErrorInformation(stack.errors());
+		BOOST_THROW_EXCEPTION(util::Exception() << util::errinfo_comment("Could not parse the IR of " + _name + "."));
+	}
+
+	QRVMDialect const& dialect = QRVMDialect::strictAssemblyForQRVMObjects(_qrvmVersion);
+	vector<Object const*> objects{stack.parserResult().get()};
+	while (!objects.empty())
+	{
+		Object const& object = *objects.back();
+		objects.pop_back();
+		for (auto const& subNode: object.subObjects)
+			if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+				objects.push_back(subObject);
+
+		set<YulString> reservedIdentifiers;
+		auto block = make_shared<Block>(get<Block>(Disambiguator(dialect, *object.analysisInfo)(*object.code)));
+		NameDispenser dispenser(dialect, *block, reservedIdentifiers);
+		OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, frontend::OptimiserSettings{}.expectedExecutionsPerDeployment};
+		ForLoopInitRewriter::run(context, *block);
+		ExpressionSplitter::run(context, *block);
+		SSATransform::run(context, *block);
+		_code.emplace_back(std::move(block));
+	}
+}
+
+/// Loads the code of a Yul file or of all contracts of a source file, compiled to unoptimized IR.
+vector<shared_ptr<Block>> loadCode(string const& _path, QRVMVersion _qrvmVersion)
+{
+	vector<shared_ptr<Block>> code;
+	if (boost::ends_with(_path, ".yul"))
+	{
+		prepareCode(_path, util::readFileAsString(_path), _qrvmVersion, code);
+		return code;
+	}
+
+	frontend::CompilerStack compiler;
+	compiler.setSources({{_path, util::readFileAsString(_path)}});
+	compiler.setQRVMVersion(_qrvmVersion);
+	compiler.setViaIR(true);
+	if (!compiler.compile())
+	{
+		SourceReferenceFormatter{cerr, compiler, true, false}.printErrorInformation(compiler.errors());
+		BOOST_THROW_EXCEPTION(util::Exception() << util::errinfo_comment("Compilation of " + _path + " failed."));
+	}
+	// Interfaces and abstract contracts do not have any IR.
+	for (string const& contract: compiler.contractNames())
+		if (!compiler.yulIR(contract).empty())
+			prepareCode(contract, compiler.yulIR(contract), _qrvmVersion, code);
+	return code;
+}
+
+double measure(vector<shared_ptr<Block>> const& _code, QRVMVersion _qrvmVersion, LinearRuleMatcher& _linearMatcher, Mode _mode, size_t _repetitions)
+{
+	Dialect const& dialect = QRVMDialect::strictAssemblyForQRVMObjects(_qrvmVersion);
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < _repetitions; ++i)
+		for (shared_ptr<Block> const& block: _code)
+			RuleMatcher(dialect, _qrvmVersion, _linearMatcher, _mode)(*block);
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(rulebench, benchmark for matching the Yul simplification rules.
+Usage: rulebench [Options] <file>...
+Compiles the given contracts to IR, or reads Yul objects from files ending in .yul,
+and matches the simplification rules against all expressions, once using the decision
+tree and once trying all rules in order. Run it on test/benchmarks/*.hyp.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<size_t>()->default_value(20), "Number of times all expressions are matched.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	QRVMVersion qrvmVersion;
+	size_t repetitions = arguments["repetitions"].as<size_t>();
+	LinearRuleMatcher linearMatcher(qrvmVersion);
+	bool mismatch = false;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		vector<shared_ptr<Block>> code;
+		try
+		{
+			code = loadCode(path, qrvmVersion);
+		}
+		catch (util::Exception const& _exception)
+		{
+			cerr << boost::diagnostic_information(_exception) << endl;
+			return 1;
+		}
+
+		Dialect const& dialect = QRVMDialect::strictAssemblyForQRVMObjects(qrvmVersion);
+		size_t expressions = 0;
+		size_t matches = 0;
+		for (shared_ptr<Block> const& block: code)
+		{
+			RuleMatcher matcher(dialect, qrvmVersion, linearMatcher, Mode::Compare);
+			matcher(*block);
+			expressions += matcher.expressions();
+			matches += matcher.matches();
+			mismatch = mismatch || matcher.mismatches() > 0;
+		}
+
+		double traversal = measure(code, qrvmVersion, linearMatcher, Mode::Traverse, repetitions);
+		double tree = measure(code, qrvmVersion, linearMatcher, Mode::DecisionTree, repetitions) - traversal;
+		double linear = measure(code, qrvmVersion, linearMatcher, Mode::Linear, repetitions) - traversal;
+
+		cout << "=======================================================" << endl;
+		cout << "            " << path << endl;
+		cout << "-------------------------------------------------------" << endl;
+		cout << expressions << " expressions, " << matches << " matches, " << repetitions << " repetitions." << endl;
+		cout << fixed << setprecision(1);
+		cout << "decision tree: " << tree << " ms" << endl;
+		cout << "linear scan:   " << linear << " ms" << endl;
+		if (tree > 0)
+			cout << "speedup:       " << setprecision(2) << linear / tree << "x" << endl;
+		cout << "=======================================================" << endl;
+	}
+
+	return mismatch ? 2 : 0;
+}
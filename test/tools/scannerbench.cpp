@@ -0,0 +1,138 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Throughput benchmark for the scanner. Tokenizes the given files repeatedly and
+ * reports the number of megabytes of source scanned per second.
+ */
+
+#include <liblangutil/CharacterRuns.h>
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libhyputil/CommonIO.h>
+#include <libhyputil/Exceptions.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hyperion;
+using namespace hyperion::langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Scans @a _stream to the end.
+/// @returns the number of tokens.
+size_t scanAll(CharStream& _stream, ScannerKind _kind)
+{
+	_stream.reset();
+	Scanner scanner(_stream);
+	if (_kind != ScannerKind::Hyperion)
+		scanner.setScannerMode(_kind);
+	size_t tokens = 0;
+	for (; scanner.currentToken() != Token::EOS; scanner.next())
+		++tokens;
+	return tokens;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, throughput benchmark for the scanner.
+Usage: scannerbench [Options] <file>...
+Tokenizes each file repeatedly and prints the throughput in MB/s. Files ending in .yul
+are scanned in Yul mode. Run it on test/benchmarks/*.hyp.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repetitions", po::value<size_t>()->default_value(200), "Number of times each file is scanned.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	size_t repetitions = arguments["repetitions"].as<size_t>();
+	cout << "Character runs are searched using " << characterRunInstructionSet() << "." << endl;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		string source;
+		try
+		{
+			source = util::readFileAsString(path);
+		}
+		catch (util::Exception const& _exception)
+		{
+			cerr << boost::diagnostic_information(_exception) << endl;
+			return 1;
+		}
+
+		CharStream stream(source, path);
+		ScannerKind kind = boost::ends_with(path, ".yul") ? ScannerKind::Yul : ScannerKind::Hyperion;
+		size_t tokens = scanAll(stream, kind);
+
+		auto start = chrono::steady_clock::now();
+		for (size_t i = 0; i < repetitions; ++i)
+			scanAll(stream, kind);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		double megabytes = static_cast<double>(source.size() * repetitions) / 1e6;
+
+		cout << "=======================================================" << endl;
+		cout << "            " << path << endl;
+		cout << "-------------------------------------------------------" << endl;
+		cout << source.size() << " bytes, " << tokens << " tokens, " << repetitions << " repetitions." << endl;
+		cout << fixed << setprecision(1);
+		cout << "time:       " << seconds * 1000 << " ms" << endl;
+		if (seconds > 0)
+			cout << "throughput: " << megabytes / seconds << " MB/s" << endl;
+		cout << "=======================================================" << endl;
+	}
+
+	return 0;
+}
@@ -54,8 +54,73 @@ void InspectedInterpreter::run(
 	bool _disableMemoryTrace
 )
 {
-	Scope scope;
-	InspectedInterpreter{_inspector, _state, _dialect, scope, _disableExternalCalls, _disableMemoryTrace}(_ast);
+	Resolution resolution(_dialect, _ast);
+	InspectedInterpreter{
+		_inspector,
+		_state,
+		_dialect,
+		resolution,
+		resolution.topLevelFrame(),
+		_disableExternalCalls,
+		_disableMemoryTrace
+	}(_ast);
+}
+
+InspectedInterpreter::InspectedInterpreter(
+	std::shared_ptr<Inspector> _inspector,
+	InterpreterState& _state,
+	Dialect const& _dialect,
+	Resolution const& _resolution,
+	Resolution::Frame const& _frame,
+	bool _disableExternalCalls,
+	bool _disableMemoryTracing,
+	std::vector<u256> _variables
+):
+	Interpreter(_state, _dialect, _resolution, _frame, _disableExternalCalls, _disableMemoryTracing, std::move(_variables)),
+	m_inspector(_inspector),
+	m_inScope(_frame.variableNames.size(), false)
+{
+	// Parameters and return variables are in scope for the whole function.
+	if (_frame.function)
+		fill_n(
+			m_inScope.begin(),
+			_frame.function->parameters.size() + _frame.function->returnVariables.size(),
+			true
+		);
+}
+
+void InspectedInterpreter::operator()(VariableDeclaration const& _node)
+{
+	helper(_node);
+	size_t slot = m_resolution.slot(_node);
+	fill_n(m_inScope.begin() + static_cast<ptrdiff_t>(slot), _node.variables.size(), true);
+}
+
+void InspectedInterpreter::operator()(ForLoop const& _node)
+{
+	helper(_node);
+	leaveScope(_node.pre);
+}
+
+void InspectedInterpreter::operator()(Block const& _node)
+{
+	helper(_node);
+	leaveScope(_node);
+}
+
+map<YulString, u256> InspectedInterpreter::variablesInScope() const
+{
+	map<YulString, u256> variables;
+	for (size_t slot = 0; slot < m_inScope.size(); ++slot)
+		if (m_inScope[slot])
+			variables[m_frame.variableNames[slot]] = m_variables[slot];
+	return variables;
+}
+
+void InspectedInterpreter::leaveScope(Block const& _block)
+{
+	auto [begin, end] = m_resolution.slots(_block);
+	fill(m_inScope.begin() + static_cast<ptrdiff_t>(begin), m_inScope.begin() + static_cast<ptrdiff_t>(end), false);
 }
 
 Inspector::NodeAction Inspector::queryUser(DebugData const& _data, map<YulString, u256> const& _variables)
@@ -143,14 +208,14 @@ std::string Inspector::currentSource(DebugData const& _data) const
 
 u256 InspectedInterpreter::evaluate(Expression const& _expression)
 {
-	InspectedExpressionEvaluator ev(m_inspector, m_state, m_dialect, *m_scope, m_variables, m_disableExternalCalls, m_disableMemoryTrace);
+	InspectedExpressionEvaluator ev(m_inspector, m_state, m_dialect, m_resolution, m_variables, variablesInScope(), m_disableExternalCalls, m_disableMemoryTrace);
 	ev.visit(_expression);
 	return ev.value();
 }
 
 std::vector<u256> InspectedInterpreter::evaluateMulti(Expression const& _expression)
 {
-	InspectedExpressionEvaluator ev(m_inspector, m_state, m_dialect, *m_scope, m_variables, m_disableExternalCalls, m_disableMemoryTrace);
+	InspectedExpressionEvaluator ev(m_inspector, m_state, m_dialect, m_resolution, m_variables, variablesInScope(), m_disableExternalCalls, m_disableMemoryTrace);
 	ev.visit(_expression);
 	return ev.values();
 }
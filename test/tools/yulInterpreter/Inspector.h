@@ -113,38 +113,42 @@ public:
 		std::shared_ptr<Inspector> _inspector,
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
+		Resolution const& _resolution,
+		Resolution::Frame const& _frame,
 		bool _disableExternalCalls,
 		bool _disableMemoryTracing,
-		std::map<YulString, u256> _variables = {}
-	):
-		Interpreter(_state, _dialect, _scope, _disableExternalCalls, _disableMemoryTracing, _variables),
-		m_inspector(_inspector)
-	{
-	}
+		std::vector<u256> _variables = {}
+	);
 
 	void operator()(ExpressionStatement const& _node) override { helper(_node); }
 	void operator()(Assignment const& _node) override { helper(_node); }
-	void operator()(VariableDeclaration const& _node) override { helper(_node); }
+	void operator()(VariableDeclaration const& _node) override;
 	void operator()(If const& _node) override { helper(_node); }
 	void operator()(Switch const& _node) override { helper(_node); }
-	void operator()(ForLoop const& _node) override { helper(_node); }
+	void operator()(ForLoop const& _node) override;
 	void operator()(Break const& _node) override { helper(_node); }
 	void operator()(Continue const& _node) override { helper(_node); }
 	void operator()(Leave const& _node) override { helper(_node); }
-	void operator()(Block const& _node) override { helper(_node); }
+	void operator()(Block const& _node) override;
 protected:
 	/// Asserts that the expression evaluates to exactly one value and returns it.
 	u256 evaluate(Expression const& _expression) override;
 	/// Evaluates the expression and returns its value.
 	std::vector<u256> evaluateMulti(Expression const& _expression) override;
 private:
+	/// @returns the names and values of the variables that are currently in scope.
+	std::map<YulString, u256> variablesInScope() const;
+	/// Marks the variables declared inside @a _block as out of scope.
+	void leaveScope(Block const& _block);
+
 	std::shared_ptr<Inspector> m_inspector;
+	/// Whether the variable in the respective slot is in scope.
+	std::vector<bool> m_inScope;
 
 	template <typename ConcreteNode>
 	void helper(ConcreteNode const& _node)
 	{
-		m_inspector->interactiveVisit(*_node.debugData, m_variables, [&]() {
+		m_inspector->interactiveVisit(*_node.debugData, variablesInScope(), [&]() {
 			Interpreter::operator()(_node);
 		});
 	}
@@ -159,19 +163,21 @@ public:
 		std::shared_ptr<Inspector> _inspector,
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables,
+		Resolution const& _resolution,
+		std::vector<u256> const& _variables,
+		std::map<YulString, u256> _variablesInScope,
 		bool _disableExternalCalls,
 		bool _disableMemoryTrace
 	):
-		ExpressionEvaluator(_state, _dialect, _scope, _variables, _disableExternalCalls, _disableMemoryTrace),
-		m_inspector(_inspector)
+		ExpressionEvaluator(_state, _dialect, _resolution, _variables, _disableExternalCalls, _disableMemoryTrace),
+		m_inspector(_inspector),
+		m_variablesInScope(std::move(_variablesInScope))
 	{}
 
 	template <typename ConcreteNode>
 	void helper(ConcreteNode const& _node)
 	{
-		m_inspector->interactiveVisit(*_node.debugData, m_variables, [&]() {
+		m_inspector->interactiveVisit(*_node.debugData, m_variablesInScope, [&]() {
 			ExpressionEvaluator::operator()(_node);
 		});
 	}
@@ -180,19 +186,20 @@ public:
 	void operator()(Identifier const& _node) override { helper(_node); }
 	void operator()(FunctionCall const& _node) override { helper(_node); }
 protected:
-	std::unique_ptr<Interpreter> makeInterpreterCopy(std::map<YulString, u256> _variables = {}) const override
+	std::unique_ptr<Interpreter> makeInterpreterCopy(Resolution::Frame const& _frame, std::vector<u256> _variables) const override
 	{
 		return std::make_unique<InspectedInterpreter>(
 			m_inspector,
 			m_state,
 			m_dialect,
-			m_scope,
+			m_resolution,
+			_frame,
 			m_disableExternalCalls,
 			m_disableMemoryTrace,
 			std::move(_variables)
 		);
 	}
-	std::unique_ptr<Interpreter> makeInterpreterNew(InterpreterState& _state, Scope& _scope) const override
+	std::unique_ptr<Interpreter> makeInterpreterNew(InterpreterState& _state) const override
 	{
 		return std::make_unique<InspectedInterpreter>(
 			std::make_unique<Inspector>(
@@ -201,13 +208,16 @@ protected:
 			),
 			_state,
 			m_dialect,
-			_scope,
+			m_resolution,
+			m_resolution.topLevelFrame(),
 			m_disableExternalCalls,
 			m_disableMemoryTrace
 		);
 	}
 private:
 	std::shared_ptr<Inspector> m_inspector;
+	/// Variables in scope of the evaluated expression, as shown to the user.
+	std::map<YulString, u256> m_variablesInScope;
 };
 
 }
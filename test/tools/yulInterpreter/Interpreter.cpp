@@ -44,11 +44,182 @@ using namespace hyperion::yul::test;
 
 using hyperion::util::h256;
 
+/**
+ * Walks the AST once and records the resolved names, keeping track of the variables
+ * and functions in scope.
+ */
+class Resolution::Resolver: public ASTWalker
+{
+public:
+	Resolver(Resolution& _resolution, Dialect const& _dialect):
+		m_resolution(_resolution),
+		m_dialect(_dialect),
+		m_frame(&_resolution.m_topLevelFrame)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(VariableDeclaration const& _declaration) override;
+	void operator()(FunctionDefinition const& _function) override;
+	void operator()(ForLoop const& _forLoop) override;
+	void operator()(Block const& _block) override;
+
+private:
+	struct Scope
+	{
+		map<YulString, size_t> variables;
+		map<YulString, FunctionDefinition const*> functions;
+	};
+
+	void enterScope(Block const& _block);
+	void leaveScope() { m_scopes.pop_back(); }
+	/// Assigns the next free slot of the current frame to a new variable.
+	size_t declare(YulString _name);
+	size_t lookupVariable(YulString _name) const;
+	Frame const* lookupFunction(YulString _name);
+
+	Resolution& m_resolution;
+	Dialect const& m_dialect;
+	Frame* m_frame;
+	vector<Scope> m_scopes;
+	/// Index of the outermost scope whose variables belong to the current frame.
+	size_t m_frameScopes = 0;
+};
+
+void Resolution::Resolver::operator()(Literal const& _literal)
+{
+	m_resolution.m_literalValues.emplace(&_literal, valueOfLiteral(_literal));
+}
+
+void Resolution::Resolver::operator()(Identifier const& _identifier)
+{
+	m_resolution.m_identifierSlots.emplace(&_identifier, lookupVariable(_identifier.name));
+}
+
+void Resolution::Resolver::operator()(FunctionCall const& _funCall)
+{
+	Call call;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
+		if (!builtin->literalArguments.empty())
+			call.literalArguments = &builtin->literalArguments;
+	if (QRVMDialect const* dialect = dynamic_cast<QRVMDialect const*>(&m_dialect))
+		call.builtin = dialect->builtin(_funCall.functionName.name);
+	if (!call.builtin)
+		call.function = lookupFunction(_funCall.functionName.name);
+	m_resolution.m_calls.emplace(&_funCall, call);
+
+	// Literal arguments are not evaluated and need not even be valid values.
+	for (size_t i = 0; i < _funCall.arguments.size(); ++i)
+		if (!call.literalArguments || !call.literalArguments->at(i))
+			visit(_funCall.arguments[i]);
+}
+
+void Resolution::Resolver::operator()(VariableDeclaration const& _declaration)
+{
+	if (_declaration.value)
+		visit(*_declaration.value);
+	m_resolution.m_declarationSlots.emplace(&_declaration, m_frame->variableNames.size());
+	for (auto const& variable: _declaration.variables)
+		declare(variable.name);
+}
+
+void Resolution::Resolver::operator()(FunctionDefinition const& _function)
+{
+	Frame* outerFrame = m_frame;
+	size_t outerFrameScopes = m_frameScopes;
+	m_frame = &m_resolution.m_functionFrames[&_function];
+	m_frame->function = &_function;
+	m_frameScopes = m_scopes.size();
+
+	m_scopes.emplace_back();
+	for (auto const& parameter: _function.parameters)
+		declare(parameter.name);
+	for (auto const& returnVariable: _function.returnVariables)
+		declare(returnVariable.name);
+	(*this)(_function.body);
+	leaveScope();
+
+	m_frame = outerFrame;
+	m_frameScopes = outerFrameScopes;
+}
+
+void Resolution::Resolver::operator()(ForLoop const& _forLoop)
+{
+	// The variables of the pre block stay in scope until the end of the loop.
+	enterScope(_forLoop.pre);
+	size_t begin = m_frame->variableNames.size();
+	walkVector(_forLoop.pre.statements);
+	m_resolution.m_blockSlots.emplace(&_forLoop.pre, make_pair(begin, m_frame->variableNames.size()));
+	visit(*_forLoop.condition);
+	(*this)(_forLoop.body);
+	(*this)(_forLoop.post);
+	leaveScope();
+}
+
+void Resolution::Resolver::operator()(Block const& _block)
+{
+	enterScope(_block);
+	size_t begin = m_frame->variableNames.size();
+	walkVector(_block.statements);
+	m_resolution.m_blockSlots.emplace(&_block, make_pair(begin, m_frame->variableNames.size()));
+	leaveScope();
+}
+
+void Resolution::Resolver::enterScope(Block const& _block)
+{
+	m_scopes.emplace_back();
+	// Functions are visible in the whole block.
+	for (auto const& statement: _block.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			m_scopes.back().functions.emplace(function->name, function);
+}
+
+size_t Resolution::Resolver::declare(YulString _name)
+{
+	size_t slot = m_frame->variableNames.size();
+	m_frame->variableNames.emplace_back(_name);
+	m_scopes.back().variables[_name] = slot;
+	return slot;
+}
+
+size_t Resolution::Resolver::lookupVariable(YulString _name) const
+{
+	for (size_t i = m_scopes.size(); i > m_frameScopes; --i)
+		if (size_t const* slot = util::valueOrNullptr(m_scopes[i - 1].variables, _name))
+			return *slot;
+	yulAssert(false, "Variable not found.");
+	return 0;
+}
+
+Resolution::Frame const* Resolution::Resolver::lookupFunction(YulString _name)
+{
+	for (auto const& scope: m_scopes | ranges::views::reverse)
+		if (FunctionDefinition const* const* function = util::valueOrNullptr(scope.functions, _name))
+		{
+			Frame& frame = m_resolution.m_functionFrames[*function];
+			frame.function = *function;
+			return &frame;
+		}
+	return nullptr;
+}
+
+Resolution::Resolution(Dialect const& _dialect, Block const& _ast):
+	m_ast(_ast)
+{
+	Resolver{*this, _dialect}(_ast);
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
-	for (auto const& slot: storage)
-		if (slot.second != h256{})
-			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+	// Storage is not ordered, but the dump has to be.
+	map<h256, h256> nonZeroSlots;
+	for (auto const& [slot, value]: storage)
+		if (value != h256{})
+			nonZeroSlots.emplace(slot, value);
+	for (auto const& [slot, value]: nonZeroSlots)
+		_out << "  " << slot.hex() << ": " << value.hex() << endl;
 }
 
 void InterpreterState::dumpTraceAndState(ostream& _out, bool _disableMemoryTrace) const
@@ -60,8 +231,9 @@ void InterpreterState::dumpTraceAndState(ostream& _out, bool _disableMemoryTrace
 	{
 		_out << "Memory dump:\n";
 		map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
+		memory.forEachNonZeroByte([&](u256 const& _offset, uint8_t _value) {
+			words[(_offset / 0x20) * 0x20] |= u256(uint32_t(_value)) << (256 - 8 - 8 * static_cast<size_t>(_offset % 0x20));
+		});
 		for (auto const& [offset, value]: words)
 			if (value != 0)
 				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
@@ -106,8 +278,15 @@ void Interpreter::run(
 	bool _disableMemoryTrace
 )
 {
-	Scope scope;
-	Interpreter{_state, _dialect, scope, _disableExternalCalls, _disableMemoryTrace}(_ast);
+	Resolution resolution(_dialect, _ast);
+	Interpreter{
+		_state,
+		_dialect,
+		resolution,
+		resolution.topLevelFrame(),
+		_disableExternalCalls,
+		_disableMemoryTrace
+	}(_ast);
 }
 
 void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
@@ -121,11 +300,7 @@ void Interpreter::operator()(Assignment const& _assignment)
 	vector<u256> values = evaluateMulti(*_assignment.value);
 	hypAssert(values.size() == _assignment.variableNames.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		hypAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-	}
+		m_variables[m_resolution.slot(_assignment.variableNames.at(i))] = values.at(i);
 }
 
 void Interpreter::operator()(VariableDeclaration const& _declaration)
@@ -135,13 +310,9 @@ void Interpreter::operator()(VariableDeclaration const& _declaration)
 		values = evaluateMulti(*_declaration.value);
 
 	hypAssert(values.size() == _declaration.variables.size(), "");
+	size_t slot = m_resolution.slot(_declaration);
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _declaration.variables.at(i).name;
-		hypAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-		m_scope->names.emplace(varName, nullptr);
-	}
+		m_variables[slot + i] = values.at(i);
 }
 
 void Interpreter::operator()(If const& _if)
@@ -158,7 +329,7 @@ void Interpreter::operator()(Switch const& _switch)
 	hypAssert(!_switch.cases.empty(), "");
 	for (auto const& c: _switch.cases)
 		// Default case has to be last.
-		if (!c.value || evaluate(*c.value) == val)
+		if (!c.value || m_resolution.value(*c.value) == val)
 		{
 			(*this)(c.body);
 			break;
@@ -173,9 +344,6 @@ void Interpreter::operator()(ForLoop const& _forLoop)
 {
 	hypAssert(_forLoop.condition, "");
 
-	enterScope(_forLoop.pre);
-	ScopeGuard g([this]{ leaveScope(); });
-
 	for (auto const& statement: _forLoop.pre.statements)
 	{
 		visit(statement);
@@ -220,15 +388,6 @@ void Interpreter::operator()(Leave const&)
 
 void Interpreter::operator()(Block const& _block)
 {
-	enterScope(_block);
-	// Register functions.
-	for (auto const& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
-		{
-			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
-			m_scope->names.emplace(funDef.name, &funDef);
-		}
-
 	for (auto const& statement: _block.statements)
 	{
 		incrementStep();
@@ -236,44 +395,22 @@ void Interpreter::operator()(Block const& _block)
 		if (m_state.controlFlowState != ControlFlowState::Default)
 			break;
 	}
-
-	leaveScope();
 }
 
 u256 Interpreter::evaluate(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables, m_disableExternalCalls, m_disableMemoryTrace);
+	ExpressionEvaluator ev(m_state, m_dialect, m_resolution, m_variables, m_disableExternalCalls, m_disableMemoryTrace);
 	ev.visit(_expression);
 	return ev.value();
 }
 
 vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables, m_disableExternalCalls, m_disableMemoryTrace);
+	ExpressionEvaluator ev(m_state, m_dialect, m_resolution, m_variables, m_disableExternalCalls, m_disableMemoryTrace);
 	ev.visit(_expression);
 	return ev.values();
 }
 
-void Interpreter::enterScope(Block const& _block)
-{
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = make_unique<Scope>(Scope{
-			{},
-			{},
-			m_scope
-		});
-	m_scope = m_scope->subScopes[&_block].get();
-}
-
-void Interpreter::leaveScope()
-{
-	for (auto const& [var, funDeclaration]: m_scope->names)
-		if (!funDeclaration)
-			m_variables.erase(var);
-	m_scope = m_scope->parent;
-	yulAssert(m_scope, "");
-}
-
 void Interpreter::incrementStep()
 {
 	m_state.numSteps++;
@@ -287,70 +424,53 @@ void Interpreter::incrementStep()
 void ExpressionEvaluator::operator()(Literal const& _literal)
 {
 	incrementStep();
-	static YulString const trueString("true");
-	static YulString const falseString("false");
-
-	setValue(valueOfLiteral(_literal));
+	setValue(m_resolution.value(_literal));
 }
 
 void ExpressionEvaluator::operator()(Identifier const& _identifier)
 {
-	hypAssert(m_variables.count(_identifier.name), "");
 	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	setValue(m_variables[m_resolution.slot(_identifier)]);
 }
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
-	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
-	evaluateArgs(_funCall.arguments, literalArguments);
+	Resolution::Call const& call = m_resolution.call(_funCall);
+	evaluateArgs(_funCall.arguments, call.literalArguments);
 
-	if (QRVMDialect const* dialect = dynamic_cast<QRVMDialect const*>(&m_dialect))
+	if (call.builtin)
 	{
-		if (BuiltinFunctionForQRVM const* fun = dialect->builtin(_funCall.functionName.name))
-		{
-			QRVMInstructionInterpreter interpreter(dialect->qrvmVersion(), m_state, m_disableMemoryTrace);
+		QRVMDialect const& dialect = dynamic_cast<QRVMDialect const&>(m_dialect);
+		QRVMInstructionInterpreter interpreter(dialect.qrvmVersion(), m_state, m_disableMemoryTrace);
 
-			u256 const value = interpreter.evalBuiltin(*fun, _funCall.arguments, values());
+		u256 const value = interpreter.evalBuiltin(*call.builtin, _funCall.arguments, values());
 
-			if (
-				!m_disableExternalCalls &&
-				fun->instruction &&
-				qrvmasm::isCallInstruction(*fun->instruction)
-			)
-				runExternalCall(*fun->instruction);
+		if (
+			!m_disableExternalCalls &&
+			call.builtin->instruction &&
+			qrvmasm::isCallInstruction(*call.builtin->instruction)
+		)
+			runExternalCall(*call.builtin->instruction);
 
-			setValue(value);
-			return;
-		}
+		setValue(value);
+		return;
 	}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
-			break;
-	yulAssert(scope, "");
-
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
-	yulAssert(fun, "Function not found.");
-	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
-	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
-	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
+	yulAssert(call.function, "Function not found.");
+	FunctionDefinition const& fun = *call.function->function;
+	yulAssert(m_values.size() == fun.parameters.size(), "");
+	// Parameters come first, return variables and local variables start out as zero.
+	vector<u256> variables(call.function->variableNames.size(), 0);
+	copy(m_values.begin(), m_values.end(), variables.begin());
 
 	m_state.controlFlowState = ControlFlowState::Default;
-	unique_ptr<Interpreter> interpreter = makeInterpreterCopy(std::move(variables));
-	(*interpreter)(fun->body);
+	unique_ptr<Interpreter> interpreter = makeInterpreterCopy(*call.function, std::move(variables));
+	(*interpreter)(fun.body);
 	m_state.controlFlowState = ControlFlowState::Default;
 
 	m_values.clear();
-	for (auto const& retVar: fun->returnVariables)
-		m_values.emplace_back(interpreter->valueOfVariable(retVar.name));
+	for (size_t i = 0; i < fun.returnVariables.size(); ++i)
+		m_values.emplace_back(interpreter->valueOfSlot(fun.parameters.size() + i));
 }
 
 u256 ExpressionEvaluator::value() const
@@ -371,16 +491,16 @@ void ExpressionEvaluator::evaluateArgs(
 )
 {
 	incrementStep();
-	vector<u256> values;
-	size_t i = 0;
+	vector<u256> values(_expr.size());
 	/// Function arguments are evaluated in reverse.
-	for (auto const& expr: _expr | ranges::views::reverse)
+	for (size_t i = _expr.size(); i > 0; --i)
 	{
-		if (!_literalArguments || !_literalArguments->at(_expr.size() - i - 1))
+		Expression const& expr = _expr[i - 1];
+		if (!_literalArguments || !_literalArguments->at(i - 1))
 			visit(expr);
 		else
 		{
-			string literal = std::get<Literal>(expr).value.str();
+			string literal(std::get<Literal>(expr).value.str());
 
 			try
 			{
@@ -392,11 +512,9 @@ void ExpressionEvaluator::evaluateArgs(
 			}
 		}
 
-		values.push_back(value());
-		++i;
+		values[i - 1] = value();
 	}
 	m_values = std::move(values);
-	std::reverse(m_values.begin(), m_values.end());
 }
 
 void ExpressionEvaluator::incrementStep()
@@ -445,7 +563,6 @@ void ExpressionEvaluator::runExternalCall(qrvmasm::Instruction _instruction)
 	if (values()[1] != util::h160::Arith(m_state.address))
 		return;
 
-	Scope tmpScope;
 	InterpreterState tmpState;
 	tmpState.calldata = m_state.readMemory(memInOffset, memInSize);
 	tmpState.callvalue = callvalue;
@@ -454,32 +571,11 @@ void ExpressionEvaluator::runExternalCall(qrvmasm::Instruction _instruction)
 	yulAssert(tmpState.numInstance < 1024, "Detected more than 1024 recursive calls, aborting...");
 
 	// Create new interpreter for the called contract
-	unique_ptr<Interpreter> newInterpreter = makeInterpreterNew(tmpState, tmpScope);
-
-	Scope* abstractRootScope = &m_scope;
-	Scope* fileScope = nullptr;
-	Block const* ast = nullptr;
-
-	// Find file scope
-	while (abstractRootScope->parent)
-	{
-		fileScope = abstractRootScope;
-		abstractRootScope = abstractRootScope->parent;
-	}
-
-	// Get AST for file scope
-	for (auto&& [block, scope]: abstractRootScope->subScopes)
-		if (scope.get() == fileScope)
-		{
-			ast = block;
-			break;
-		}
-
-	yulAssert(ast);
+	unique_ptr<Interpreter> newInterpreter = makeInterpreterNew(tmpState);
 
 	try
 	{
-		(*newInterpreter)(*ast);
+		(*newInterpreter)(m_resolution.ast());
 	}
 	catch (ExplicitlyTerminatedWithReturn const&)
 	{
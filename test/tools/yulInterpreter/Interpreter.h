@@ -21,7 +21,10 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/Memory.h>
+
 #include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
 #include <libyul/optimiser/ASTWalker.h>
 
 #include <libqrvmasm/Instruction.h>
@@ -32,10 +35,13 @@
 #include <libhyputil/Exceptions.h>
 
 #include <map>
+#include <optional>
+#include <unordered_map>
 
 namespace hyperion::yul
 {
 struct Dialect;
+struct BuiltinFunctionForQRVM;
 }
 
 namespace hyperion::yul::test
@@ -77,10 +83,10 @@ struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	Memory memory;
+	/// This is different than the size of the written memory because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
+	Storage storage;
 	util::h160 address = util::h160("0x0000000000000000000000000000000011111111");
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
@@ -121,22 +127,62 @@ struct InterpreterState
 	bytes readMemory(u256 const& _offset, u256 const& _size)
 	{
 		yulAssert(_size <= 0xffff, "Too large read.");
-		bytes data(size_t(_size), uint8_t(0));
-		for (size_t i = 0; i < data.size(); ++i)
-			data[i] = memory[_offset + i];
-		return data;
+		return memory.read(_offset, size_t(_size));
 	}
 };
 
 /**
- * Scope structure built and maintained during execution.
+ * Names of a Yul AST resolved ahead of execution.
+ *
+ * Variables are mapped to slots in the frame of the enclosing function (or of the code
+ * outside of all functions), function calls to the called builtin or function and
+ * literals to their values, so that none of them has to be looked up by name while
+ * the code runs.
  */
-struct Scope
+class Resolution
 {
-	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
-	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
-	Scope* parent = nullptr;
+public:
+	/// Layout of the variables of a function or of the code outside of all functions.
+	/// The parameters of a function occupy the first slots, followed by its return variables.
+	struct Frame
+	{
+		FunctionDefinition const* function = nullptr;
+		/// Names of the variables by slot.
+		std::vector<YulString> variableNames;
+	};
+	struct Call
+	{
+		BuiltinFunctionForQRVM const* builtin = nullptr;
+		std::vector<std::optional<LiteralKind>> const* literalArguments = nullptr;
+		/// The called function if the call is not a builtin.
+		Frame const* function = nullptr;
+	};
+
+	Resolution(Dialect const& _dialect, Block const& _ast);
+
+	Block const& ast() const { return m_ast; }
+	Frame const& topLevelFrame() const { return m_topLevelFrame; }
+
+	size_t slot(Identifier const& _identifier) const { return m_identifierSlots.at(&_identifier); }
+	/// @returns the slot of the first variable of the declaration, the others follow it.
+	size_t slot(VariableDeclaration const& _declaration) const { return m_declarationSlots.at(&_declaration); }
+	/// @returns the range of slots of the variables declared inside the block, including nested blocks.
+	std::pair<size_t, size_t> slots(Block const& _block) const { return m_blockSlots.at(&_block); }
+	Call const& call(FunctionCall const& _call) const { return m_calls.at(&_call); }
+	u256 const& value(Literal const& _literal) const { return m_literalValues.at(&_literal); }
+
+private:
+	class Resolver;
+
+	Block const& m_ast;
+	Frame m_topLevelFrame;
+	/// Node based, since calls refer to the frames.
+	std::map<FunctionDefinition const*, Frame> m_functionFrames;
+	std::unordered_map<Identifier const*, size_t> m_identifierSlots;
+	std::unordered_map<VariableDeclaration const*, size_t> m_declarationSlots;
+	std::unordered_map<Block const*, std::pair<size_t, size_t>> m_blockSlots;
+	std::unordered_map<FunctionCall const*, Call> m_calls;
+	std::unordered_map<Literal const*, u256> m_literalValues;
 };
 
 /**
@@ -157,21 +203,28 @@ public:
 		bool _disableMemoryTracing
 	);
 
+	/// Creates an interpreter for the code of @a _frame. If @a _variables is empty,
+	/// all variables of the frame start out as zero.
 	Interpreter(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
+		Resolution const& _resolution,
+		Resolution::Frame const& _frame,
 		bool _disableExternalCalls,
 		bool _disableMemoryTracing,
-		std::map<YulString, u256> _variables = {}
+		std::vector<u256> _variables = {}
 	):
 		m_dialect(_dialect),
 		m_state(_state),
+		m_resolution(_resolution),
+		m_frame(_frame),
 		m_variables(std::move(_variables)),
-		m_scope(&_scope),
 		m_disableExternalCalls(_disableExternalCalls),
 		m_disableMemoryTrace(_disableMemoryTracing)
 	{
+		if (m_variables.empty())
+			m_variables.resize(m_frame.variableNames.size());
+		yulAssert(m_variables.size() == m_frame.variableNames.size(), "");
 	}
 
 	void operator()(ExpressionStatement const& _statement) override;
@@ -189,7 +242,7 @@ public:
 	bytes returnData() const { return m_state.returndata; }
 	std::vector<std::string> const& trace() const { return m_state.trace; }
 
-	u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
+	u256 const& valueOfSlot(size_t _slot) const { return m_variables.at(_slot); }
 
 protected:
 	/// Asserts that the expression evaluates to exactly one value and returns it.
@@ -197,18 +250,16 @@ protected:
 	/// Evaluates the expression and returns its value.
 	virtual std::vector<u256> evaluateMulti(Expression const& _expression);
 
-	void enterScope(Block const& _block);
-	void leaveScope();
-
 	/// Increment interpreter step count, throwing exception if step limit
 	/// is reached.
 	void incrementStep();
 
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
-	/// Values of variables.
-	std::map<YulString, u256> m_variables;
-	Scope* m_scope;
+	Resolution const& m_resolution;
+	Resolution::Frame const& m_frame;
+	/// Values of the variables of the frame by slot.
+	std::vector<u256> m_variables;
 	/// If not set, external calls (e.g. using `call()`) to the same contract
 	/// are evaluated in a new parser instance.
 	bool m_disableExternalCalls;
@@ -224,15 +275,15 @@ public:
 	ExpressionEvaluator(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables,
+		Resolution const& _resolution,
+		std::vector<u256> const& _variables,
 		bool _disableExternalCalls,
 		bool _disableMemoryTrace
 	):
 		m_state(_state),
 		m_dialect(_dialect),
+		m_resolution(_resolution),
 		m_variables(_variables),
-		m_scope(_scope),
 		m_disableExternalCalls(_disableExternalCalls),
 		m_disableMemoryTrace(_disableMemoryTrace)
 	{}
@@ -244,27 +295,29 @@ public:
 	/// Asserts that the expression has exactly one value and returns it.
 	u256 value() const;
 	/// Returns the list of values of the expression.
-	std::vector<u256> values() const { return m_values; }
+	std::vector<u256> const& values() const { return m_values; }
 
 protected:
 	void runExternalCall(qrvmasm::Instruction _instruction);
-	virtual std::unique_ptr<Interpreter> makeInterpreterCopy(std::map<YulString, u256> _variables = {}) const
+	virtual std::unique_ptr<Interpreter> makeInterpreterCopy(Resolution::Frame const& _frame, std::vector<u256> _variables) const
 	{
 		return std::make_unique<Interpreter>(
 			m_state,
 			m_dialect,
-			m_scope,
+			m_resolution,
+			_frame,
 			m_disableExternalCalls,
 			m_disableMemoryTrace,
 			std::move(_variables)
 		);
 	}
-	virtual std::unique_ptr<Interpreter> makeInterpreterNew(InterpreterState& _state, Scope& _scope) const
+	virtual std::unique_ptr<Interpreter> makeInterpreterNew(InterpreterState& _state) const
 	{
 		return std::make_unique<Interpreter>(
 			_state,
 			m_dialect,
-			_scope,
+			m_resolution,
+			m_resolution.topLevelFrame(),
 			m_disableExternalCalls,
 			m_disableMemoryTrace
 		);
@@ -286,9 +339,9 @@ protected:
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
-	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
-	Scope& m_scope;
+	Resolution const& m_resolution;
+	/// Values of the variables of the current frame by slot.
+	std::vector<u256> const& m_variables;
 	/// Current value of the expression
 	std::vector<u256> m_values;
 	/// Current expression nesting level
@@ -0,0 +1,80 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory and storage of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/Memory.h>
+
+#include <algorithm>
+
+using namespace hyperion;
+using namespace hyperion::yul::test;
+
+uint8_t Memory::read(u256 const& _address) const
+{
+	Page const* page = findPage(pageIndex(_address));
+	return page ? (*page)[pageOffset(_address)] : 0;
+}
+
+void Memory::write(u256 const& _address, uint8_t _value)
+{
+	page(pageIndex(_address))[pageOffset(_address)] = _value;
+}
+
+bytes Memory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, uint8_t(0));
+	u256 address = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t offset = pageOffset(address);
+		size_t chunkSize = std::min(pageSize - offset, _size - position);
+		if (Page const* page = findPage(pageIndex(address)))
+			std::copy_n(page->data() + offset, chunkSize, data.data() + position);
+		position += chunkSize;
+		// Wraps around at the end of the address space.
+		address += chunkSize;
+	}
+	return data;
+}
+
+void Memory::write(u256 const& _offset, uint8_t const* _data, size_t _size)
+{
+	u256 address = _offset;
+	for (size_t position = 0; position < _size;)
+	{
+		size_t offset = pageOffset(address);
+		size_t chunkSize = std::min(pageSize - offset, _size - position);
+		std::copy_n(_data + position, chunkSize, page(pageIndex(address)).data() + offset);
+		position += chunkSize;
+		// Wraps around at the end of the address space.
+		address += chunkSize;
+	}
+}
+
+Memory::Page const* Memory::findPage(u256 const& _pageIndex) const
+{
+	return util::valueOrNullptr(m_pages, _pageIndex);
+}
+
+Memory::Page& Memory::page(u256 const& _pageIndex)
+{
+	// New pages are value-initialised, i.e. zero.
+	return m_pages.try_emplace(_pageIndex).first->second;
+}
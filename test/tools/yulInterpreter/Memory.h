@@ -0,0 +1,93 @@
+/*
+	This file is part of hyperion.
+
+	hyperion is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	hyperion is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with hyperion.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory and storage of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libhyputil/CommonData.h>
+#include <libhyputil/FixedHash.h>
+#include <libhyputil/Numeric.h>
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace hyperion::yul::test
+{
+
+/**
+ * Sparse byte-addressed memory, allocated in pages when first written to.
+ *
+ * Bytes that were never written read as zero and addresses wrap around modulo 2**256.
+ * Pages are ordered by address so that the contents can be listed in order.
+ */
+class Memory
+{
+public:
+	static size_t constexpr pageSize = 0x1000;
+
+	uint8_t read(u256 const& _address) const;
+	void write(u256 const& _address, uint8_t _value);
+
+	/// @returns the @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _size bytes of @a _data starting at @a _offset.
+	void write(u256 const& _offset, uint8_t const* _data, size_t _size);
+
+	/// Calls @a _visitor with the address and value of each non-zero byte in ascending order of addresses.
+	template <class Visitor>
+	void forEachNonZeroByte(Visitor&& _visitor) const
+	{
+		for (auto const& [pageIndex, page]: m_pages)
+			for (size_t i = 0; i < pageSize; ++i)
+				if (page[i] != 0)
+					_visitor(pageIndex * pageSize + i, page[i]);
+	}
+
+private:
+	using Page = std::array<uint8_t, pageSize>;
+
+	static u256 pageIndex(u256 const& _address) { return _address / pageSize; }
+	static size_t pageOffset(u256 const& _address) { return static_cast<size_t>(_address % pageSize); }
+
+	/// @returns the page with the given index or nullptr if it was never written to.
+	Page const* findPage(u256 const& _pageIndex) const;
+	/// @returns the page with the given index, allocating it if needed.
+	Page& page(u256 const& _pageIndex);
+
+	std::map<u256, Page> m_pages;
+};
+
+/// Hashes storage slots by their least significant bytes, which are usually the ones that differ.
+struct StorageSlotHash
+{
+	size_t operator()(util::h256 const& _slot) const
+	{
+		size_t hash;
+		std::memcpy(&hash, _slot.data() + util::h256::size - sizeof(hash), sizeof(hash));
+		return hash;
+	}
+};
+
+/// Storage slots and their values. Slots that are read but never written are not stored.
+using Storage = std::unordered_map<util::h256, util::h256, StorageSlotHash>;
+
+}
@@ -78,12 +78,22 @@ namespace hyperion::yul::test
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	Memory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
+	bytes data(_size, uint8_t(0));
 	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+		data[i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	// Target addresses are computed in size_t and thus wrap around at its maximum.
+	size_t const sizeUntilWrap = numeric_limits<size_t>::max() - _targetOffset;
+	if (_size > sizeUntilWrap)
+	{
+		_target.write(_targetOffset, data.data(), sizeUntilWrap + 1);
+		_target.write(0, data.data() + sizeUntilWrap + 1, _size - sizeUntilWrap - 1);
+	}
+	else
+		_target.write(_targetOffset, data.data(), _size);
 }
 
 }
@@ -282,10 +292,12 @@ u256 QRVMInstructionInterpreter::eval(
 		return 0;
 	case Instruction::MSTORE8:
 		accessMemory(arg[0], 1);
-		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
+		m_state.memory.write(arg[0], uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
-		return m_state.storage[h256(arg[0])];
+		if (h256 const* value = util::valueOrNullptr(m_state.storage, h256(arg[0])))
+			return u256(*value);
+		return 0;
 	case Instruction::SSTORE:
 		m_state.storage[h256(arg[0])] = h256(arg[1]);
 		return 0;
@@ -458,11 +470,11 @@ u256 QRVMInstructionInterpreter::evalBuiltin(
 	if (_fun.instruction)
 		return eval(*_fun.instruction, _evaluatedArguments);
 
-	string fun = _fun.name.str();
+	string fun(_fun.name.str());
 	// Evaluate datasize/offset/copy instructions
 	if (fun == "datasize" || fun == "dataoffset")
 	{
-		string arg = std::get<Literal>(_arguments.at(0)).value.str();
+		string arg(std::get<Literal>(_arguments.at(0)).value.str());
 		if (arg.length() < 32)
 			arg.resize(32, 0);
 		if (fun == "datasize")
@@ -520,10 +532,7 @@ bool QRVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _
 bytes QRVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= s_maxRangeSize, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 QRVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -533,8 +542,8 @@ u256 QRVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void QRVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 const word(_value);
+	m_state.memory.write(_offset, word.data(), h256::size);
 }
 
 